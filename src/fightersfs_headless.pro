@@ -0,0 +1,104 @@
+CONFIG -= qt
+
+TEMPLATE = app
+
+################################################################################
+
+DESTDIR = ../bin
+TARGET = fightersfs_headless
+
+################################################################################
+
+CONFIG += c++11 console
+
+################################################################################
+
+win32: CONFIG(release, debug|release): QMAKE_CXXFLAGS += -O2
+unix:  CONFIG(release, debug|release): QMAKE_CXXFLAGS += -O3
+
+win32: QMAKE_LFLAGS += /INCREMENTAL:NO
+
+################################################################################
+
+DEFINES += SIM_DESKTOP
+DEFINES += SIM_HEADLESS
+
+win32: DEFINES += \
+    WIN32 \
+    _CONSOLE \
+    _CRT_SECURE_NO_DEPRECATE \
+    _SCL_SECURE_NO_WARNINGS \
+    _USE_MATH_DEFINES
+
+win32: CONFIG(release, debug|release): DEFINES += NDEBUG
+win32: CONFIG(debug, debug|release):   DEFINES += _DEBUG
+
+unix: DEFINES += _LINUX_
+
+################################################################################
+
+INCLUDEPATH += ./
+
+win32: INCLUDEPATH += \
+    $(OSG_ROOT)/include/ \
+    $(OSG_ROOT)/include/libxml2
+
+unix: INCLUDEPATH += \
+    /usr/include/libxml2
+
+################################################################################
+
+win32: LIBS += \
+    -L$(OSG_ROOT)/lib \
+    -llibxml2 \
+    -lopengl32
+
+win32:CONFIG(release, debug|release): LIBS += \
+    -lOpenThreads \
+    -losg \
+    -losgDB \
+    -losgGA \
+    -losgParticle \
+    -losgSim \
+    -losgText \
+    -losgUtil \
+    -losgViewer \
+    -losgWidget
+
+win32:CONFIG(debug, debug|release): LIBS += \
+    -lOpenThreadsd \
+    -losgd \
+    -losgDBd \
+    -losgGAd \
+    -losgParticled \
+    -losgSimd \
+    -losgTextd \
+    -losgUtild \
+    -losgViewerd \
+    -losgWidgetd
+
+unix: LIBS += \
+    -L/lib \
+    -L/usr/lib \
+    -lxml2 \
+    -lpthread \
+    -lOpenThreads \
+    -losg \
+    -losgDB \
+    -losgGA \
+    -losgParticle \
+    -losgSim \
+    -losgText \
+    -losgUtil \
+    -losgViewer \
+    -losgWidget
+
+################################################################################
+
+HEADERS += \
+    defs.h
+
+SOURCES += \
+    main_headless.cpp
+
+include(sim/sim.pri)
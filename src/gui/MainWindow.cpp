@@ -30,6 +30,9 @@
 #include <hid/hid_Manager.h>
 #include <sim/sim_Manager.h>
 
+#include <sim/cgi/sim_Impostors.h>
+#include <sim/cgi/sim_Scenery.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 MainWindow::MainWindow( QWidget *parent ) :
@@ -163,19 +166,19 @@ void MainWindow::timerEvent( QTimerEvent *event )
         _ui->widgetData->step();
     }
 
-    if ( _pending && !sim::Data::get()->ownship.destroyed )
+    if ( _pending && !sim::Data::view()->ownship.destroyed )
     {
-        _heading = sim::Data::get()->ownship.heading;
+        _heading = sim::Data::view()->ownship.heading;
     }
     else
     {
-        if ( sim::Success == sim::Data::get()->mission.status
-          || sim::Data::get()->ownship.destroyed )
+        if ( sim::Success == sim::Data::view()->mission.status
+          || sim::Data::view()->ownship.destroyed )
         {
             if ( !_autopilot ) toggleAutopilot();
 
             if ( sim::Manager::instance()->isReady()
-              && sim::Data::get()->camera.type != sim::ViewOrbit )
+              && sim::Data::view()->camera.type != sim::ViewOrbit )
             {
                 sim::Manager::instance()->setViewOrbit();
 
@@ -205,11 +208,13 @@ void MainWindow::timerEvent( QTimerEvent *event )
     }
 
     hid::Manager::instance()->update( _timeCoef * timeStep );
+
+    sim::Manager::instance()->setTimeCoef( _timeCoef );
     sim::Manager::instance()->update( _timeCoef * timeStep );
 
     if ( !_throttle && sim::Manager::instance()->isReady() )
     {
-        hid::Manager::instance()->setThrottle( sim::Data::get()->ownship.init_throttle );
+        hid::Manager::instance()->setThrottle( sim::Data::view()->ownship.init_throttle );
 
         _throttle = true;
     }
@@ -252,6 +257,24 @@ void MainWindow::settingsRead()
     restoreGeometry( settings.value( "geometry" ).toByteArray() );
 
     settings.endGroup();
+
+    settings.beginGroup( "simulation" );
+
+    int shadowType = settings.value( "shadows", (int)sim::Scenery::_shadowType ).toInt();
+
+    if ( shadowType >= sim::ShadowOff && shadowType <= sim::ShadowOverlay )
+    {
+        sim::Scenery::_shadowType = (sim::ShadowType)shadowType;
+    }
+
+    int impostors = settings.value( "impostors", sim::Impostors::_pixelSize ).toInt();
+
+    if ( impostors >= 0 )
+    {
+        sim::Impostors::_pixelSize = impostors;
+    }
+
+    settings.endGroup();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -266,6 +289,13 @@ void MainWindow::settingsSave()
     settings.setValue( "geometry", saveGeometry() );
 
     settings.endGroup();
+
+    settings.beginGroup( "simulation" );
+
+    settings.setValue( "shadows", (int)sim::Scenery::_shadowType );
+    settings.setValue( "impostors", sim::Impostors::_pixelSize );
+
+    settings.endGroup();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -286,6 +316,7 @@ void MainWindow::simulationStart( int missionIndex )
         int w = _ui->widgetPlay->width();
         int h = _ui->widgetPlay->height();
 
+        sim::Manager::instance()->setThreaded( true );
         sim::Manager::instance()->init( w, h, missionIndex );
 
         _ui->widgetPlay->init();
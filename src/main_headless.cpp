@@ -0,0 +1,352 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <chrono>
+#include <errno.h>
+#include <iostream>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include <osg/Notify>
+
+#include <defs.h>
+
+#include <sim/sim_Elevation.h>
+#include <sim/sim_Manager.h>
+
+#include <sim/cgi/sim_Textures.h>
+
+#include <sim/entities/sim_Flak.h>
+#include <sim/entities/sim_Pool.h>
+
+#include <sim/utils/sim_Profiler.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const int width  = 1280;   ///< viewport width, only affects HUD lines width
+const int height = 720;    ///< viewport height, only affects HUD lines width
+
+const double timeInitMax = 600.0;   ///< [s] maximum mission loading wall time
+
+/** Prints usage. */
+void printUsage( const char *name )
+{
+    std::cout << "Usage: " << name << " MISSION_INDEX [TIME_STEP] [MAX_TIME]" << std::endl;
+    std::cout << "  MISSION_INDEX  index of the mission in missions/campaign.xml" << std::endl;
+    std::cout << "  TIME_STEP      [s] fixed simulation time step (default " << SIM_TIME_STEP << ")" << std::endl;
+    std::cout << "  MAX_TIME       [s] maximum simulation time (default 3600)" << std::endl;
+    std::cout << "Usage: " << name << " --convert-elevation CSV_FILE [BIN_FILE]" << std::endl;
+    std::cout << "  converts CSV elevation file into binary one" << std::endl;
+    std::cout << "Usage: " << name << " --benchmark-elevation ELEVATION_FILE [COUNT]" << std::endl;
+    std::cout << "  measures scalar and batched terrain elevation sampling speed" << std::endl;
+    std::cout << "Usage: " << name << " --compile-textures TEXTURE_FILE..." << std::endl;
+    std::cout << "  compiles textures into the textures cache directory" << std::endl;
+}
+
+/** Parses non-negative integer, returns false if text is not a number. */
+bool parseIndex( const char *text, UInt32 *index )
+{
+    char *end = 0;
+
+    errno = 0;
+    long value = strtol( text, &end, 10 );
+
+    if ( end == text || *end != '\0' || errno == ERANGE || value < 0 || value > UINT32_MAX )
+    {
+        return false;
+    }
+
+    *index = (UInt32)value;
+
+    return true;
+}
+
+/** Returns status name. */
+const char* getStatusName( Status status )
+{
+    switch ( status )
+    {
+        case Failure: return "failure";
+        case Success: return "success";
+        default:      return "pending";
+    }
+}
+
+/** Runs terrain elevation sampling microbenchmark. */
+int benchmarkElevation( const std::string &fileName, UInt32 count )
+{
+    Elevation *elevation = Elevation::instance();
+
+    elevation->readFile( fileName );
+
+    if ( elevation->getSide() <= 0.0f || count == 0 )
+    {
+        std::cerr << "Cannot read elevation file: " << fileName << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // points are spread over the whole terrain (and slightly beyond it)
+    std::vector< double > x( count );
+    std::vector< double > y( count );
+    std::vector< float >  z_scalar( count );
+    std::vector< float >  z_batch( count );
+
+    const double range = 0.55 * elevation->getSide();
+
+    srand( 0 );
+
+    for ( UInt32 i = 0; i < count; i++ )
+    {
+        x[ i ] = range * ( 2.0 * rand() / (double)RAND_MAX - 1.0 );
+        y[ i ] = range * ( 2.0 * rand() / (double)RAND_MAX - 1.0 );
+    }
+
+    const int runs = 10;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for ( int r = 0; r < runs; r++ )
+    {
+        for ( UInt32 i = 0; i < count; i++ )
+        {
+            z_scalar[ i ] = elevation->getElevation( x[ i ], y[ i ] );
+        }
+    }
+
+    std::chrono::duration< double > timeScalar = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+
+    for ( int r = 0; r < runs; r++ )
+    {
+        elevation->getElevation( &x[ 0 ], &y[ 0 ], &z_batch[ 0 ], count );
+    }
+
+    std::chrono::duration< double > timeBatch = std::chrono::steady_clock::now() - start;
+
+    UInt32 mismatches = 0;
+
+    for ( UInt32 i = 0; i < count; i++ )
+    {
+        if ( z_scalar[ i ] != z_batch[ i ] ) mismatches++;
+    }
+
+    double samples = (double)runs * count;
+
+    printf( "scalar:  %12.0f samples/s\n", samples / timeScalar.count() );
+    printf( "batched: %12.0f samples/s\n", samples / timeBatch.count() );
+    printf( "mismatches: %u\n", mismatches );
+
+    return ( mismatches == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This is headless runner main function. It runs mission without window,
+ * sound and rendering, at fixed time step and as fast as possible,
+ * then prints mission status and timing.
+ */
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    if ( argc < 2 )
+    {
+        printUsage( argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    if ( 0 == strcmp( argv[ 1 ], "--convert-elevation" ) )
+    {
+        if ( argc < 3 )
+        {
+            printUsage( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+
+        std::string csvFile = argv[ 2 ];
+        std::string binFile = ( argc > 3 ) ? argv[ 3 ] : Elevation::getBinFileName( csvFile );
+
+        if ( SIM_SUCCESS != Elevation::convert( csvFile, binFile ) )
+        {
+            std::cerr << "Cannot convert elevation file: " << csvFile << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    if ( 0 == strcmp( argv[ 1 ], "--benchmark-elevation" ) )
+    {
+        if ( argc < 3 )
+        {
+            printUsage( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+
+        UInt32 count = ( argc > 3 ) ? atoi( argv[ 3 ] ) : 1000000;
+
+        return benchmarkElevation( argv[ 2 ], count );
+    }
+
+    if ( 0 == strcmp( argv[ 1 ], "--compile-textures" ) )
+    {
+        if ( argc < 3 )
+        {
+            printUsage( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+
+        Path::setBasePath( SIM_BASE_PATH );
+
+        int result = EXIT_SUCCESS;
+
+        for ( int i = 2; i < argc; i++ )
+        {
+            if ( SIM_SUCCESS != Textures::compile( argv[ i ] ) )
+            {
+                std::cerr << "Cannot compile texture file: " << argv[ i ] << std::endl;
+                result = EXIT_FAILURE;
+            }
+        }
+
+        return result;
+    }
+
+    UInt32 missionIndex = 0;
+
+    if ( !parseIndex( argv[ 1 ], &missionIndex ) )
+    {
+        printUsage( argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    double timeStep = ( argc > 2 ) ? atof( argv[ 2 ] ) : SIM_TIME_STEP;
+    double timeMax  = ( argc > 3 ) ? atof( argv[ 3 ] ) : 3600.0;
+
+    if ( timeStep < SIM_TIME_STEP_MIN || timeStep > SIM_TIME_STEP_MAX )
+    {
+        std::cerr << "Time step must be within range from " << SIM_TIME_STEP_MIN
+                  << " to " << SIM_TIME_STEP_MAX << " s" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Path::setBasePath( SIM_BASE_PATH );
+
+    osg::setNotifyLevel( osg::WARN );
+
+    Manager *manager = Manager::instance();
+
+    manager->init( width, height, missionIndex );
+
+    // missions list is read by simulation
+    if ( missionIndex >= manager->getMissionsCount() )
+    {
+        std::cerr << "Mission index must be less than " << manager->getMissionsCount() << std::endl;
+        printUsage( argv[ 0 ] );
+        manager->destroy();
+        return EXIT_FAILURE;
+    }
+
+    manager->setTickStep( timeStep );
+
+    // mission is initialized and loaded within updates
+    std::chrono::steady_clock::time_point startInit = std::chrono::steady_clock::now();
+
+    while ( !manager->isReady() )
+    {
+        std::chrono::duration< double > timeInit = std::chrono::steady_clock::now() - startInit;
+
+        if ( timeInit.count() > timeInitMax )
+        {
+            std::cerr << "Cannot load mission: " << missionIndex << std::endl;
+            manager->destroy();
+            return EXIT_FAILURE;
+        }
+
+        manager->update( timeStep );
+    }
+
+    manager->setAutopilot( true );
+    manager->unpause();
+
+    Profiler::instance()->reset();
+
+    UInt32 steps = 0;
+    double timeSim = 0.0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    while ( !manager->isFinished() && timeSim < timeMax )
+    {
+        manager->update( timeStep );
+
+        steps++;
+        timeSim += timeStep;
+    }
+
+    std::chrono::duration< double > timeWall = std::chrono::steady_clock::now() - start;
+
+    Status status = manager->getStatus();
+
+    printf( "mission:    %u\n", missionIndex );
+    printf( "status:     %s\n", getStatusName( status ) );
+    printf( "steps:      %u\n", steps );
+    printf( "sim time:   %.3f s\n", timeSim );
+    printf( "wall time:  %.3f s\n", timeWall.count() );
+
+    if ( timeWall.count() > 0.0 )
+    {
+        printf( "speed:      %.2f sim-s/wall-s\n", timeSim / timeWall.count() );
+    }
+
+    printf( "\n%-24s %12s %12s %8s\n", "section", "total [ms]", "step [ms]", "share" );
+
+    const Profiler::Sections &sections = Profiler::instance()->getSections();
+
+    for ( UInt32 i = 0; i < sections.size(); i++ )
+    {
+        double total = 1000.0 * sections[ i ].time;
+        double step  = ( steps > 0 ) ? total / steps : 0.0;
+        double share = ( timeWall.count() > 0.0 ) ? 100.0 * sections[ i ].time / timeWall.count() : 0.0;
+
+        printf( "%-24s %12.3f %12.4f %7.1f%%\n", sections[ i ].name, total, step, share );
+    }
+
+    printf( "\n%-24s %12s %12s %12s %12s\n", "pool", "size", "capacity", "reused", "allocated" );
+    printf( "%-24s %12u %12u %12u %12u\n", "flak",
+            Pool< Flak >::getSize(), Pool< Flak >::getCapacity(),
+            Pool< Flak >::getReused(), Pool< Flak >::getAllocated() );
+
+    manager->destroy();
+
+    return ( status == Failure ) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
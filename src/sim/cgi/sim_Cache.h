@@ -0,0 +1,157 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_CACHE_H
+#define SIM_CACHE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <osg/ref_ptr>
+
+#include <sim/cgi/sim_Loader.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Hashed file based assets cache template class.
+ *
+ * Objects are keyed by file path. Objects can be requested to be read in
+ * background by the Loader. Getting object that is still pending blocks
+ * until it is read.
+ */
+template < class TYPE >
+class Cache
+{
+public:
+
+    typedef std::function< TYPE*() > Reader;
+
+    /** @brief Constructor. */
+    Cache() {}
+
+    /**
+     * @brief Returns cached object, reads it if it was not requested before.
+     * @param file object file path
+     * @param reader object reader
+     * @return object or null pointer if it cannot be read
+     */
+    TYPE* get( const std::string &file, const Reader &reader )
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+
+        if ( _entries.find( file ) == _entries.end() )
+        {
+            _entries[ file ] = Entry();
+
+            lock.unlock();
+            osg::ref_ptr<TYPE> object = reader();
+            lock.lock();
+
+            store( file, object.get() );
+        }
+
+        _loaded.wait( lock, [ this, &file ]() { return isReady( file ); } );
+
+        typename Entries::iterator it = _entries.find( file );
+
+        return ( it != _entries.end() ) ? it->second.object.get() : 0;
+    }
+
+    /**
+     * @brief Queues object to be read in background unless it is cached.
+     * @param file object file path
+     * @param reader object reader
+     */
+    void request( const std::string &file, const Reader &reader )
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+
+            if ( _entries.find( file ) != _entries.end() ) return;
+
+            _entries[ file ] = Entry();
+        }
+
+        Loader::instance()->push( [ this, file, reader ]()
+        {
+            osg::ref_ptr<TYPE> object = reader();
+
+            std::lock_guard< std::mutex > lock( _mutex );
+            store( file, object.get() );
+        });
+    }
+
+    /** @brief Removes all objects. Objects still being read are stored when done. */
+    void clear()
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _entries.clear();
+    }
+
+private:
+
+    /** Cache entry struct. */
+    struct Entry
+    {
+        Entry() : ready ( false ) {}
+
+        osg::ref_ptr<TYPE> object;  ///< object
+        bool ready;                 ///< specifies if object reading is done
+    };
+
+    typedef std::unordered_map< std::string, Entry > Entries;
+
+    Entries _entries;                       ///< objects keyed by file path
+
+    std::mutex _mutex;                      ///< entries mutex
+    std::condition_variable _loaded;        ///< signaled when object is stored
+
+    /** Using this constructor is forbidden. */
+    Cache( const Cache & ) {}
+
+    /** Returns true if object is not pending, must be called with mutex locked. */
+    bool isReady( const std::string &file ) const
+    {
+        typename Entries::const_iterator it = _entries.find( file );
+        return it == _entries.end() || it->second.ready;
+    }
+
+    /** Stores object, must be called with mutex locked. */
+    void store( const std::string &file, TYPE *object )
+    {
+        Entry &entry = _entries[ file ];
+
+        entry.object = object;
+        entry.ready  = true;
+
+        _loaded.notify_all();
+    }
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_CACHE_H
@@ -73,19 +73,19 @@ void Camera::update()
                            0.0, osg::Y_AXIS,
                     M_PI / 2.0, osg::Z_AXIS );
 
-        Quat q_enu( Data::get()->ownship.att_x,
-                    Data::get()->ownship.att_y,
-                    Data::get()->ownship.att_z,
-                    Data::get()->ownship.att_w );
+        Quat q_enu( Data::view()->ownship.att_x,
+                    Data::view()->ownship.att_y,
+                    Data::view()->ownship.att_z,
+                    Data::view()->ownship.att_w );
 
-        Vec3 r_enu( Data::get()->ownship.pos_x,
-                    Data::get()->ownship.pos_y,
-                    Data::get()->ownship.pos_z );
+        Vec3 r_enu( Data::view()->ownship.pos_x,
+                    Data::view()->ownship.pos_y,
+                    Data::view()->ownship.pos_z );
 
         if ( _type == ViewChase )
         {
-            _d_tht = -0.5f * Data::get()->ownship.pitchRate;
-            _d_psi =  0.1f * Data::get()->ownship.yawRate;
+            _d_tht = -0.5f * Data::view()->ownship.pitchRate;
+            _d_psi =  0.1f * Data::view()->ownship.yawRate;
 
             _d_x = 25.0f;
             _d_y = _d_x * tan( _d_psi ) * ( -1.0f );
@@ -188,30 +188,30 @@ void Camera::update()
 
     Angles angles( attitude );
 
-    Data::get()->camera.type = _type;
+    Data::view()->camera.type = _type;
 
-    Data::get()->camera.altitude_asl = position.z();
+    Data::view()->camera.altitude_asl = position.z();
 
-    Data::get()->camera.pos_x = position.x();
-    Data::get()->camera.pos_y = position.y();
-    Data::get()->camera.pos_z = position.z();
+    Data::view()->camera.pos_x = position.x();
+    Data::view()->camera.pos_y = position.y();
+    Data::view()->camera.pos_z = position.z();
 
-    Data::get()->camera.att_w = attitude.w();
-    Data::get()->camera.att_x = attitude.x();
-    Data::get()->camera.att_y = attitude.y();
-    Data::get()->camera.att_z = attitude.z();
+    Data::view()->camera.att_w = attitude.w();
+    Data::view()->camera.att_x = attitude.x();
+    Data::view()->camera.att_y = attitude.y();
+    Data::view()->camera.att_z = attitude.z();
 
-    Data::get()->camera.att_phi = angles.phi();
-    Data::get()->camera.att_tht = angles.tht();
-    Data::get()->camera.att_psi = angles.psi();
+    Data::view()->camera.att_phi = angles.phi();
+    Data::view()->camera.att_tht = angles.tht();
+    Data::view()->camera.att_psi = angles.psi();
 
-    Data::get()->camera.d_x = _d_x;
-    Data::get()->camera.d_y = _d_y;
-    Data::get()->camera.d_z = _d_z;
+    Data::view()->camera.d_x = _d_x;
+    Data::view()->camera.d_y = _d_y;
+    Data::view()->camera.d_z = _d_z;
 
-    Data::get()->camera.d_phi = _d_phi;
-    Data::get()->camera.d_tht = _d_tht;
-    Data::get()->camera.d_psi = _d_psi;
+    Data::view()->camera.d_phi = _d_phi;
+    Data::view()->camera.d_tht = _d_tht;
+    Data::view()->camera.d_psi = _d_psi;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -270,18 +270,18 @@ void Camera::setWorldNode( osg::Node *node )
 
 void Camera::setFlybyCameraPosition()
 {
-    Quat att( Data::get()->ownship.att_x,
-              Data::get()->ownship.att_y,
-              Data::get()->ownship.att_z,
-              Data::get()->ownship.att_w );
+    Quat att( Data::view()->ownship.att_x,
+              Data::view()->ownship.att_y,
+              Data::view()->ownship.att_z,
+              Data::view()->ownship.att_w );
 
-    Vec3 pos( Data::get()->ownship.pos_x,
-              Data::get()->ownship.pos_y,
-              Data::get()->ownship.pos_z );
+    Vec3 pos( Data::view()->ownship.pos_x,
+              Data::view()->ownship.pos_y,
+              Data::view()->ownship.pos_z );
 
-    double dy = ( Data::get()->ownship.rollAngle > 0.0 ) ? 20.0 : -20.0;
+    double dy = ( Data::view()->ownship.rollAngle > 0.0 ) ? 20.0 : -20.0;
 
-    Vec3 vel( -5.0 * Data::get()->ownship.airspeed, dy, 10.0 );
+    Vec3 vel( -5.0 * Data::view()->ownship.airspeed, dy, 10.0 );
 
     _flyby = pos + att * vel;
 }
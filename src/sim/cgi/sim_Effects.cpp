@@ -17,10 +17,18 @@
 
 #include <sim/cgi/sim_Effects.h>
 
-#include <osg/PositionAttitudeTransform>
+#include <algorithm>
 
-#include <osgParticle/ModularEmitter>
-#include <osgParticle/ParticleSystemUpdater>
+#include <osg/Transform>
+
+#include <osgParticle/PointPlacer>
+#include <osgParticle/RadialShooter>
+#include <osgParticle/RandomRateCounter>
+#include <osgParticle/SectorPlacer>
+
+#include <sim/sim_Data.h>
+
+#include <sim/cgi/sim_FogScene.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -28,54 +36,26 @@ using namespace sim;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-osg::Group* Effects::createExplosion( float scale )
-{
-    osg::ref_ptr<osg::Group> group = new osg::Group();
+int Effects::_budget = SIM_EFFECTS_BUDGET;
 
-    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-    group->addChild( pat.get() );
+osg::ref_ptr<osg::Group> Effects::_root;
+osg::ref_ptr<osg::Geode> Effects::_geode;
+osg::ref_ptr<osgParticle::ParticleSystemUpdater> Effects::_updater;
 
-    pat->setAttitude( osg::Quat( 0.0, osg::Z_AXIS,
-                          -osg::PI_2, osg::Y_AXIS,
-                          -osg::PI_2, osg::X_AXIS ) );
+Effects::Systems  Effects::_systems;
+Effects::Emitters Effects::_emitters;
 
-    osg::ref_ptr<osgParticle::ParticleSystem> ps = new osgParticle::ParticleSystem();
-    ps->getDefaultParticleTemplate().setLifeTime( 0.75f );
-    ps->getDefaultParticleTemplate().setShape( osgParticle::Particle::QUAD );
-    ps->getDefaultParticleTemplate().setSizeRange( osgParticle::rangef(1.0f, scale) );
-    ps->getDefaultParticleTemplate().setAlphaRange( osgParticle::rangef(1.0f, 0.0f) );
-    ps->getDefaultParticleTemplate().setColorRange(
-        osgParticle::rangev4(osg::Vec4(1.0f,1.0f,0.5f,1.0f), osg::Vec4(1.0f,0.5f,0.0f,1.0f)) );
-    ps->setDefaultAttributes( getPath( "textures/explosion.rgb" ), true, false );
+Effects::SystemsList Effects::_created;
 
-    osg::ref_ptr<osgParticle::RandomRateCounter> rrc = new osgParticle::RandomRateCounter();
-    rrc->setRateRange( 10, 20 );
+Effects::Requests Effects::_explosions;
+Effects::Requests Effects::_flakBursts;
 
-    osg::ref_ptr<osgParticle::RadialShooter> shooter = new osgParticle::RadialShooter();
-    shooter->setThetaRange( -osg::PI, osg::PI );
-    shooter->setPhiRange( -osg::PI, osg::PI );
-    shooter->setInitialSpeedRange( -10.0f, 10.0f );
+Effects::TrackedList Effects::_tracked;
 
-    osg::ref_ptr<osgParticle::ModularEmitter> emitter = new osgParticle::ModularEmitter();
-    emitter->setParticleSystem( ps.get() );
-    emitter->setCounter( rrc.get() );
-    emitter->setShooter( shooter.get() );
-    emitter->setEndless( false );
-    emitter->setLifeTime( 0.75f );
-
-    pat->addChild( emitter.get() );
-
-    osg::ref_ptr<osgParticle::ParticleSystemUpdater> updater = new osgParticle::ParticleSystemUpdater();
-    updater->addParticleSystem( ps.get() );
+osg::Vec3 Effects::_pos_cam;
+osg::Vec3 Effects::_dir_cam;
 
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    geode->addDrawable( ps.get() );
-
-    group->addChild( updater.get() );
-    group->addChild( geode.get() );
-
-    return group.release();
-}
+int Effects::_particles = 0;
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -83,17 +63,10 @@ osg::Group* Effects::createFlames( const char *texture )
 {
     osg::ref_ptr<osg::Group> group = new osg::Group();
 
-    osg::ref_ptr<osgParticle::ParticleSystemUpdater> updater = new osgParticle::ParticleSystemUpdater();
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-
-    osg::ref_ptr<osgParticle::ParticleSystem> ps = new osgParticle::ParticleSystem();
-    ps->getDefaultParticleTemplate().setLifeTime( 1.5f );
-    ps->getDefaultParticleTemplate().setShape( osgParticle::Particle::QUAD );
-    ps->getDefaultParticleTemplate().setSizeRange( osgParticle::rangef(1.0f, 0.4f) );
-    ps->getDefaultParticleTemplate().setAlphaRange( osgParticle::rangef(1.0f, 0.0f) );
-    ps->getDefaultParticleTemplate().setColorRange(
+    osgParticle::Particle particle = createParticle( 1.5f,
+        osgParticle::rangef(1.0f, 0.4f),
+        osgParticle::rangef(1.0f, 0.0f),
         osgParticle::rangev4(osg::Vec4(1.0f,1.0f,0.5f,1.0f), osg::Vec4(1.0f,0.5f,0.0f,1.0f)) );
-    ps->setDefaultAttributes( texture, true, false );
 
     osg::ref_ptr<osgParticle::RandomRateCounter> rrc = new osgParticle::RandomRateCounter();
     rrc->setRateRange( 7, 15 );
@@ -106,17 +79,15 @@ osg::Group* Effects::createFlames( const char *texture )
                                              osg::Vec3( 0.0f, 0.0, 5.0 ) );
 
     osg::ref_ptr<osgParticle::ModularEmitter> emitter = new osgParticle::ModularEmitter();
-    emitter->setParticleSystem( ps.get() );
+    emitter->setParticleSystem( getSystem( texture, true ) );
+    emitter->setUseDefaultTemplate( false );
+    emitter->setParticleTemplate( particle );
     emitter->setCounter( rrc.get() );
     emitter->setShooter( shooter.get() );
 
     group->addChild( emitter.get() );
 
-    updater->addParticleSystem( ps.get() );
-    geode->addDrawable( ps.get() );
-
-    group->addChild( updater.get() );
-    group->addChild( geode.get() );
+    track( emitter.get(), 1.0f );
 
     return group.release();
 }
@@ -135,17 +106,10 @@ osg::Group* Effects::createFlames( const char *texture )
 
     osg::ref_ptr<osg::Group> group = new osg::Group();
 
-    osg::ref_ptr<osgParticle::ParticleSystemUpdater> updater = new osgParticle::ParticleSystemUpdater();
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-
-    osg::ref_ptr<osgParticle::ParticleSystem> ps = new osgParticle::ParticleSystem();
-    ps->getDefaultParticleTemplate().setLifeTime( lifeTime );
-    ps->getDefaultParticleTemplate().setShape( osgParticle::Particle::QUAD );
-    ps->getDefaultParticleTemplate().setSizeRange( osgParticle::rangef(size0, size1) );
-    ps->getDefaultParticleTemplate().setAlphaRange( osgParticle::rangef(1.0f, 0.0f) );
-    ps->getDefaultParticleTemplate().setColorRange(
+    osgParticle::Particle particle = createParticle( lifeTime,
+        osgParticle::rangef(size0, size1),
+        osgParticle::rangef(1.0f, 0.0f),
         osgParticle::rangev4(osg::Vec4(1.0f,1.0f,1.0f,1.0f), osg::Vec4(1.0f,1.0f,1.0f,0.0f)) );
-    ps->setDefaultAttributes( getPath( "textures/smoke_dark.rgb" ), false, false );
 
     osg::ref_ptr<osgParticle::RandomRateCounter> rrc = new osgParticle::RandomRateCounter();
     rrc->setRateRange( 20.0f * intensity, 30.0f * intensity );
@@ -156,29 +120,421 @@ osg::Group* Effects::createFlames( const char *texture )
     shooter->setInitialSpeedRange( 7.5f*speed, 15.0f*speed );
 
     osg::ref_ptr<osgParticle::ModularEmitter> emitter = new osgParticle::ModularEmitter();
-    emitter->setParticleSystem( ps.get() );
+    emitter->setParticleSystem( getSystem( getPath( "textures/smoke_dark.rgb" ), false ) );
+    emitter->setUseDefaultTemplate( false );
+    emitter->setParticleTemplate( particle );
     emitter->setCounter( rrc.get() );
     emitter->setShooter( shooter.get() );
 
     group->addChild( emitter.get() );
 
-    updater->addParticleSystem( ps.get() );
-    geode->addDrawable( ps.get() );
+    track( emitter.get(), std::max( size0, size1 ) );
 
-    group->addChild( updater.get() );
-    group->addChild( geode.get() );
+    return group.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Group* Effects::createSmokeTrail()
+{
+    osg::ref_ptr<osg::Group> group = new osg::Group();
+
+    osgParticle::Particle particle = createParticle( 5.0f,
+        osgParticle::rangef(0.75f, 3.0f),
+        osgParticle::rangef(0.1f, 1.0f),
+        osgParticle::rangev4(osg::Vec4(1.0f,1.0f,1.0f,1.0f), osg::Vec4(1.0f,1.0f,1.0f,0.0f)) );
+
+    osg::ref_ptr<osgParticle::RandomRateCounter> rrc = new osgParticle::RandomRateCounter();
+    rrc->setRateRange( 30.0f, 50.0f );
+
+    osg::ref_ptr<osgParticle::SectorPlacer> placer = new osgParticle::SectorPlacer();
+    placer->setRadiusRange( 0.0f, 0.25f );
+
+    osg::ref_ptr<osgParticle::RadialShooter> shooter = new osgParticle::RadialShooter();
+    shooter->setThetaRange( 0.0f, osg::PI_4 );
+    shooter->setInitialSpeedRange( 1.0f, 2.0f );
+
+    osg::ref_ptr<osgParticle::ModularEmitter> emitter = new osgParticle::ModularEmitter();
+    emitter->setParticleSystem( getSystem( getPath( "textures/smoke_light.rgb" ), false ) );
+    emitter->setUseDefaultTemplate( false );
+    emitter->setParticleTemplate( particle );
+    emitter->setCounter( rrc.get() );
+    emitter->setPlacer( placer.get() );
+    emitter->setShooter( shooter.get() );
+
+    group->addChild( emitter.get() );
+
+    track( emitter.get(), 5.0f );
 
     return group.release();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Effects::Smoke* Effects::createSmokeTrail()
+void Effects::emitExplosion( const osg::Vec3 &pos, float scale )
+{
+    Request request;
+
+    request.pos   = pos;
+    request.value = scale;
+
+    _explosions.push_back( request );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Effects::emitFlakBurst( const osg::Vec3 &pos, float lifeTime )
 {
-    Smoke *smokeTrail = new Smoke();
-    smokeTrail->setTextureFileName( getPath( "textures/smoke_light.rgb" ) );
-    smokeTrail->setIntensity( 10.0f );
-    smokeTrail->setEmitterDuration( 1000.0 );
+    Request request;
+
+    request.pos   = pos;
+    request.value = lifeTime;
+
+    _flakBursts.push_back( request );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Group* Effects::getNode()
+{
+    if ( !_root.valid() )
+    {
+        _root    = new osg::Group();
+        _geode   = new osg::Geode();
+        _updater = new osgParticle::ParticleSystemUpdater();
+
+        _root->addChild( _updater.get() );
+        _root->addChild( _geode.get() );
+    }
+
+    return _root.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Effects::reset()
+{
+    for ( Systems::iterator it = _systems.begin(); it != _systems.end(); ++it )
+    {
+        for ( int i = 0; i < it->second->numParticles(); i++ )
+        {
+            it->second->destroyParticle( i );
+        }
+    }
+
+    for ( Emitters::iterator it = _emitters.begin(); it != _emitters.end(); ++it )
+    {
+        (*it)->setStartTime( 0.0 );
+        (*it)->setLifeTime( 0.0 );
+    }
+
+    _explosions.clear();
+    _flakBursts.clear();
+
+    _tracked.clear();
+
+    _particles = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Effects::update()
+{
+    getNode();
+
+    for ( SystemsList::iterator it = _created.begin(); it != _created.end(); ++it )
+    {
+        _geode->addDrawable( it->get() );
+        _updater->addParticleSystem( it->get() );
+    }
+
+    _created.clear();
+
+    _pos_cam.set( Data::view()->camera.pos_x,
+                  Data::view()->camera.pos_y,
+                  Data::view()->camera.pos_z );
+
+    osg::Quat att_cam( Data::view()->camera.att_x,
+                       Data::view()->camera.att_y,
+                       Data::view()->camera.att_z,
+                       Data::view()->camera.att_w );
+
+    _dir_cam = att_cam * osg::Vec3( 0.0f, 0.0f, -1.0f );
+
+    _particles = 0;
+
+    for ( Systems::iterator it = _systems.begin(); it != _systems.end(); ++it )
+    {
+        _particles += it->second->numParticles() - it->second->numDeadParticles();
+    }
+
+    for ( Requests::iterator it = _explosions.begin(); it != _explosions.end(); ++it )
+    {
+        emitExplosionNow( it->pos, it->value );
+    }
+
+    for ( Requests::iterator it = _flakBursts.begin(); it != _flakBursts.end(); ++it )
+    {
+        emitFlakBurstNow( it->pos, it->value );
+    }
+
+    _explosions.clear();
+    _flakBursts.clear();
+
+    TrackedList::iterator it = _tracked.begin();
+
+    while ( it != _tracked.end() )
+    {
+        osg::ref_ptr<osgParticle::ModularEmitter> emitter;
+
+        if ( !it->emitter.lock( emitter ) )
+        {
+            it = _tracked.erase( it );
+            continue;
+        }
+
+        it->score = 0.0f;
+        it->cost  = 0.0f;
+
+        osg::NodePathList paths = emitter->getParentalNodePaths();
+        osgParticle::ParticleSystem *ps = emitter->getParticleSystem();
+
+        if ( paths.size() > 0 && ps )
+        {
+            osg::Vec3 r_cam = osg::computeLocalToWorld( paths[ 0 ] ).getTrans() - _pos_cam;
+
+            float distance = r_cam.length();
+            float lod = getLOD( distance );
+
+            it->score = it->size / std::max( distance, 1.0f );
+
+            // emitters behind the camera are less important
+            if ( r_cam * _dir_cam < 0.0f ) it->score *= 0.25f;
+
+            osgParticle::RandomRateCounter *rrc =
+                    dynamic_cast< osgParticle::RandomRateCounter* >( emitter->getCounter() );
+
+            if ( rrc ) rrc->setRateRange( lod * it->rate.minimum, lod * it->rate.maximum );
+
+            const osgParticle::Particle &particle = emitter->getUseDefaultTemplate()
+                    ? ps->getDefaultParticleTemplate() : emitter->getParticleTemplate();
+
+            it->cost = 0.5f * lod * ( it->rate.minimum + it->rate.maximum ) * particle.getLifeTime();
+
+            emitter->setEnabled( lod > 0.0f );
+        }
+
+        ++it;
+    }
+
+    // when over budget the least visible emitters are disabled
+    std::sort( _tracked.begin(), _tracked.end(), isMoreVisible );
+
+    float cost = 0.0f;
+
+    for ( it = _tracked.begin(); it != _tracked.end(); ++it )
+    {
+        cost += it->cost;
+
+        if ( cost > _budget )
+        {
+            osg::ref_ptr<osgParticle::ModularEmitter> emitter;
+
+            if ( it->emitter.lock( emitter ) )
+            {
+                emitter->setEnabled( false );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osgParticle::Particle Effects::createParticle( float lifeTime,
+                                               const osgParticle::rangef &size,
+                                               const osgParticle::rangef &alpha,
+                                               const osgParticle::rangev4 &color )
+{
+    osgParticle::Particle particle;
+
+    particle.setLifeTime( lifeTime );
+    particle.setShape( osgParticle::Particle::QUAD );
+    particle.setSizeRange( size );
+    particle.setAlphaRange( alpha );
+    particle.setColorRange( color );
+
+    return particle;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Effects::emitExplosionNow( const osg::Vec3 &pos, float scale )
+{
+    osgParticle::Particle fire = createParticle( 0.5f,
+        osgParticle::rangef(1.0f*scale, 2.0f*scale),
+        osgParticle::rangef(1.0f, 0.0f),
+        osgParticle::rangev4(osg::Vec4(1.0f,1.0f,0.5f,1.0f), osg::Vec4(1.0f,0.5f,0.0f,1.0f)) );
+
+    emit( pos, getSystem( getPath( "textures/explosion_fire.rgb" ), true ), fire,
+          osgParticle::rangef( 10.0f, 20.0f ), osgParticle::rangef( -10.0f, 10.0f ),
+          0.0, 0.25 );
+
+    osgParticle::Particle smoke = createParticle( 10.0f,
+        osgParticle::rangef(1.0f*scale, 8.0f*scale),
+        osgParticle::rangef(1.0f, 0.0f),
+        osgParticle::rangev4(osg::Vec4(0.0f,0.0f,0.0f,1.0f), osg::Vec4(0.5f,0.5f,0.5f,1.0f)) );
+
+    emit( pos, getSystem( getPath( "textures/explosion_smoke.rgb" ), false ), smoke,
+          osgParticle::rangef( 10.0f, 10.0f ), osgParticle::rangef( -2.0f, 2.0f ),
+          0.1, 0.5 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Effects::emitFlakBurstNow( const osg::Vec3 &pos, float lifeTime )
+{
+    osgParticle::Particle burst = createParticle( lifeTime,
+        osgParticle::rangef(7.0f, 10.0f),
+        osgParticle::rangef(0.9f, 0.0f),
+        osgParticle::rangev4(osg::Vec4(1.0f,1.0f,1.0f,1.0f), osg::Vec4(1.0f,1.0f,0.0f,1.0f)) );
+
+    emit( pos, getSystem( getPath( "textures/flak.rgb" ), false ), burst,
+          osgParticle::rangef( 10.0f, 10.0f ), osgParticle::rangef( 0.0f, 0.0f ),
+          0.0, 0.1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Effects::emit( const osg::Vec3 &pos,
+                    osgParticle::ParticleSystem *ps,
+                    const osgParticle::Particle &particle,
+                    const osgParticle::rangef &rate,
+                    const osgParticle::rangef &speed,
+                    double startTime, double lifeTime )
+{
+    float lod = getLOD( ( pos - _pos_cam ).length() );
+
+    // distant one-shot effects are skipped when over budget
+    if ( lod <= 0.0f || ( _particles >= _budget && lod < 1.0f ) )
+    {
+        return;
+    }
+
+    osg::ref_ptr<osgParticle::ModularEmitter> emitter;
+
+    for ( Emitters::iterator it = _emitters.begin(); it != _emitters.end() && !emitter.valid(); ++it )
+    {
+        if ( !(*it)->isAlive() )
+        {
+            emitter = (*it);
+        }
+    }
+
+    if ( !emitter.valid() )
+    {
+        // pooled emitters are placed in the shared particle systems world frame
+        emitter = new osgParticle::ModularEmitter();
+        emitter->setCounter( new osgParticle::RandomRateCounter() );
+        emitter->setPlacer( new osgParticle::PointPlacer() );
+        emitter->setShooter( new osgParticle::RadialShooter() );
+        emitter->setEndless( false );
+        emitter->setUseDefaultTemplate( false );
+
+        getNode()->addChild( emitter.get() );
+        _emitters.push_back( emitter.get() );
+    }
+
+    osgParticle::RandomRateCounter *rrc     = static_cast< osgParticle::RandomRateCounter* >( emitter->getCounter() );
+    osgParticle::PointPlacer       *placer  = static_cast< osgParticle::PointPlacer*       >( emitter->getPlacer()  );
+    osgParticle::RadialShooter     *shooter = static_cast< osgParticle::RadialShooter*     >( emitter->getShooter() );
+
+    rrc->setRateRange( lod * rate.minimum, lod * rate.maximum );
+
+    placer->setCenter( pos );
+
+    shooter->setThetaRange( -osg::PI, osg::PI );
+    shooter->setPhiRange( -osg::PI, osg::PI );
+    shooter->setInitialSpeedRange( speed );
+
+    emitter->setParticleSystem( ps );
+    emitter->setParticleTemplate( particle );
+    emitter->setStartTime( startTime );
+    emitter->setLifeTime( lifeTime );
+    emitter->setCurrentTime( 0.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+float Effects::getLOD( float distance )
+{
+    float distance_max = FogScene::_visibility;
+
+    if ( distance < SIM_EFFECTS_LOD_NEAR )
+    {
+        return 1.0f;
+    }
+    else if ( distance > distance_max )
+    {
+        return 0.0f;
+    }
+
+    float coef = ( distance - SIM_EFFECTS_LOD_NEAR ) / ( distance_max - SIM_EFFECTS_LOD_NEAR );
+
+    return 1.0f - coef * ( 1.0f - SIM_EFFECTS_LOD_MIN );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osgParticle::ParticleSystem* Effects::getSystem( const std::string &texture, bool emissive )
+{
+    std::string key = texture + ( emissive ? "#emissive" : "" );
+
+    Systems::iterator it = _systems.find( key );
+
+    if ( it != _systems.end() )
+    {
+        return it->second.get();
+    }
+
+    osg::ref_ptr<osgParticle::ParticleSystem> ps = new osgParticle::ParticleSystem();
+    ps->setDefaultAttributes( texture, emissive, false );
+
+    // system is placed in the scene graph by update()
+    _created.push_back( ps.get() );
+
+    _systems[ key ] = ps.get();
+
+    return ps.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Effects::isMoreVisible( const Tracked &t1, const Tracked &t2 )
+{
+    return t1.score > t2.score;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Effects::track( osgParticle::ModularEmitter *emitter, float size )
+{
+    osgParticle::RandomRateCounter *rrc = 0;
+
+    if ( emitter )
+    {
+        rrc = dynamic_cast< osgParticle::RandomRateCounter* >( emitter->getCounter() );
+    }
+
+    if ( rrc )
+    {
+        Tracked tracked;
+
+        tracked.emitter = emitter;
+        tracked.rate    = rrc->getRateRange();
+        tracked.size    = size;
+        tracked.score   = 0.0f;
+        tracked.cost    = 0.0f;
 
-    return smokeTrail;
+        _tracked.push_back( tracked );
+    }
 }
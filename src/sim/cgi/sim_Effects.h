@@ -19,9 +19,15 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
+#include <vector>
+
+#include <osg/Geode>
 #include <osg/Group>
+#include <osg/observer_ptr>
 
-#include <osgParticle/SmokeEffect>
+#include <osgParticle/ModularEmitter>
+#include <osgParticle/ParticleSystemUpdater>
 
 #include <sim/sim_Base.h>
 
@@ -30,15 +36,27 @@
 namespace sim
 {
 
-/** @brief Effects class. */
+/**
+ * @brief Effects class.
+ *
+ * Particle effects use long-lived particle systems shared by all effects of
+ * the same texture. One-shot effects use pooled emitters placed at event
+ * positions, so the number of particle systems and updaters stays constant.
+ *
+ * Number of alive particles is limited by the effects budget. Emitters
+ * emission rate is reduced with distance to the camera, emitters beyond fog
+ * visibility are disabled and when over budget the least visible emitters
+ * are disabled first.
+ *
+ * Effects might be created and emitted during simulation step, which may run
+ * concurrently with rendering. New particle systems and one-shot effects are
+ * queued and placed in the scene graph on the view side, by update().
+ */
 class Effects : public Base
 {
 public:
 
-    typedef osgParticle::SmokeEffect Smoke;
-
-    /** @brief Creates explosion effect. */
-    static osg::Group* createExplosion( float scale );
+    static int _budget;     ///< maximum number of alive particles
 
     /** @brief Creates flames effect. */
     static osg::Group* createFlames( const char *texture );
@@ -50,9 +68,118 @@ public:
                                     float intensity = 1.0f,
                                     float speed = 1.0f );
 
-    /** @brief Creates smoke trail effect. */
-    static Smoke* createSmokeTrail();
-
+    /**
+     * @brief Creates smoke trail effect. Particles are emitted into the shared
+     * world frame particle system, so effect should be placed in the moving
+     * entity frame and never needs to be repositioned.
+     */
+    static osg::Group* createSmokeTrail();
+
+    /**
+     * @brief Queues explosion fire and smoke to be emitted on next update.
+     * @param pos explosion position
+     * @param scale explosion scale
+     */
+    static void emitExplosion( const osg::Vec3 &pos, float scale );
+
+    /**
+     * @brief Queues flak burst to be emitted on next update.
+     * @param pos burst position
+     * @param lifeTime [s] burst particles life time
+     */
+    static void emitFlakBurst( const osg::Vec3 &pos, float lifeTime );
+
+    /** @brief Returns shared particle systems node, it must be placed in world frame. */
+    static osg::Group* getNode();
+
+    /** @brief Removes all particles, queued effects and stops pooled emitters. */
+    static void reset();
+
+    /**
+     * @brief Places new particle systems in the scene graph, emits queued
+     * effects and updates effects level of detail and budget, must be called
+     * on the view side after camera update.
+     */
+    static void update();
+
+private:
+
+    /** Continuous emitter data struct. */
+    struct Tracked
+    {
+        osg::observer_ptr<osgParticle::ModularEmitter> emitter; ///< emitter
+        osgParticle::rangef rate;                               ///< [1/s] full emission rate
+        float size;                                             ///< [m] effect size
+        float score;                                            ///< visibility score
+        float cost;                                             ///< expected number of alive particles
+    };
+
+    /** Queued one-shot effect data struct. */
+    struct Request
+    {
+        osg::Vec3 pos;      ///< [m] effect position
+        float value;        ///< explosion scale or flak burst life time
+    };
+
+    typedef std::map< std::string, osg::ref_ptr<osgParticle::ParticleSystem> > Systems;
+    typedef std::vector< osg::ref_ptr<osgParticle::ParticleSystem> > SystemsList;
+    typedef std::vector< osg::ref_ptr<osgParticle::ModularEmitter> > Emitters;
+    typedef std::vector< Request > Requests;
+    typedef std::vector< Tracked > TrackedList;
+
+    static osg::ref_ptr<osg::Group> _root;                              ///< shared particle systems root
+    static osg::ref_ptr<osg::Geode> _geode;                             ///< shared particle systems geode
+    static osg::ref_ptr<osgParticle::ParticleSystemUpdater> _updater;   ///< shared particle systems updater
+
+    static Systems  _systems;       ///< shared particle systems
+    static Emitters _emitters;      ///< pooled one-shot emitters
+
+    static SystemsList _created;    ///< particle systems not placed in the scene graph yet
+
+    static Requests _explosions;    ///< queued explosions
+    static Requests _flakBursts;    ///< queued flak bursts
+
+    static TrackedList _tracked;    ///< continuous emitters
+
+    static osg::Vec3 _pos_cam;      ///< [m] camera position
+    static osg::Vec3 _dir_cam;      ///< camera view direction
+
+    static int _particles;          ///< number of alive particles
+
+    /** Creates particle template. */
+    static osgParticle::Particle createParticle( float lifeTime,
+                                                const osgParticle::rangef &size,
+                                                const osgParticle::rangef &alpha,
+                                                const osgParticle::rangev4 &color );
+
+    /** Emits explosion fire and smoke. */
+    static void emitExplosionNow( const osg::Vec3 &pos, float scale );
+
+    /** Emits flak burst. */
+    static void emitFlakBurstNow( const osg::Vec3 &pos, float lifeTime );
+
+    /**
+     * Emits particles in all directions from given position using pooled
+     * one-shot emitter, reuses emitter that is done or creates new one.
+     */
+    static void emit( const osg::Vec3 &pos,
+                      osgParticle::ParticleSystem *ps,
+                      const osgParticle::Particle &particle,
+                      const osgParticle::rangef &rate,
+                      const osgParticle::rangef &speed,
+                      double startTime, double lifeTime );
+
+    /** Returns level of detail emission rate coefficient, 0 if effect should be culled. */
+    static float getLOD( float distance );
+
+    /** Returns shared particle system, creates it if it does not exist. */
+    static osgParticle::ParticleSystem* getSystem( const std::string &texture, bool emissive );
+
+    /** Returns true if first emitter is more visible than the second one. */
+    static bool isMoreVisible( const Tracked &t1, const Tracked &t2 );
+
+    /** Adds continuous emitter to the level of detail and budget management. */
+    static void track( osgParticle::ModularEmitter *emitter, float size );
 };
 
 } // end of sim namespace
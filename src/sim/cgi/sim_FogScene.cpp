@@ -67,6 +67,9 @@ FogScene::FogScene( Module *parent ) :
     stateSet->setAttributeAndModes( _fog.get(), osg::StateAttribute::ON );
     stateSet->setMode( GL_FOG, osg::StateAttribute::ON );
 
+    _fogEnabled = new osg::Uniform( "fogEnabled", true );
+    stateSet->addUniform( _fogEnabled.get() );
+
     addChild( new Scenery( this ) );
 
     _root->addChild( Entities::instance()->getNode() );
@@ -87,13 +90,15 @@ void FogScene::update()
 #   ifdef SIM_TEST
     osg::ref_ptr<osg::StateSet> stateSet = _root->getOrCreateStateSet();
 
-    if ( Data::get()->camera.type == ViewWorld )
+    if ( Data::view()->camera.type == ViewWorld )
     {
         stateSet->setMode( GL_FOG, osg::StateAttribute::OFF );
+        _fogEnabled->set( false );
     }
     else
     {
         stateSet->setMode( GL_FOG, osg::StateAttribute::ON );
+        _fogEnabled->set( true );
     }
 #   endif
 }
@@ -21,6 +21,7 @@
 
 #include <osg/Fog>
 #include <osg/Group>
+#include <osg/Uniform>
 
 #include <sim/cgi/sim_Module.h>
 
@@ -51,7 +52,8 @@ public:
 
 private:
 
-    osg::ref_ptr<osg::Fog> _fog;    ///< fog
+    osg::ref_ptr<osg::Fog> _fog;                ///< fog
+    osg::ref_ptr<osg::Uniform> _fogEnabled;     ///< specifies if fog is enabled for shaders, GL_FOG mode does not affect them
 };
 
 } // end of sim namespace
@@ -29,51 +29,44 @@ using namespace sim;
 
 osgText::Font* Fonts::get( const std::string &fontFile )
 {
-    for ( unsigned int i = 0; i < instance()->_fileNames.size(); i++ )
-    {
-        if ( fontFile == instance()->_fileNames.at( i ) )
-        {
-            return instance()->_fonts.at( i );
-        }
-    }
-
-    osg::ref_ptr<osgText::Font> font = osgText::readFontFile( fontFile );
-
-    if ( font.valid() )
-    {
-        instance()->_fonts.push_back( font.get() );
-        instance()->_fileNames.push_back( fontFile );
+    return instance()->_fonts.get( fontFile, [ fontFile ]() { return read( fontFile ); } );
+}
 
-        return font.get();
-    }
-    else
-    {
-        Log::e() << "Cannot open font file: " << fontFile << std::endl;
-    }
+////////////////////////////////////////////////////////////////////////////////
 
-    return 0;
+void Fonts::request( const std::string &fontFile )
+{
+    instance()->_fonts.request( fontFile, [ fontFile ]() { return read( fontFile ); } );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Fonts::reset()
 {
-    instance()->_fileNames.clear();
     instance()->_fonts.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Fonts::Fonts()
+Fonts::Fonts() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Fonts::~Fonts()
 {
-    _fileNames.clear();
     _fonts.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Fonts::~Fonts()
+osgText::Font* Fonts::read( const std::string &fontFile )
 {
-    _fileNames.clear();
-    _fonts.clear();
+    osg::ref_ptr<osgText::Font> font = osgText::readFontFile( fontFile );
+
+    if ( !font.valid() )
+    {
+        Log::e() << "Cannot open font file: " << fontFile << std::endl;
+    }
+
+    return font.release();
 }
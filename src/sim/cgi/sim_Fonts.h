@@ -21,6 +21,8 @@
 
 #include <osgText/Font>
 
+#include <sim/cgi/sim_Cache.h>
+
 #include <sim/utils/sim_Singleton.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,11 +37,12 @@ class Fonts : public Singleton< Fonts >
 
 public:
 
-    typedef std::vector< osg::ref_ptr<osgText::Font> > List;
-
-    /** */
+    /** @brief Returns cached font, waits if it is still being read in background. */
     static osgText::Font* get( const std::string &fontFile );
 
+    /** @brief Queues font to be read in background. */
+    static void request( const std::string &fontFile );
+
     /** @brief Resets fonts list. */
     static void reset();
 
@@ -61,8 +64,10 @@ public:
 
 private:
 
-    List _fonts;                            ///<
-    std::vector< std::string > _fileNames;  ///<
+    Cache< osgText::Font > _fonts;          ///< fonts cache
+
+    /** Reads font from file, used by fonts cache. */
+    static osgText::Font* read( const std::string &fontFile );
 };
 
 } // end of sim namespace
@@ -70,21 +70,21 @@ void Gates::update()
     Module::update();
     /////////////////
 
-    if ( Data::get()->mission.status == Pending && !Data::get()->paused
-      && ( Data::get()->camera.type == ViewChase || Data::get()->camera.type == ViewPilot ) )
+    if ( Data::view()->mission.status == Pending && !Data::view()->paused
+      && ( Data::view()->camera.type == ViewChase || Data::view()->camera.type == ViewPilot ) )
     {
-        if ( Data::get()->ownship.waypoint )
+        if ( Data::view()->ownship.waypoint )
         {
-            if ( Data::get()->ownship.waypoint_dist < _distMax )
+            if ( Data::view()->ownship.waypoint_dist < _distMax )
             {
                 // current gate
                 _switch->setValue( 0, true );
 
-                _pat0->setPosition( Vec3( Data::get()->ownship.waypoint_x,
-                                          Data::get()->ownship.waypoint_y,
-                                          Data::get()->ownship.waypoint_z ) );
+                _pat0->setPosition( Vec3( Data::view()->ownship.waypoint_x,
+                                          Data::view()->ownship.waypoint_y,
+                                          Data::view()->ownship.waypoint_z ) );
 
-                float coef = Data::get()->ownship.waypoint_dist / _distScale;
+                float coef = Data::view()->ownship.waypoint_dist / _distScale;
 
                 if ( coef > 1.0f )
                 {
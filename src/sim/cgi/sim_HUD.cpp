@@ -17,19 +17,13 @@
 
 #include <sim/cgi/sim_HUD.h>
 
-#include <osg/LineWidth>
-#include <osg/Material>
-#include <osg/Point>
-
 #include <sim/sim_Captions.h>
 #include <sim/sim_Ownship.h>
 
 #include <sim/cgi/sim_Color.h>
 #include <sim/cgi/sim_Fonts.h>
 #include <sim/cgi/sim_Gates.h>
-#include <sim/cgi/sim_Geometry.h>
 #include <sim/cgi/sim_SplashScreen.h>
-#include <sim/cgi/sim_Textures.h>
 
 #include <sim/entities/sim_Entities.h>
 
@@ -63,6 +57,10 @@ HUD::HUD( float linesWidth, int width, int height ) :
 
     _maxX ( floor( 100.0f * (float)( _width ) / (float)( _height ) + 0.5f ) ),
 
+    _linesWidthHUD ( _linesWidth * 200.0f / (float)( _height ) ),
+
+    _batch ( NULLPTR ),
+
     _tutorial ( false ),
 
     _timerTutorial ( 0.0f )
@@ -81,12 +79,16 @@ HUD::HUD( float linesWidth, int width, int height ) :
     stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
     stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
 
-    _root->addChild( SplashScreen::create( width, height ) );
+    _splash = SplashScreen::create( width, height );
+    _root->addChild( _splash.get() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-HUD::~HUD() {}
+HUD::~HUD()
+{
+    DELPTR( _batch );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -94,15 +96,18 @@ void HUD::init( bool tutorial )
 {
     _tutorial = tutorial;
 
-    if ( _root->getNumChildren() > 0 )
+    // splash screen stays displayed while assets are being loaded
+    if ( _switch.valid() )
     {
-        _root->removeChildren( 0, _root->getNumChildren() );
+        _root->removeChild( _switch.get() );
     }
 
     _switch = new osg::Switch();
     _root->addChild( _switch.get() );
 
-    Fonts::reset();
+    DELPTR( _batch );
+    _batch = new HUDBatch();
+    _switch->addChild( _batch->getNode() );
 
     _font = Fonts::get( getPath( "fonts/fsg_stencil.ttf" ) );
 
@@ -110,7 +115,6 @@ void HUD::init( bool tutorial )
     createControls();
 #   endif
     createCrosshair();
-    createEnemyIndicators();
     createHitIndicator();
     createIndicators();
     createPlayerBar();
@@ -124,30 +128,44 @@ void HUD::init( bool tutorial )
     {
         createTutorialSymbols();
     }
+
+    _batch->build();
+
+    _switch->setAllChildrenOff();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void HUD::load() {}
+void HUD::load()
+{
+    if ( _splash.valid() )
+    {
+        _root->removeChild( _splash.get() );
+        _splash = 0;
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void HUD::update()
 {
-    if ( Data::get()->mission.status == Pending
-      && ( Data::get()->camera.type == ViewChase || Data::get()->camera.type == ViewPilot ) )
+    _batch->begin();
+
+    if ( Data::view()->mission.status == Pending
+      && ( Data::view()->camera.type == ViewChase || Data::view()->camera.type == ViewPilot ) )
     {
-        if ( !Data::get()->message.visible || !Data::get()->message.overlay )
+        if ( !Data::view()->message.visible || !Data::view()->message.overlay )
         {
             _switch->setAllChildrenOn();
 
+            // elements are written in drawing order
             updateControls();
-            updateCrosshair();
-            updateHitIndicator();
             updateIndicators();
+            updateHitIndicator();
             updatePlayerBar();
             updateTargetIndicators();
             updateWaypointIndicators();
+            updateCrosshair();
 
             if ( _tutorial )
             {
@@ -164,13 +182,15 @@ void HUD::update()
         _switch->setAllChildrenOff();
     }
 
+    _batch->end();
+
     updateCaption();
     updateMessage();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void HUD::createBox( osg::Geode *geode, osg::Vec4 color, float width )
+HUDBatch::Shape HUD::createBox( float width )
 {
     const float del = width / 2.0f;
 
@@ -180,11 +200,7 @@ void HUD::createBox( osg::Geode *geode, osg::Vec4 color, float width )
     const float w_2 = w / 2.0f;
     const float h_2 = h / 2.0f;
 
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
     osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
 
     v->push_back( osg::Vec3( -w_2 + del, -h_2 + del, -1.0f ) );
     v->push_back( osg::Vec3( -w_2 - del, -h_2 - del, -1.0f ) );
@@ -201,28 +217,7 @@ void HUD::createBox( osg::Geode *geode, osg::Vec4 color, float width )
     v->push_back( osg::Vec3( -w_2 + del, -h_2 + del, -1.0f ) );
     v->push_back( osg::Vec3( -w_2 - del, -h_2 - del, -1.0f ) );
 
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-    c->push_back( color );
-
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_STRIP, 0, v->size() ) );
-
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-    geode->addDrawable( geometry.get() );
-
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-    stateSet->setMode( GL_BLEND      , osg::StateAttribute::OVERRIDE | osg::StateAttribute::ON  );
-    stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
-
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
+    return HUDBatch::createStrip( v.get() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -271,11 +266,6 @@ void HUD::createCaption()
 #ifndef SIM_DESKTOP
 void HUD::createControls()
 {
-    // material
-    _materialControls = new osg::Material();
-    _materialControls->setAmbient( osg::Material::FRONT_AND_BACK, osg::Vec4( Color::white, 0.4f ) );
-    _materialControls->setDiffuse( osg::Material::FRONT_AND_BACK, osg::Vec4( Color::white, 0.4f ) );
-
     createControlsThrottle();
     createControlsTrigger();
 }
@@ -284,16 +274,6 @@ void HUD::createControls()
 
 void HUD::createControlsThrottle()
 {
-    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-    _switch->addChild( pat.get() );
-
-    _patControlsThrottle = new osg::PositionAttitudeTransform();
-    pat->addChild( _patControlsThrottle.get() );
-
-    pat->setPosition( osg::Vec3( -_maxX, 10.0, 0.0 ) );
-
-    createControlsThrottleGrip( _patControlsThrottle.get(), 0.4f );
-
     // base
     {
         const float w  =  10.0f;
@@ -301,174 +281,47 @@ void HUD::createControlsThrottle()
 
         const float h_2 = h / 2.0f;
 
-        osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-        pat->addChild( geode.get() );
-
-        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
         osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-        osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-        osg::ref_ptr<osg::Vec2Array> t = new osg::Vec2Array();  // colors
 
         v->push_back( osg::Vec3( 0.0f, -h_2, -1.0f ) );
         v->push_back( osg::Vec3(    w, -h_2, -1.0f ) );
         v->push_back( osg::Vec3(    w,  h_2, -1.0f ) );
         v->push_back( osg::Vec3( 0.0f,  h_2, -1.0f ) );
 
-        t->push_back( osg::Vec2( 0.0, 0.0 ) );
-        t->push_back( osg::Vec2( 1.0, 0.0 ) );
-        t->push_back( osg::Vec2( 1.0, 1.0 ) );
-        t->push_back( osg::Vec2( 0.0, 1.0 ) );
-
-        n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-        c->push_back( osg::Vec4( Color::white, 0.4f ) );
-
-        geometry->setVertexArray( v.get() );
-        geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_FAN, 0, v->size() ) );
-
-        geometry->setNormalArray( n.get() );
-        geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-        geometry->setColorArray( c.get() );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-        geometry->setTexCoordArray( 0, t.get() );
-
-        osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-        stateSet->setAttribute( _materialControls.get() );
-        stateSet->setMode( GL_BLEND, osg::StateAttribute::ON );
-        stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-        stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
-        stateSet->setTextureAttributeAndModes( 0, Textures::get( getPath( "textures/hud_throttle_base.rgb" ) ), osg::StateAttribute::ON );
-
-        geode->addDrawable( geometry.get() );
+        _shapeThrottleBase = HUDBatch::createFan( v.get(), _batch->addTexture( getPath( "textures/hud_throttle_base.rgb" ) ) );
     }
 
-    // pointer
-    if ( _tutorial )
+    // grip
     {
-        _switchPointerRpm = new osg::Switch();
-        pat->addChild( _switchPointerRpm.get() );
+        const float w  = 40.0f;
+        const float h  = 20.0f;
+        const float dx = 10.0f;
 
-        _patPointerRpm = new osg::PositionAttitudeTransform();
-        _switchPointerRpm->addChild( _patPointerRpm.get() );
-
-        createControlsThrottleGrip( _patPointerRpm.get(), 0.2f, -1.0f );
-
-        osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-        _patPointerRpm->addChild( pat.get() );
+        const float h_2 = h / 2.0f;
 
-        createPointer( pat.get() );
+        osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
 
-        pat->setAttitude( osg::Quat( M_PI_2, osg::Z_AXIS ) );
-        pat->setPosition( osg::Vec3( 52.0f, 0.0f, 0.0f ) );
+        v->push_back( osg::Vec3( dx     , -h_2, -1.0f ) ); // 1
+        v->push_back( osg::Vec3( dx     ,  h_2, -1.0f ) ); // 2
+        v->push_back( osg::Vec3( dx + w ,  h_2, -1.0f ) ); // 3
+        v->push_back( osg::Vec3( dx + w , -h_2, -1.0f ) ); // 3
 
-        _switchPointerRpm->setAllChildrenOff();
+        _shapeThrottleGrip = HUDBatch::createFan( v.get(), _batch->addTexture( getPath( "textures/hud_throttle_grip.rgb" ) ) );
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void HUD::createControlsThrottleGrip( osg::Group *parent, float alpha, float z_offset )
-{
-    const float w  = 40.0f;
-    const float h  = 20.0f;
-    const float dx = 10.0f;
-
-    const float h_2 = h / 2.0f;
-
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    parent->addChild( geode.get() );
-
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
-    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-    osg::ref_ptr<osg::Vec2Array> t = new osg::Vec2Array();  // colors
-
-    v->push_back( osg::Vec3( dx     , -h_2, -1.0f + z_offset ) ); // 1
-    v->push_back( osg::Vec3( dx     ,  h_2, -1.0f + z_offset ) ); // 2
-    v->push_back( osg::Vec3( dx + w ,  h_2, -1.0f + z_offset ) ); // 3
-    v->push_back( osg::Vec3( dx + w , -h_2, -1.0f + z_offset ) ); // 3
-
-    t->push_back( osg::Vec2( 0, 0 ) ); // 1
-    t->push_back( osg::Vec2( 0, 1 ) ); // 2
-    t->push_back( osg::Vec2( 1, 1 ) ); // 3
-    t->push_back( osg::Vec2( 1, 0 ) ); // 3
-
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-    c->push_back( osg::Vec4( Color::white, alpha ) );
-
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_FAN, 0, v->size() ) );
-
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setTexCoordArray( 0, t.get() );
-
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-    stateSet->setAttribute( _materialControls.get() );
-    stateSet->setMode( GL_BLEND, osg::StateAttribute::ON );
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD + (int)z_offset, "RenderBin" );
-    stateSet->setTextureAttributeAndModes( 0, Textures::get( getPath( "textures/hud_throttle_grip.rgb" ) ), osg::StateAttribute::ON );
-
-    geode->addDrawable( geometry.get() );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 void HUD::createControlsTrigger()
 {
-    const float r  = 25.0f;
-    const float dx =  5.0f;
-
-    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-    _switch->addChild( pat.get() );
-
-    pat->setPosition( osg::Vec3( _maxX - dx - r, 0.0, 0.0 ) );
-
-    _switchTrigger = new osg::Switch();
-    pat->addChild( _switchTrigger.get() );
+    const float r = 25.0f;
 
-    createFace( _switchTrigger.get(), r, _materialControls.get(), "textures/hud_trigger_0.rgb", 0.4f );
-    createFace( _switchTrigger.get(), r, _materialControls.get(), "textures/hud_trigger_1.rgb", 0.4f );
-
-    _switchTrigger->setSingleChildOn( 0 );
+    _shapeTrigger[ 0 ] = createFace( r, _batch->addTexture( getPath( "textures/hud_trigger_0.rgb" ) ) );
+    _shapeTrigger[ 1 ] = createFace( r, _batch->addTexture( getPath( "textures/hud_trigger_1.rgb" ) ) );
 
     if ( _tutorial )
     {
-        _switchPointerTrigger = new osg::Switch();
-        pat->addChild( _switchPointerTrigger.get() );
-
-        osg::ref_ptr<osg::PositionAttitudeTransform> patPointer = new osg::PositionAttitudeTransform();
-
-        _switchPointerTrigger->addChild( patPointer.get() );
-
-        patPointer->setPosition( osg::Vec3( -33.0f, 0.0f, 0.0f ) );
-        patPointer->setAttitude( osg::Quat( -M_PI_2, osg::Z_AXIS ) );
-
-        createPointer( patPointer.get() );
-
-        osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-        _switchPointerTrigger->addChild( geode.get() );
-
-        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-        geode->addDrawable( geometry.get() );
-
         osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-        osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
 
         const float w = 4.0f;
 
@@ -489,20 +342,7 @@ void HUD::createControlsTrigger()
             v->push_back( osg::Vec3( xo, yo, -1.0f ) );
         }
 
-        n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-        c->push_back( osg::Vec4( Color::lime, 1.0f ) );
-
-        geometry->setVertexArray( v.get() );
-        geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_STRIP, 0, v->size() ) );
-
-        geometry->setNormalArray( n.get() );
-        geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-        geometry->setColorArray( c.get() );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-        _switchPointerTrigger->setAllChildrenOff();
+        _shapeTriggerRing = HUDBatch::createStrip( v.get() );
     }
 }
 #endif
@@ -513,58 +353,19 @@ void HUD::createCrosshair()
 {
     const float r = 10.0f;
 
-    _patCrosshair = new osg::PositionAttitudeTransform();
-    _switch->addChild( _patCrosshair.get() );
-
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    _patCrosshair->addChild( geode.get() );
-
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
     osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-    osg::ref_ptr<osg::Vec2Array> t = new osg::Vec2Array();  // colors
 
     v->push_back( osg::Vec3( -r, -r, -1.0f ) );
     v->push_back( osg::Vec3(  r, -r, -1.0f ) );
     v->push_back( osg::Vec3(  r,  r, -1.0f ) );
     v->push_back( osg::Vec3( -r,  r, -1.0f ) );
 
-    t->push_back( osg::Vec2( 0.0, 0.0 ) );
-    t->push_back( osg::Vec2( 1.0, 0.0 ) );
-    t->push_back( osg::Vec2( 1.0, 1.0 ) );
-    t->push_back( osg::Vec2( 0.0, 1.0 ) );
-
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-    c->push_back( osg::Vec4( Color::white, 1.0f ) );
-
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_FAN, 0, v->size() ) );
-
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setTexCoordArray( 0, t.get() );
-
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-    stateSet->setAttribute( _materialIndicators.get() );
-    stateSet->setMode( GL_BLEND, osg::StateAttribute::ON );
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD + 1, "RenderBin" );
-    stateSet->setTextureAttributeAndModes( 0, Textures::get( getPath( "textures/hud_crosshair.rgb" ) ), osg::StateAttribute::ON );
-
-    geode->addDrawable( geometry.get() );
+    _shapeCrosshair = HUDBatch::createFan( v.get(), _batch->addTexture( getPath( "textures/hud_crosshair.rgb" ) ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void HUD::createDir( osg::Geode *geode, osg::Vec4 color )
+HUDBatch::Shape HUD::createDir()
 {
     const float y = 70.0f;
     const float w =  6.0f;
@@ -573,39 +374,14 @@ void HUD::createDir( osg::Geode *geode, osg::Vec4 color )
 
     const float w_2 = w / 2.0f;
 
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
     osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
 
     v->push_back( osg::Vec3( 0.0f, y - d, -1.0f ) ); // 1
     v->push_back( osg::Vec3(  w_2, y - h, -1.0f ) ); // 2
     v->push_back( osg::Vec3( 0.0f, y    , -1.0f ) ); // 3
     v->push_back( osg::Vec3( -w_2, y - h, -1.0f ) ); // 4
 
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-    c->push_back( color );
-
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_FAN, 0, v->size() ) );
-
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-    geode->addDrawable( geometry.get() );
-
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-    stateSet->setMode( GL_BLEND      , osg::StateAttribute::OVERRIDE | osg::StateAttribute::ON  );
-    stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
-
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
+    return HUDBatch::createFan( v.get() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -618,26 +394,11 @@ void HUD::createHitIndicator()
     const float a_min = -osg::DegreesToRadians( 30.0f );
     const float a_max =  osg::DegreesToRadians( 30.0f );
 
-//    const float a_min = -osg::DegreesToRadians( 180.0f );
-//    const float a_max =  osg::DegreesToRadians( 180.0f );
-
     const int steps = 8;
 
     const float step = ( a_max - a_min ) / ( steps - 1 );
 
-    _patHitIndicator = new osg::PositionAttitudeTransform();
-    _switch->addChild( _patHitIndicator.get() );
-
-    _patHitIndicator->setPosition( osg::Vec3( 0.0f, -40.0f, 0.0f ) );
-
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    _patHitIndicator->addChild( geode.get() );
-
-    _hitIndicator = new osg::Geometry();
-    geode->addDrawable( _hitIndicator.get() );
-
     osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
     osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
 
     for ( int i = 0 ; i < steps; i++ )
@@ -652,307 +413,85 @@ void HUD::createHitIndicator()
         v->push_back( osg::Vec3( xi, yi, -3.0f ) );
         v->push_back( osg::Vec3( xo, yo, -3.0f ) );
 
-        c->push_back( osg::Vec4( Color::red, 0.0f ) );
-        c->push_back( osg::Vec4( Color::red, 0.0f ) );
+        // inner edge is transparent
+        c->push_back( osg::Vec4( 1.0f, 1.0f, 1.0f, 0.0f ) );
+        c->push_back( osg::Vec4( 1.0f, 1.0f, 1.0f, 1.0f ) );
     }
 
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-    _hitIndicator->setVertexArray( v.get() );
-    _hitIndicator->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_STRIP, 0, v->size() ) );
-
-    _hitIndicator->setColorArray( c.get() );
-    _hitIndicator->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
-
-    _hitIndicator->setNormalArray( n.get() );
-    _hitIndicator->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-    stateSet->setMode( GL_BLEND      , osg::StateAttribute::OVERRIDE | osg::StateAttribute::ON  );
-    stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
-
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
+    _shapeHitIndicator = HUDBatch::createStrip( v.get(), c.get() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void HUD::createEnemyIndicators()
+HUDBatch::Shape HUD::createFace( float radius, int texture )
 {
-    _switchEnemyIndicators = new osg::Switch();
-    _switch->addChild( _switchEnemyIndicators.get() );
-
-    osg::ref_ptr< osg::Geode > geodeBox = new osg::Geode();
-    osg::ref_ptr< osg::Geode > geodeDir = new osg::Geode();
-
-    createBox( geodeBox.get(), osg::Vec4( Color::red, 0.7f ), 0.5f );
-    createDir( geodeDir.get(), osg::Vec4( Color::red, 0.7f ) );
-
-    for ( UInt16 i = 0; i < _maxRadarMarks; i++ )
-    {
-        osg::ref_ptr<osg::PositionAttitudeTransform> patEnemyBox = new osg::PositionAttitudeTransform();
-        _switchEnemyIndicators->addChild( patEnemyBox.get() );
-
-        _patEnemyBox.push_back( patEnemyBox.get() );
-
-        osg::ref_ptr<osg::PositionAttitudeTransform> patEnemyDir = new osg::PositionAttitudeTransform();
-        _switchEnemyIndicators->addChild( patEnemyDir.get() );
-
-        _patEnemyDir.push_back( patEnemyDir.get() );
-
-        patEnemyBox->addChild( geodeBox );
-        patEnemyDir->addChild( geodeDir );
-    }
-
-    _switchEnemyIndicators->setAllChildrenOff();
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void HUD::createFace( osg::Group *parent, float radius,
-                      osg::Material *material,
-                      const std::string &textureFile,
-                      float alpha )
-{
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    parent->addChild( geode.get() );
-
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-    geode->addDrawable( geometry.get() );
-
     osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec2Array> t = new osg::Vec2Array();  // texture
 
     float a_deg = 0.0f;
     float a_rad = osg::DegreesToRadians( a_deg );
 
     while ( a_deg < 360.0 )
     {
-        float x_n = sin( a_rad );
-        float y_n = cos( a_rad );
-
-        float x = radius * x_n;
-        float y = radius * y_n;
+        float x = radius * sin( a_rad );
+        float y = radius * cos( a_rad );
 
         v->push_back( osg::Vec3( x, y, -2.0f ) );
-        t->push_back( osg::Vec2( ( 1.0f + x_n ) / 2.0f, ( 1.0f + y_n ) / 2.0f ) );
 
         a_deg += 10.0f;
         a_rad = osg::DegreesToRadians( a_deg );
     }
 
-    n->push_back( osg::Vec3( 0.0f, 0.0f,  1.0f ) );
-
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_FAN, 0, v->size() ) );
-
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    if ( 1 )
-    {
-        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();
-
-        c->push_back( osg::Vec4( Color::white, alpha ) );
-
-        geometry->setColorArray( c.get() );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-    }
-
-    geometry->setTexCoordArray( 0, t.get() );
-
-    osg::ref_ptr<osg::StateSet> stateSet = geometry->getOrCreateStateSet();
-
-    stateSet->setAttribute( material );
-    stateSet->setMode( GL_BLEND, osg::StateAttribute::ON );
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
-    stateSet->setTextureAttributeAndModes( 0, Textures::get( getPath( textureFile ) ), osg::StateAttribute::ON );
+    return HUDBatch::createFan( v.get(), texture );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void HUD::createIndicators()
 {
-    _geodeRadarMarkEnemy  = new osg::Geode();
-    _geodeRadarMarkFriend = new osg::Geode();
-
-    createRadarMark( _geodeRadarMarkEnemy.get()  , osg::Vec4( Color::red  , 1.0f ) );
-    createRadarMark( _geodeRadarMarkFriend.get() , osg::Vec4( Color::lime , 1.0f ) );
-
-    // material
-    _materialIndicators = new osg::Material();
-    _materialIndicators->setAmbient( osg::Material::FRONT_AND_BACK, osg::Vec4( Color::white, 0.7f ) );
-    _materialIndicators->setDiffuse( osg::Material::FRONT_AND_BACK, osg::Vec4( Color::white, 0.7f ) );
-
-    createIndicatorALT();
-    createIndicatorASI();
-    createIndicatorRadar();
-    createIndicatorVSI();
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void HUD::createIndicatorHand( osg::Group *parent, float l, float w )
-{
-    const float w_2 = w / 2.0f;
-
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    parent->addChild( geode.get() );
-
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-    geode->addDrawable( geometry.get() );
-
-    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-    v->push_back( osg::Vec3( 0.0f,     0.0f, -1.0f ) );
-    v->push_back( osg::Vec3(  w_2, l * 0.6f, -1.0f ) );
-    v->push_back( osg::Vec3( -w_2, l * 0.6f, -1.0f ) );
-    v->push_back( osg::Vec3( -w_2, l * 0.6f, -1.0f ) );
-    v->push_back( osg::Vec3(  w_2, l * 0.6f, -1.0f ) );
-    v->push_back( osg::Vec3( 0.0f,        l, -1.0f ) );
-
-    n->push_back( osg::Vec3( 0.0f, 0.0f,  1.0f ) );
-    c->push_back( osg::Vec4( Color::white, 1.0f ) );
-
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLES, 0, v->size() ) );
-
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void HUD::createIndicatorALT()
-{
-    const float x =  86.0f;
-    const float y = -75.0f;
-    const float r =  20.0f;
-
-    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-    _switch->addChild( pat.get() );
-
-    pat->setPosition( osg::Vec3( x, y, -1.0f ) );
-
-    createFace( pat.get(), r, _materialIndicators.get(), "textures/hud_altitude.rgb", 0.7f );
-
-    _patIndicatorALT1 = new osg::PositionAttitudeTransform();
-    _patIndicatorALT2 = new osg::PositionAttitudeTransform();
-
-    pat->addChild( _patIndicatorALT1.get() );
-    pat->addChild( _patIndicatorALT2.get() );
-
-    // arrow 1
+    // radar mark
     {
-        const float l = 10.0f;
-        const float w =  2.5f;
+        const float w_2 = _linesWidthHUD / 2.0f;
 
-        createIndicatorHand( _patIndicatorALT1.get(), l, w );
-    }
+        osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
 
-    // arrow 2
-    {
-        const float l = 15.0f;
-        const float w =  1.5f;
+        v->push_back( osg::Vec3( -w_2, -w_2, -1.0f ) );
+        v->push_back( osg::Vec3(  w_2, -w_2, -1.0f ) );
+        v->push_back( osg::Vec3(  w_2,  w_2, -1.0f ) );
+        v->push_back( osg::Vec3( -w_2,  w_2, -1.0f ) );
 
-        createIndicatorHand( _patIndicatorALT2.get(), l, w );
+        _shapeRadarMark = HUDBatch::createFan( v.get() );
     }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void HUD::createIndicatorASI()
-{
-    const float x = -47.0f;
-    const float y = -80.0f;
-    const float r =  15.0f;
-
-    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-    _switch->addChild( pat.get() );
-
-    pat->setPosition( osg::Vec3( x, y, -1.0f ) );
-
-    createFace( pat.get(), r, _materialIndicators.get(), "textures/hud_airspeed.rgb", 0.7f );
-
-    _patIndicatorASI = new osg::PositionAttitudeTransform();
-    pat->addChild( _patIndicatorASI.get() );
-
-    const float l = 11.0f;
-    const float w =  1.5f;
-
-    createIndicatorHand( _patIndicatorASI.get(), l, w );
-}
-
-////////////////////////////////////////////////////////////////////////////////
 
-void HUD::createIndicatorRadar()
-{
-    const float x = -86.0f;
-    const float y = -75.0f;
-    const float r =  20.0f;
-
-    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-    _switch->addChild( pat.get() );
-
-    pat->setPosition( osg::Vec3( x, y, -1.0f ) );
-
-    _patIndicatorRadar = new osg::PositionAttitudeTransform();
-    pat->addChild( _patIndicatorRadar.get() );
-
-    _switchRadarMarksEnemy  = new osg::Switch();
-    _switchRadarMarksFriend = new osg::Switch();
-
-    _patIndicatorRadar->addChild( _switchRadarMarksEnemy.get() );
-    _patIndicatorRadar->addChild( _switchRadarMarksFriend.get() );
-
-    for ( UInt16 i = 0; i < _maxRadarMarks; i++ )
-    {
-        osg::ref_ptr<osg::PositionAttitudeTransform> patE = new osg::PositionAttitudeTransform();
-        osg::ref_ptr<osg::PositionAttitudeTransform> patF = new osg::PositionAttitudeTransform();
+    _shapeEnemyBox = createBox( 0.5f );
+    _shapeDir = createDir();
 
-        _switchRadarMarksEnemy  ->addChild( patE.get() );
-        _switchRadarMarksFriend ->addChild( patF.get() );
+    _shapeFaceALT   = createFace( 20.0f, _batch->addTexture( getPath( "textures/hud_altitude.rgb"   ) ) );
+    _shapeFaceASI   = createFace( 15.0f, _batch->addTexture( getPath( "textures/hud_airspeed.rgb"   ) ) );
+    _shapeFaceRadar = createFace( 20.0f, _batch->addTexture( getPath( "textures/hud_radar.rgb"      ) ) );
+    _shapeFaceVSI   = createFace( 15.0f, _batch->addTexture( getPath( "textures/hud_climb_rate.rgb" ) ) );
 
-        patE->addChild( _geodeRadarMarkEnemy.get() );
-        patF->addChild( _geodeRadarMarkFriend.get() );
-
-        _patRadarMarksEnemy.push_back( patE.get() );
-        _patRadarMarksFriend.push_back( patF.get() );
-    }
-
-    createFace( pat.get(), r, _materialIndicators.get(), "textures/hud_radar.rgb", 0.7f );
+    _shapeHandALT1 = createIndicatorHand( 10.0f, 2.5f );
+    _shapeHandALT2 = createIndicatorHand( 15.0f, 1.5f );
+    _shapeHandASI  = createIndicatorHand( 11.0f, 1.5f );
+    _shapeHandVSI  = createIndicatorHand( 11.0f, 1.5f );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void HUD::createIndicatorVSI()
+HUDBatch::Shape HUD::createIndicatorHand( float l, float w )
 {
-    const float x =  47.0f;
-    const float y = -80.0f;
-    const float r =  15.0f;
-
-    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-    _switch->addChild( pat.get() );
-
-    pat->setPosition( osg::Vec3( x, y, -1.0f ) );
-
-    createFace( pat.get(), r, _materialIndicators.get(), "textures/hud_climb_rate.rgb", 0.7f );
+    const float w_2 = w / 2.0f;
 
-    _patIndicatorVSI = new osg::PositionAttitudeTransform();
-    pat->addChild( _patIndicatorVSI.get() );
+    HUDBatch::Shape shape;
 
-    const float l = 11.0f;
-    const float w =  1.5f;
+    shape.v.push_back( osg::Vec3( 0.0f,     0.0f, -1.0f ) );
+    shape.v.push_back( osg::Vec3(  w_2, l * 0.6f, -1.0f ) );
+    shape.v.push_back( osg::Vec3( -w_2, l * 0.6f, -1.0f ) );
+    shape.v.push_back( osg::Vec3( -w_2, l * 0.6f, -1.0f ) );
+    shape.v.push_back( osg::Vec3(  w_2, l * 0.6f, -1.0f ) );
+    shape.v.push_back( osg::Vec3( 0.0f,        l, -1.0f ) );
 
-    createIndicatorHand( _patIndicatorVSI.get(), l, w );
+    return shape;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1094,9 +633,6 @@ void HUD::createMessage()
 
 void HUD::createPlayerBar()
 {
-    _patPlayerBar = new osg::PositionAttitudeTransform();
-    _switch->addChild( _patPlayerBar.get() );
-
     const float del = 1.0f;
 
     const float w = 120.0f;
@@ -1108,14 +644,7 @@ void HUD::createPlayerBar()
 
     // box
     {
-        osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-        _switch->addChild( geode.get() );
-
-        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
         osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-        osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
 
         v->push_back( osg::Vec3( -w_2, -h_2 + d, -1.0f ) );
         v->push_back( osg::Vec3( -w_2 - del, -h_2 + d - del, -1.0f ) );
@@ -1132,32 +661,12 @@ void HUD::createPlayerBar()
         v->push_back( osg::Vec3( -w_2, -h_2 + d, -1.0f ) );
         v->push_back( osg::Vec3( -w_2 - del, -h_2 + d - del, -1.0f ) );
 
-        n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-        c->push_back( osg::Vec4( Color::black, 1.0f ) );
-
-        geometry->setVertexArray( v.get() );
-        geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_STRIP, 0, v->size() ) );
-
-        geometry->setNormalArray( n.get() );
-        geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-        geometry->setColorArray( c.get() );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-        geode->addDrawable( geometry.get() );
+        _shapePlayerBarBox = HUDBatch::createStrip( v.get() );
     }
 
     // bar
     {
-        osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-        _patPlayerBar->addChild( geode.get() );
-
-        //osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-        _playerLifeBar = new osg::Geometry();
-
         osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-        osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
         osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
 
         v->push_back( osg::Vec3( -w_2, -h_2 + d, -2.0f ) ); // 4
@@ -1165,37 +674,20 @@ void HUD::createPlayerBar()
         v->push_back( osg::Vec3(  w_2,  h_2 + d, -2.0f ) ); // 2
         v->push_back( osg::Vec3(  w_2, -h_2 + d, -2.0f ) ); // 3
 
+        // lower edge is half as bright as upper one
+        osg::Vec4 upper( 1.0f, 1.0f, 1.0f, 1.0f );
+        osg::Vec4 lower( 0.5f, 0.5f, 0.5f, 1.0f );
 
-        n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-        osg::Vec3f upper = Color::lime;
-        osg::Vec3f lower = Color::lime * 0.5f;
-
-        c->push_back( osg::Vec4( lower, 1.0f ) );
-        c->push_back( osg::Vec4( upper, 1.0f ) );
-        c->push_back( osg::Vec4( upper, 1.0f ) );
-        c->push_back( osg::Vec4( lower, 1.0f ) );
-
-        _playerLifeBar->setVertexArray( v.get() );
-        _playerLifeBar->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::QUADS, 0, v->size() ) );
-
-        _playerLifeBar->setNormalArray( n.get() );
-        _playerLifeBar->setNormalBinding( osg::Geometry::BIND_OVERALL );
+        c->push_back( lower );
+        c->push_back( upper );
+        c->push_back( upper );
+        c->push_back( lower );
 
-//        _playerLifeBar->setColorArray( c.get() );
-//        _playerLifeBar->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-        _playerLifeBar->setColorArray( c.get() );
-        _playerLifeBar->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
-
-        geode->addDrawable( _playerLifeBar.get() );
+        _shapePlayerBar = HUDBatch::createFan( v.get(), -1, c.get() );
     }
 
     // heart
     {
-        osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-        _switch->addChild( geode.get() );
-
         const float hh = 10.0f;
         const float ww = 10.0f;
 
@@ -1204,47 +696,14 @@ void HUD::createPlayerBar()
 
         const float dy = -w_2 - 4.0f - ww_2;
 
-        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
         osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-        osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-        osg::ref_ptr<osg::Vec2Array> t = new osg::Vec2Array();  // tex coords
 
         v->push_back( osg::Vec3( -ww_2 + dy, -hh_2 + d, -1.0f ) );
         v->push_back( osg::Vec3(  ww_2 + dy, -hh_2 + d, -1.0f ) );
         v->push_back( osg::Vec3(  ww_2 + dy,  hh_2 + d, -1.0f ) );
         v->push_back( osg::Vec3( -ww_2 + dy,  hh_2 + d, -1.0f ) );
 
-        t->push_back( osg::Vec2( 0, 0 ) );
-        t->push_back( osg::Vec2( 1, 0 ) );
-        t->push_back( osg::Vec2( 1, 1 ) );
-        t->push_back( osg::Vec2( 0, 1 ) );
-
-        n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-        c->push_back( osg::Vec4( Color::white, 1.0f ) );
-
-        geometry->setVertexArray( v.get() );
-        geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_FAN, 0, v->size() ) );
-
-        geometry->setNormalArray( n.get() );
-        geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-        geometry->setColorArray( c.get() );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-        geometry->setTexCoordArray( 0, t.get() );
-
-        osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-        stateSet->setAttribute( _materialIndicators.get() );
-        stateSet->setMode( GL_BLEND, osg::StateAttribute::ON );
-        stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-        stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD + 1, "RenderBin" );
-        stateSet->setTextureAttributeAndModes( 0, Textures::get( getPath( "textures/hud_heart.rgb" ) ), osg::StateAttribute::ON );
-
-        geode->addDrawable( geometry.get() );
+        _shapePlayerHeart = HUDBatch::createFan( v.get(), _batch->addTexture( getPath( "textures/hud_heart.rgb" ) ) );
     }
 
     // text - right
@@ -1269,11 +728,8 @@ void HUD::createPlayerBar()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void HUD::createPointer( osg::Group *parent )
+HUDBatch::Shape HUD::createPointer()
 {
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    parent->addChild( geode.get() );
-
     const float h  = 24.0f;
     const float wh = 12.0f;
     const float ws =  6.0f;
@@ -1282,337 +738,99 @@ void HUD::createPointer( osg::Group *parent )
     const float wh_2 = wh / 2.0f;
     const float ws_2 = ws / 2.0f;
 
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
     osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-    v->push_back( osg::Vec3(  0.0f, 0.0f, 0.0f ) ); // 1
-    v->push_back( osg::Vec3( -wh_2, -h_2, 0.0f ) ); // 2
-    v->push_back( osg::Vec3( -ws_2, -h_2, 0.0f ) ); // 3
-    v->push_back( osg::Vec3( -ws_2,   -h, 0.0f ) ); // 4
-    v->push_back( osg::Vec3(  ws_2,   -h, 0.0f ) ); // 5
-    v->push_back( osg::Vec3(  ws_2, -h_2, 0.0f ) ); // 6
-    v->push_back( osg::Vec3(  wh_2, -h_2, 0.0f ) ); // 7
-
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-    //c->push_back( osg::Vec4( Color::lime, 0.8f ) );
-    c->push_back( osg::Vec4( Color::lime, 1.0f ) );
-
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_FAN, 0, v->size() ) );
-
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-    geode->addDrawable( geometry.get() );
-
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-    stateSet->setMode( GL_BLEND      , osg::StateAttribute::OVERRIDE | osg::StateAttribute::ON  );
-    stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
-
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void HUD::createRadarMark( osg::Geode *geode, osg::Vec4 color )
-{
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-    geode->addDrawable( geometry.get() );
-
-    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-    v->push_back( osg::Vec3( 0.0f, 0.0f, -1.0f ) );
-    n->push_back( osg::Vec3( 0.0f, 0.0f,  1.0f ) );
-    c->push_back( color );
-
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::POINTS, 0, v->size() ) );
-
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-    geode->setInitialBound( osg::BoundingSphere( osg::Vec3(0.0f,0.0f,0.0f), _linesWidth ) );
-
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-    osg::ref_ptr<osg::Point> point = new osg::Point();
-    point->setSize( _linesWidth );
-
-    stateSet->setAttribute( point );
-//    stateSet->setMode( GL_BLEND, osg::StateAttribute::ON );
-//    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void HUD::createTargetIndicators()
-{
-    _switchTargetIndicators = new osg::Switch();
-    _switch->addChild( _switchTargetIndicators.get() );
-
-    _patTargetBox = new osg::PositionAttitudeTransform();
-    _switchTargetIndicators->addChild( _patTargetBox.get() );
-
-    _patTargetBar = new osg::PositionAttitudeTransform();
-    _patTargetBox->addChild( _patTargetBar.get() );
-
-    _patTargetCue = new osg::PositionAttitudeTransform();
-    _switchTargetIndicators->addChild( _patTargetCue.get() );
-
-    _patTargetDir = new osg::PositionAttitudeTransform();
-    _switchTargetIndicators->addChild( _patTargetDir.get() );
-
-    createTargetIndicatorBar();
-    createTargetIndicatorBox();
-    createTargetIndicatorCue();
-    createTargetIndicatorDir();
-
-    _switchTargetIndicators->setAllChildrenOff();
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void HUD::createTargetIndicatorBar()
-{
-    const float del = 1.0f / 2.0f;
-
-    const float w = 10.0f;
-    const float h =  2.0f;
-    const float d =  8.0f;
-
-    const float w_2 = w / 2.0f;
-    const float h_2 = h / 2.0f;
-
-    // box
-    {
-        osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-        _patTargetBox->addChild( geode.get() );
-
-        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
-        osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-        osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-        v->push_back( osg::Vec3( -w_2, -h_2 + d, -1.0f ) );
-        v->push_back( osg::Vec3( -w_2 - del, -h_2 + d - del, -1.0f ) );
-
-        v->push_back( osg::Vec3( -w_2,  h_2 + d, -1.0f ) );
-        v->push_back( osg::Vec3( -w_2 - del,  h_2 + d + del, -1.0f ) );
-
-        v->push_back( osg::Vec3(  w_2,  h_2 + d, -1.0f ) );
-        v->push_back( osg::Vec3(  w_2 + del,  h_2 + d + del, -1.0f ) );
-
-        v->push_back( osg::Vec3(  w_2, -h_2 + d, -1.0f ) );
-        v->push_back( osg::Vec3(  w_2 + del, -h_2 + d - del, -1.0f ) );
-
-        v->push_back( osg::Vec3( -w_2, -h_2 + d, -1.0f ) );
-        v->push_back( osg::Vec3( -w_2 - del, -h_2 + d - del, -1.0f ) );
-
-        n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-        c->push_back( osg::Vec4( Color::black, 1.0f ) );
-
-        geometry->setVertexArray( v.get() );
-        geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_STRIP, 0, v->size() ) );
-
-        geometry->setNormalArray( n.get() );
-        geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-        geometry->setColorArray( c.get() );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-        geode->addDrawable( geometry.get() );
-
-        osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-        //stateSet->setMode( GL_BLEND      , osg::StateAttribute::OVERRIDE | osg::StateAttribute::ON  );
-        stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
-
-        stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-        stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
-    }
-
-    // bar
-    {
-        osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-        _patTargetBar->addChild( geode.get() );
-
-        //osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-        _targetLifeBar = new osg::Geometry();
-
-        osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-        osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-        v->push_back( osg::Vec3( -w_2, -h_2 + d, -2.0f ) ); // 4
-        v->push_back( osg::Vec3( -w_2,  h_2 + d, -2.0f ) ); // 1
-        v->push_back( osg::Vec3(  w_2,  h_2 + d, -2.0f ) ); // 2
-        v->push_back( osg::Vec3(  w_2, -h_2 + d, -2.0f ) ); // 3
-
-
-        n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-        c->push_back( osg::Vec4( Color::lime, 1.0f ) );
-
-        _targetLifeBar->setVertexArray( v.get() );
-        _targetLifeBar->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::QUADS, 0, v->size() ) );
-
-        _targetLifeBar->setNormalArray( n.get() );
-        _targetLifeBar->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-        _targetLifeBar->setColorArray( c.get() );
-        _targetLifeBar->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-        geode->addDrawable( _targetLifeBar.get() );
-
-        osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-        //stateSet->setMode( GL_BLEND      , osg::StateAttribute::OVERRIDE | osg::StateAttribute::ON  );
-        stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
-
-        stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-        stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
 
-void HUD::createTargetIndicatorBox()
-{
-    osg::ref_ptr< osg::Geode > geode = new osg::Geode();
-    _patTargetBox->addChild( geode.get() );
+    v->push_back( osg::Vec3(  0.0f, 0.0f, 0.0f ) ); // 1
+    v->push_back( osg::Vec3( -wh_2, -h_2, 0.0f ) ); // 2
+    v->push_back( osg::Vec3( -ws_2, -h_2, 0.0f ) ); // 3
+    v->push_back( osg::Vec3( -ws_2,   -h, 0.0f ) ); // 4
+    v->push_back( osg::Vec3(  ws_2,   -h, 0.0f ) ); // 5
+    v->push_back( osg::Vec3(  ws_2, -h_2, 0.0f ) ); // 6
+    v->push_back( osg::Vec3(  wh_2, -h_2, 0.0f ) ); // 7
 
-    createBox( geode.get(), osg::Vec4( Color::red, 0.7f ) );
+    return HUDBatch::createFan( v.get() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void HUD::createTargetIndicatorCue()
+void HUD::createTargetIndicators()
 {
-    const float ro = 3.0f;
-    const float ri = 1.0f;
-
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    _patTargetCue->addChild( geode.get() );
-
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
-    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-    v->push_back( osg::Vec3(  ro, 0.0f, -1.0f ) );
-    v->push_back( osg::Vec3(  ri, 0.0f, -1.0f ) );
-
-    v->push_back( osg::Vec3( -ro, 0.0f, -1.0f ) );
-    v->push_back( osg::Vec3( -ri, 0.0f, -1.0f ) );
+    const float del = 1.0f / 2.0f;
 
-    v->push_back( osg::Vec3( 0.0f,  ro, -1.0f ) );
-    v->push_back( osg::Vec3( 0.0f,  ri, -1.0f ) );
+    const float w = 10.0f;
+    const float h =  2.0f;
+    const float d =  8.0f;
 
-    v->push_back( osg::Vec3( 0.0f, -ro, -1.0f ) );
-    v->push_back( osg::Vec3( 0.0f, -ri, -1.0f ) );
+    const float w_2 = w / 2.0f;
+    const float h_2 = h / 2.0f;
 
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
+    // bar box
+    {
+        osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
 
-    c->push_back( osg::Vec4( Color::red, 0.7f ) );
+        v->push_back( osg::Vec3( -w_2, -h_2 + d, -1.0f ) );
+        v->push_back( osg::Vec3( -w_2 - del, -h_2 + d - del, -1.0f ) );
 
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::LINES, 0, v->size() ) );
+        v->push_back( osg::Vec3( -w_2,  h_2 + d, -1.0f ) );
+        v->push_back( osg::Vec3( -w_2 - del,  h_2 + d + del, -1.0f ) );
 
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
+        v->push_back( osg::Vec3(  w_2,  h_2 + d, -1.0f ) );
+        v->push_back( osg::Vec3(  w_2 + del,  h_2 + d + del, -1.0f ) );
 
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+        v->push_back( osg::Vec3(  w_2, -h_2 + d, -1.0f ) );
+        v->push_back( osg::Vec3(  w_2 + del, -h_2 + d - del, -1.0f ) );
 
-    geode->addDrawable( geometry.get() );
+        v->push_back( osg::Vec3( -w_2, -h_2 + d, -1.0f ) );
+        v->push_back( osg::Vec3( -w_2 - del, -h_2 + d - del, -1.0f ) );
 
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
+        _shapeTargetBarBox = HUDBatch::createStrip( v.get() );
+    }
 
-    osg::ref_ptr<osg::LineWidth> lineWidth = new osg::LineWidth();
-    lineWidth->setWidth( _linesWidth );
+    // bar
+    {
+        osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
 
-    stateSet->setAttributeAndModes( lineWidth, osg::StateAttribute::ON );
+        v->push_back( osg::Vec3( -w_2, -h_2 + d, -2.0f ) ); // 4
+        v->push_back( osg::Vec3( -w_2,  h_2 + d, -2.0f ) ); // 1
+        v->push_back( osg::Vec3(  w_2,  h_2 + d, -2.0f ) ); // 2
+        v->push_back( osg::Vec3(  w_2, -h_2 + d, -2.0f ) ); // 3
 
-    stateSet->setMode( GL_BLEND      , osg::StateAttribute::OVERRIDE | osg::StateAttribute::ON  );
-    stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
+        _shapeTargetBar = HUDBatch::createFan( v.get() );
+    }
 
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
+    // box
+    _shapeTargetBox = createBox();
 
-    if ( _tutorial )
+    // cue
     {
-        _switchPointerTarget = new osg::Switch();
-        _patTargetCue->addChild( _switchPointerTarget.get() );
-
-        osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-        _switchPointerTarget->addChild( pat.get() );
+        const float ro = 3.0f;
+        const float ri = 1.0f;
 
-        pat->setPosition( osg::Vec3( 0.0f, -10.0f, 0.0f ) );
+        osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
 
-        createPointer( pat.get() );
+        v->push_back( osg::Vec3(  ro, 0.0f, -1.0f ) );
+        v->push_back( osg::Vec3(  ri, 0.0f, -1.0f ) );
 
-        _switchPointerTarget->setAllChildrenOff();
-    }
-}
+        v->push_back( osg::Vec3( -ro, 0.0f, -1.0f ) );
+        v->push_back( osg::Vec3( -ri, 0.0f, -1.0f ) );
 
-////////////////////////////////////////////////////////////////////////////////
+        v->push_back( osg::Vec3( 0.0f,  ro, -1.0f ) );
+        v->push_back( osg::Vec3( 0.0f,  ri, -1.0f ) );
 
-void HUD::createTargetIndicatorDir()
-{
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    _patTargetDir->addChild( geode.get() );
+        v->push_back( osg::Vec3( 0.0f, -ro, -1.0f ) );
+        v->push_back( osg::Vec3( 0.0f, -ri, -1.0f ) );
 
-    createDir( geode.get(), osg::Vec4( Color::red, 0.7f ) );
+        _shapeTargetCue = HUDBatch::createLines( v.get(), _linesWidthHUD );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void HUD::createTutorialSymbols()
 {
-    _switchPointerCustom = new osg::Switch();
-    _switch->addChild( _switchPointerCustom.get() );
-
-    _patPointerCustom = new osg::PositionAttitudeTransform();
-    _switchPointerCustom->addChild( _patPointerCustom.get() );
-
-    createPointer( _patPointerCustom.get() );
-
-    _switchPointerCustom->setAllChildrenOff();
+    _shapePointer = createPointer();
 
 #   ifndef SIM_DESKTOP
-    createTutorialTips();
-#   endif
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-#ifndef SIM_DESKTOP
-void HUD::createTutorialTips()
-{
-    _switchTutorialTips = new osg::Switch();
-    _switch->addChild( _switchTutorialTips.get() );
-
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    _switchTutorialTips->addChild( geode.get() );
-
     const float d_y = -36.0f;
     const float w_2 =  36.0f;
     const float h_2 =  18.0f;
@@ -1620,12 +838,7 @@ void HUD::createTutorialTips()
 
     // box
     {
-        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-        geode->addDrawable( geometry.get() );
-
         osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-        osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
 
         v->push_back( osg::Vec3( 0.0f, d_y, -1.0f ) );
 
@@ -1643,146 +856,43 @@ void HUD::createTutorialTips()
 
         v->push_back( osg::Vec3( -w_2, -h_2 + r + d_y, -1.0f ) );
 
-        n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-        c->push_back( osg::Vec4( Color::black, 0.5f ) );
-
-        geometry->setVertexArray( v.get() );
-        geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_FAN, 0, v->size() ) );
-
-        geometry->setNormalArray( n.get() );
-        geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-        geometry->setColorArray( c.get() );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+        _shapeTipBox = HUDBatch::createFan( v.get() );
     }
 
-    // tip
+    // tips
     {
-        _tutorialTip = new osg::Geometry();
-        geode->addDrawable( _tutorialTip.get() );
-
         osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-        osg::ref_ptr<osg::Vec2Array> t = new osg::Vec2Array();  // texcoords
-        osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
 
         v->push_back( osg::Vec3( -w_2, -h_2 + d_y, 0.0f ) );
         v->push_back( osg::Vec3(  w_2, -h_2 + d_y, 0.0f ) );
         v->push_back( osg::Vec3(  w_2,  h_2 + d_y, 0.0f ) );
         v->push_back( osg::Vec3( -w_2,  h_2 + d_y, 0.0f ) );
 
-        t->push_back( osg::Vec2( 0.0f, 0.0f ) );
-        t->push_back( osg::Vec2( 1.0f, 0.0f ) );
-        t->push_back( osg::Vec2( 1.0f, 1.0f ) );
-        t->push_back( osg::Vec2( 0.0f, 1.0f ) );
-
-        n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-        c->push_back( osg::Vec4( Color::white, 1.0f ) );
-
-        _tutorialTip->setVertexArray( v.get() );
-        _tutorialTip->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_FAN, 0, v->size() ) );
-
-        _tutorialTip->setTexCoordArray( 0, t.get() );
-
-        _tutorialTip->setNormalArray( n.get() );
-        _tutorialTip->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-        _tutorialTip->setColorArray( c.get() );
-        _tutorialTip->setColorBinding( osg::Geometry::BIND_OVERALL );
+        _shapeTips[ 0 ] = HUDBatch::createFan( v.get(), _batch->addTexture( getPath( "textures/hud_tip_bank_l.rgb"  ) ) );
+        _shapeTips[ 1 ] = HUDBatch::createFan( v.get(), _batch->addTexture( getPath( "textures/hud_tip_bank_r.rgb"  ) ) );
+        _shapeTips[ 2 ] = HUDBatch::createFan( v.get(), _batch->addTexture( getPath( "textures/hud_tip_pitch_u.rgb" ) ) );
+        _shapeTips[ 3 ] = HUDBatch::createFan( v.get(), _batch->addTexture( getPath( "textures/hud_tip_pitch_d.rgb" ) ) );
     }
-
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-    stateSet->setMode( GL_BLEND      , osg::StateAttribute::OVERRIDE | osg::StateAttribute::ON  );
-    stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
-
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
-
-    _switchTutorialTips->setAllChildrenOff();
+#   endif
 }
-#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void HUD::createWaypointIndicators()
-{
-    _switchWaypointIndicators = new osg::Switch();
-    _switch->addChild( _switchWaypointIndicators.get() );
-
-    _patWaypointBox = new osg::PositionAttitudeTransform();
-    _switchWaypointIndicators->addChild( _patWaypointBox.get() );
-
-    _patWaypointDir = new osg::PositionAttitudeTransform();
-    _switchWaypointIndicators->addChild( _patWaypointDir.get() );
-
-    createWaypointIndicatorBox();
-    createWaypointIndicatorDir();
-
-    _switchWaypointIndicators->setAllChildrenOff();
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void HUD::createWaypointIndicatorBox()
 {
     const float size = Convert::rad2deg( atan( Gates::_size / ( 2.0f * Gates::_distScale ) ) ) * 1200.0f / 90.0f;
 
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    _patWaypointBox->addChild( geode.get() );
-
     const float w_2 = size / 2.0f;
     const float h_2 = size / 2.0f;
 
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-    geode->addDrawable( geometry.get() );
-
     osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
 
     v->push_back( Vec3( -w_2,  h_2, 0.0f ) );
     v->push_back( Vec3( -w_2, -h_2, 0.0f ) );
     v->push_back( Vec3(  w_2, -h_2, 0.0f ) );
     v->push_back( Vec3(  w_2,  h_2, 0.0f ) );
 
-    n->push_back( osg::Vec3( 0.0f, 1.0f, 0.0f ) );
-
-    c->push_back( osg::Vec4( Color::lime, 0.8f ) );
-
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::LINE_LOOP, 0, v->size() ) );
-
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
-
-    osg::ref_ptr<osg::LineWidth> lineWidth = new osg::LineWidth();
-    lineWidth->setWidth( _linesWidth );
-
-    stateSet->setAttributeAndModes( lineWidth, osg::StateAttribute::ON );
-
-    stateSet->setMode( GL_BLEND      , osg::StateAttribute::OVERRIDE | osg::StateAttribute::ON  );
-    stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
-
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void HUD::createWaypointIndicatorDir()
-{
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    _patWaypointDir->addChild( geode.get() );
-
-    createDir( geode.get(), osg::Vec4( Color::lime, 0.8f ) );
+    _shapeWaypointBox = HUDBatch::createLines( v.get(), _linesWidthHUD, true );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1791,54 +901,54 @@ void HUD::updateCaption()
 {
     float coef = 1.0f;
 
-    if ( !Data::get()->paused && Data::get()->mission.status != Pending )
+    if ( !Data::view()->paused && Data::view()->mission.status != Pending )
     {
-        if ( Data::get()->mission.status == Success )
+        if ( Data::view()->mission.status == Success )
         {
             _switchCaption->setAllChildrenOn();
             _textCaption->setText( osgText::String( Captions::instance()->getMissionSuccess(), osgText::String::ENCODING_UTF8 ) );
         }
-        else if ( Data::get()->mission.status == Failure )
+        else if ( Data::view()->mission.status == Failure )
         {
             _switchCaption->setAllChildrenOn();
             _textCaption->setText( osgText::String( Captions::instance()->getMissionFailure(), osgText::String::ENCODING_UTF8 ) );
         }
 
-        coef = Data::get()->mission.time_end;
+        coef = Data::view()->mission.time_end;
 
         if ( coef > 1.0f ) coef = 1.0f;
     }
-    else if ( !Data::get()->paused )
+    else if ( !Data::view()->paused )
     {
         float time = 0.0f;
 
-        if ( Data::get()->ownship.friend_hit < 1.0f )
+        if ( Data::view()->ownship.friend_hit < 1.0f )
         {
             _switchCaption->setAllChildrenOn();
             _textCaption->setText( osgText::String( Captions::instance()->getFriendlyFire(), osgText::String::ENCODING_UTF8 ) );
 
-            time = Data::get()->ownship.friend_hit;
+            time = Data::view()->ownship.friend_hit;
         }
-        else if ( Data::get()->ownship.target_kill < 1.0f )
+        else if ( Data::view()->ownship.target_kill < 1.0f )
         {
             _switchCaption->setAllChildrenOn();
             _textCaption->setText( osgText::String( Captions::instance()->getTargetKilled(), osgText::String::ENCODING_UTF8 ) );
 
-            time = Data::get()->ownship.target_kill;
+            time = Data::view()->ownship.target_kill;
         }
-        else if ( Data::get()->ownship.target_hit < 1.0f )
+        else if ( Data::view()->ownship.target_hit < 1.0f )
         {
             _switchCaption->setAllChildrenOn();
             _textCaption->setText( osgText::String( Captions::instance()->getTargetHit(), osgText::String::ENCODING_UTF8 ) );
 
-            time = Data::get()->ownship.target_hit;
+            time = Data::view()->ownship.target_hit;
         }
-        else if ( Data::get()->mission.time_left < 30.0f && Data::get()->mission.time_left > 0.0f )
+        else if ( Data::view()->mission.time_left < 30.0f && Data::view()->mission.time_left > 0.0f )
         {
             _switchCaption->setAllChildrenOn();
 
-            int s = floor( Data::get()->mission.time_left );
-            int m = std::max( 0, std::min( 999, (int)( 1000 * ( Data::get()->mission.time_left - (float)s ) ) ) );
+            int s = floor( Data::view()->mission.time_left );
+            int m = std::max( 0, std::min( 999, (int)( 1000 * ( Data::view()->mission.time_left - (float)s ) ) ) );
             int c = m / 10;
 
             if ( m - 10 * c == 1 ) m += 1;
@@ -1864,11 +974,11 @@ void HUD::updateCaption()
     if ( coef < 0.0f ) coef = 0.0f;
 
 #   ifdef SIM_TEST
-    if ( Data::get()->mission.status == Pending
-         && ( Data::get()->camera.type == ViewFlyby
-           || Data::get()->camera.type == ViewFront
-           || Data::get()->camera.type == ViewOrbit
-           || Data::get()->camera.type == ViewShift ) )
+    if ( Data::view()->mission.status == Pending
+         && ( Data::view()->camera.type == ViewFlyby
+           || Data::view()->camera.type == ViewFront
+           || Data::view()->camera.type == ViewOrbit
+           || Data::view()->camera.type == ViewShift ) )
     {
         coef = 0.0f;
     }
@@ -1885,16 +995,16 @@ void HUD::updateCaption()
 void HUD::updateControls()
 {
 #   ifndef SIM_DESKTOP
-    if ( Data::get()->controls.trigger )
-    {
-        _switchTrigger->setSingleChildOn( 1 );
-    }
-    else
-    {
-        _switchTrigger->setSingleChildOn( 0 );
-    }
+    const osg::Vec3 pos_throttle( -_maxX, 10.0f, 0.0f );
+    const osg::Vec3 pos_trigger( _maxX - 5.0f - 25.0f, 0.0f, 0.0f );
+
+    const osg::Vec4 color( Color::white, 0.4f );
 
-    _patControlsThrottle->setPosition( osg::Vec3( 0.0f, -50.0f + Data::get()->controls.throttle * 100.0f, 0.0f ) );
+    _batch->draw( _shapeThrottleBase, color, pos_throttle );
+    _batch->draw( _shapeThrottleGrip, color, pos_throttle
+                  + osg::Vec3( 0.0f, -50.0f + Data::view()->controls.throttle * 100.0f, 0.0f ) );
+
+    _batch->draw( _shapeTrigger[ Data::view()->controls.trigger ? 1 : 0 ], color, pos_trigger );
 #   endif
 }
 
@@ -1902,75 +1012,69 @@ void HUD::updateControls()
 
 void HUD::updateCrosshair()
 {
-    osg::Vec3 r( _rad2px * Data::get()->camera.d_psi,
-                -_rad2px * Data::get()->camera.d_tht,
+    osg::Vec3 r( _rad2px * Data::view()->camera.d_psi,
+                -_rad2px * Data::view()->camera.d_tht,
                  0.0f );
 
-    _patCrosshair->setPosition( r );
+    _batch->draw( _shapeCrosshair, osg::Vec4( Color::white, 1.0f ), r );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void HUD::updateHitIndicator()
 {
-    float coef = 1.0f - Data::get()->ownship.ownship_hit;
+    float coef = 1.0f - Data::view()->ownship.ownship_hit;
 
     if ( coef < 0.0f ) coef = 0.0f;
 
-    osg::ref_ptr<osg::Vec4Array> c = dynamic_cast< osg::Vec4Array* >( _hitIndicator->getColorArray() );
-
-    if ( c.valid() )
+    if ( coef > 0.0f )
     {
-        c->clear();
+        float scale = 0.8f + 0.2f * coef;
 
-        osg::Vec4 inner = osg::Vec4( Color::red, 0.0f );
-        osg::Vec4 outer = osg::Vec4( Color::red, 0.8f * coef );
+        osg::Vec3 pos( 1.2 * _rad2px * Data::view()->camera.d_psi, -40.0f, 0.0f );
 
-        for ( int i = 0 ; i < 8; i++ )
-        {
-            c->push_back( inner );
-            c->push_back( outer );
-        }
-
-        _hitIndicator->setColorArray( c.get() );
+        _batch->draw( _shapeHitIndicator, osg::Vec4( Color::red, 0.8f * coef ), pos,
+                      Data::view()->ownship.hit_direction,
+                      osg::Vec3( scale, scale, scale ) );
     }
-
-    float scale = 0.8f + 0.2f * coef;
-
-    osg::Vec3 pos( 1.2 * _rad2px * Data::get()->camera.d_psi, -40.0f, 0.0f );
-
-    _patHitIndicator->setPosition( pos );
-    _patHitIndicator->setAttitude( osg::Quat( Data::get()->ownship.hit_direction, osg::Z_AXIS ) );
-    _patHitIndicator->setScale( osg::Vec3( scale, scale, scale ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void HUD::updateIndicators()
 {
+    const osg::Vec4 color( Color::white, 0.7f );
+
+    const osg::Vec3 pos_alt(  86.0f, -75.0f, 0.0f );
+    const osg::Vec3 pos_asi( -47.0f, -80.0f, 0.0f );
+    const osg::Vec3 pos_vsi(  47.0f, -80.0f, 0.0f );
+
     // ALT
-    float altitude1 = Convert::m2ft( Data::get()->ownship.altitude_asl ) / 10000.0f;
+    float altitude1 = Convert::m2ft( Data::view()->ownship.altitude_asl ) / 10000.0f;
     float altitude2 = 10.0f * ( altitude1 - floor( altitude1 ) );
 
     altitude1 *= 2.0f * M_PI;
     altitude2 *= 2.0f * M_PI;
 
-    _patIndicatorALT1->setAttitude( osg::Quat( -altitude1, osg::Z_AXIS ) );
-    _patIndicatorALT2->setAttitude( osg::Quat( -altitude2, osg::Z_AXIS ) );
+    _batch->draw( _shapeFaceALT  , color, pos_alt );
+    _batch->draw( _shapeHandALT1 , osg::Vec4( Color::white, 1.0f ), pos_alt, -altitude1 );
+    _batch->draw( _shapeHandALT2 , osg::Vec4( Color::white, 1.0f ), pos_alt, -altitude2 );
 
     // ASI
-    float airspeed = Convert::mps2kts( Data::get()->ownship.airspeed ) / 100.0;
+    float airspeed = Convert::mps2kts( Data::view()->ownship.airspeed ) / 100.0;
     airspeed *= M_PI_2;
 
-    _patIndicatorASI->setAttitude( osg::Quat( -airspeed, osg::Z_AXIS ) );
+    _batch->draw( _shapeFaceASI , color, pos_asi );
+    _batch->draw( _shapeHandASI , osg::Vec4( Color::white, 1.0f ), pos_asi, -airspeed );
 
     // VSI
-    float climbRate = Convert::mps2fpm( Data::get()->ownship.climbRate ) / 1000.0;
+    float climbRate = Convert::mps2fpm( Data::view()->ownship.climbRate ) / 1000.0;
     if ( climbRate >  4.3f ) climbRate =  4.3f;
     if ( climbRate < -4.3f ) climbRate = -4.3f;
     climbRate *= Convert::deg2rad( 40.0 );
 
-    _patIndicatorVSI->setAttitude( osg::Quat( M_PI_2 - climbRate, osg::Z_AXIS ) );
+    _batch->draw( _shapeFaceVSI , color, pos_vsi );
+    _batch->draw( _shapeHandVSI , osg::Vec4( Color::white, 1.0f ), pos_vsi, M_PI_2 - climbRate );
 
     // radar
     updateIndicatorRadar();
@@ -1984,109 +1088,104 @@ void HUD::updateIndicatorRadar()
     // 3 nm = 5556 m
     const float dist_coef = 16.0f / 5556.0f;
 
-    _patIndicatorRadar->setAttitude( osg::Quat( Data::get()->ownship.heading, osg::Z_AXIS ) );
+    const osg::Vec3 pos_radar( -86.0f, -75.0f, 0.0f );
 
-    _switchRadarMarksEnemy  ->setAllChildrenOff();
-    _switchRadarMarksFriend ->setAllChildrenOff();
-    _switchEnemyIndicators  ->setAllChildrenOff();
+    const float sinH = sin( Data::view()->ownship.heading );
+    const float cosH = cos( Data::view()->ownship.heading );
 
-    Vec3 pos_own( Data::get()->ownship.pos_x,
-                  Data::get()->ownship.pos_y,
-                  Data::get()->ownship.pos_z );
-    Quat att_own( Data::get()->ownship.att_x,
-                  Data::get()->ownship.att_y,
-                  Data::get()->ownship.att_z,
-                  Data::get()->ownship.att_w );
+    _batch->draw( _shapeFaceRadar, osg::Vec4( Color::white, 0.7f ), pos_radar );
 
-    Vec3 pos_cam( Data::get()->camera.pos_x,
-                  Data::get()->camera.pos_y,
-                  Data::get()->camera.pos_z );
-    Quat att_cam( Data::get()->camera.d_phi, osg::X_AXIS,
-                  Data::get()->camera.d_tht, osg::Y_AXIS,
-                  Data::get()->camera.d_psi, osg::Z_AXIS );
+    Vec3 pos_own( Data::view()->ownship.pos_x,
+                  Data::view()->ownship.pos_y,
+                  Data::view()->ownship.pos_z );
+    Quat att_own( Data::view()->ownship.att_x,
+                  Data::view()->ownship.att_y,
+                  Data::view()->ownship.att_z,
+                  Data::view()->ownship.att_w );
+
+    Vec3 pos_cam( Data::view()->camera.pos_x,
+                  Data::view()->camera.pos_y,
+                  Data::view()->camera.pos_z );
+    Quat att_cam( Data::view()->camera.d_phi, osg::X_AXIS,
+                  Data::view()->camera.d_tht, osg::Y_AXIS,
+                  Data::view()->camera.d_psi, osg::Z_AXIS );
 
     Quat att_own_inv = att_own.inverse();
     Quat att_cam_inv = att_cam.inverse();
 
-    UInt32 ownship_id = Data::get()->ownship.ownship_id;
+    UInt32 ownship_id = Data::view()->ownship.ownship_id;
 
     UInt16 indexE = 0;
     UInt16 indexF = 0;
 
-    Group::List *entities = Entities::instance()->getEntities();
-    Group::List::iterator it = entities->begin();
+    const Entities::Units *units = Entities::instance()->getUnits();
+    Entities::Units::const_iterator it = units->begin();
 
-    while ( it != entities->end() && indexE < _maxRadarMarks && indexF < _maxRadarMarks )
+    while ( it != units->end() && indexE < _maxRadarMarks && indexF < _maxRadarMarks )
     {
-        Unit *unit = dynamic_cast< Unit* >(*it);
+        Unit *unit = (*it);
 
-        if ( unit )
+        if ( unit->isActive() && ownship_id != unit->getId() )
         {
-            if ( unit->isActive() && ownship_id != unit->getId() )
-            {
-                osg::Vec3 r = unit->getPos() - pos_own;
-
-                float dist2 = r.length2();
-
-                // 3 nm = 5556 m
-                // 5556^2 = 30869136
-                if ( dist2 < 30869136.0f )
-                {
-                    float x = r.x() * dist_coef;
-                    float y = r.y() * dist_coef;
+            osg::Vec3 r = unit->getPos() - pos_own;
 
-                    if ( Hostile == unit->getAffiliation() )
-                    {
-                        _switchRadarMarksEnemy->setValue( indexE, true );
-                        _patRadarMarksEnemy[ indexE ]->setPosition( osg::Vec3( x, y, 0.0f ) );
+            float dist2 = r.length2();
 
-                        UnitAerial *aerialUnit = dynamic_cast< UnitAerial* >( unit );
+            // 3 nm = 5556 m
+            // 5556^2 = 30869136
+            if ( dist2 < 30869136.0f )
+            {
+                float x = r.x() * dist_coef;
+                float y = r.y() * dist_coef;
 
-                        if ( aerialUnit != 0
-                             &&
-                             ( Data::get()->ownship.target_id != unit->getId()
-                           || !Data::get()->ownship.target ) )
-                        {
-                            Vec3 r_enu = unit->getPos() - pos_cam;
-                            Vec3 n_box = ( att_cam_inv * ( att_own_inv * r_enu ) );
+                // radar marks are rotated with heading
+                osg::Vec3 pos_mark = pos_radar + osg::Vec3( cosH * x - sinH * y,
+                                                            sinH * x + cosH * y,
+                                                            0.0f );
 
-                            n_box *= 1.0/n_box.length();
+                if ( Hostile == unit->getAffiliation() )
+                {
+                    _batch->draw( _shapeRadarMark, osg::Vec4( Color::red, 1.0f ), pos_mark );
 
-                            float box_psi = atan2( -n_box.y(), -n_box.x() );
-                            float box_tht = atan2(  n_box.z(), -n_box.x() );
+                    UnitAerial *aerialUnit = dynamic_cast< UnitAerial* >( unit );
 
-                            if ( box_tht * box_tht + box_psi * box_psi < Ownship::_target_fov_max_2 )
-                            {
-                                _switchEnemyIndicators->setValue( 2 * indexE     , true  );
-                                _switchEnemyIndicators->setValue( 2 * indexE + 1 , false );
+                    if ( aerialUnit != 0
+                         &&
+                         ( Data::view()->ownship.target_id != unit->getId()
+                       || !Data::view()->ownship.target ) )
+                    {
+                        Vec3 r_enu = unit->getPos() - pos_cam;
+                        Vec3 n_box = ( att_cam_inv * ( att_own_inv * r_enu ) );
 
-                                // box
-                                osg::Vec3 r_box( _rad2px * -box_psi,
-                                                -_rad2px * -box_tht,
-                                                 0.0f );
+                        n_box *= 1.0/n_box.length();
 
-                                _patEnemyBox.at( indexE )->setPosition( r_box );
-                            }
-                            else
-                            {
-                                _switchEnemyIndicators->setValue( 2 * indexE     , false );
-                                _switchEnemyIndicators->setValue( 2 * indexE + 1 , true  );
+                        float box_psi = atan2( -n_box.y(), -n_box.x() );
+                        float box_tht = atan2(  n_box.z(), -n_box.x() );
 
-                                float dir_phi = atan2( -n_box.y(),  n_box.z() );
+                        if ( box_tht * box_tht + box_psi * box_psi < Ownship::_target_fov_max_2 )
+                        {
+                            // box
+                            osg::Vec3 r_box( _rad2px * -box_psi,
+                                            -_rad2px * -box_tht,
+                                             0.0f );
 
-                                _patEnemyDir.at( indexE )->setAttitude( osg::Quat( dir_phi, osg::Z_AXIS ) );
-                            }
+                            _batch->draw( _shapeEnemyBox, osg::Vec4( Color::red, 0.7f ), r_box );
                         }
+                        else
+                        {
+                            float dir_phi = atan2( -n_box.y(),  n_box.z() );
 
-                        indexE++;
+                            _batch->draw( _shapeDir, osg::Vec4( Color::red, 0.7f ), osg::Vec3(), dir_phi );
+                        }
                     }
-                    else
-                    {
-                        _switchRadarMarksFriend->setValue( indexF, true );
-                        _patRadarMarksFriend[ indexF ]->setPosition( osg::Vec3( x, y, 0.0f ) );
 
-                        indexF++;
-                    }
+                    indexE++;
+                }
+                else
+                {
+                    _batch->draw( _shapeRadarMark, osg::Vec4( Color::lime, 1.0f ), pos_mark );
+
+                    indexF++;
                 }
             }
         }
@@ -2099,14 +1198,14 @@ void HUD::updateIndicatorRadar()
 
 void HUD::updateMessage()
 {
-    if ( Data::get()->message.visible && ( Data::get()->mission.status == Pending || Data::get()->paused ) )
+    if ( Data::view()->message.visible && ( Data::view()->mission.status == Pending || Data::view()->paused ) )
     {
         _switchMessage->setValue( 0, true );
-        _switchMessage->setValue( Data::get()->message.overlay ? 1 : 2, false );
-        _switchMessage->setValue( Data::get()->message.overlay ? 2 : 1, true  );
+        _switchMessage->setValue( Data::view()->message.overlay ? 1 : 2, false );
+        _switchMessage->setValue( Data::view()->message.overlay ? 2 : 1, true  );
 
-        //_textMessage->setText( osgText::String( String::toUpper( Data::get()->message.text ).c_str() ) );
-        _textMessage->setText( osgText::String( Data::get()->message.text, osgText::String::ENCODING_UTF8 ) );
+        //_textMessage->setText( osgText::String( String::toUpper( Data::view()->message.text ).c_str() ) );
+        _textMessage->setText( osgText::String( Data::view()->message.text, osgText::String::ENCODING_UTF8 ) );
     }
     else
     {
@@ -2118,148 +1217,112 @@ void HUD::updateMessage()
 
 void HUD::updatePlayerBar()
 {
-    float sx = (float)Data::get()->ownship.hit_points / 100.0f;
+    float sx = (float)Data::view()->ownship.hit_points / 100.0f;
     float dx = 60.0f * sx - 60.0;
 
-    _patPlayerBar->setPosition( osg::Vec3( dx, 0.0f, 0.0f ) );
-    _patPlayerBar->setScale( osg::Vec3( sx, 1.0f, 1.0f ) );
-
-    osg::ref_ptr<osg::Vec4Array> c = dynamic_cast< osg::Vec4Array* >( _playerLifeBar->getColorArray() );
+    osg::Vec3f upper = Color::lime;
 
-    if ( c.valid() )
+    if ( Data::view()->ownship.hit_points < 25 )
     {
-        c->clear();
-
-        osg::Vec3f upper = Color::lime;
-        osg::Vec3f lower = Color::lime * 0.5f;
-
-        if ( Data::get()->ownship.hit_points < 25 )
-        {
-            upper = Color::red;
-            lower = Color::red * 0.5f;
-        }
-        else if ( Data::get()->ownship.hit_points < 50 )
-        {
-            upper = Color::yellow;
-            lower = Color::yellow * 0.5f;
-        }
+        upper = Color::red;
+    }
+    else if ( Data::view()->ownship.hit_points < 50 )
+    {
+        upper = Color::yellow;
+    }
 
-        c->push_back( osg::Vec4( lower, 1.0f ) );
-        c->push_back( osg::Vec4( upper, 1.0f ) );
-        c->push_back( osg::Vec4( upper, 1.0f ) );
-        c->push_back( osg::Vec4( lower, 1.0f ) );
+    _batch->draw( _shapePlayerBar, osg::Vec4( upper, 1.0f ),
+                  osg::Vec3( dx, 0.0f, 0.0f ), 0.0f,
+                  osg::Vec3( sx, 1.0f, 1.0f ) );
 
-        _playerLifeBar->setColorArray( c.get() );
-    }
+    _batch->draw( _shapePlayerBarBox , osg::Vec4( Color::black, 1.0f ) );
+    _batch->draw( _shapePlayerHeart  , osg::Vec4( Color::white, 1.0f ) );
 
-    _textPlayerHP->setText( String::toString( Data::get()->ownship.hit_points ) );
+    _textPlayerHP->setText( String::toString( Data::view()->ownship.hit_points ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void HUD::updateTargetIndicators()
 {
-    if ( Data::get()->ownship.target && Data::get()->mission.status == Pending )
+    if ( Data::view()->ownship.target && Data::view()->mission.status == Pending )
     {
-        if ( Data::get()->ownship.target_box || Data::get()->ownship.target_cue )
+        if ( Data::view()->ownship.target_box )
         {
-            _switchTargetIndicators->setValue( 0, Data::get()->ownship.target_box );
-            _switchTargetIndicators->setValue( 1, Data::get()->ownship.target_cue );
-
             // bar
-            float sx = (float)Data::get()->ownship.target_hp / 100.0f;
+            float sx = (float)Data::view()->ownship.target_hp / 100.0f;
             float dx = 5.0f * sx - 5.0;
 
-            _patTargetBar->setPosition( osg::Vec3( dx, 0.0f, 0.0f ) );
-            _patTargetBar->setScale( osg::Vec3( sx, 1.0f, 1.0f ) );
-
-            osg::ref_ptr<osg::Vec4Array> c = dynamic_cast< osg::Vec4Array* >( _targetLifeBar->getColorArray() );
+            osg::Vec4 color( Color::lime, 1.0f );
 
-            if ( c.valid() )
+            if ( Data::view()->ownship.target_hp < 25 )
             {
-                c->clear();
-
-                if ( Data::get()->ownship.target_hp < 25 )
-                {
-                    c->push_back( osg::Vec4( Color::red, 1.0f ) );
-                }
-                else if ( Data::get()->ownship.target_hp < 50 )
-                {
-                    c->push_back( osg::Vec4( Color::yellow, 1.0f ) );
-                }
-                else
-                {
-                    c->push_back( osg::Vec4( Color::lime, 1.0f ) );
-                }
-
-                _targetLifeBar->setColorArray( c.get() );
+                color = osg::Vec4( Color::red, 1.0f );
+            }
+            else if ( Data::view()->ownship.target_hp < 50 )
+            {
+                color = osg::Vec4( Color::yellow, 1.0f );
             }
 
             // box
-            osg::Vec3 r_box( _rad2px * -Data::get()->ownship.target_box_psi,
-                            -_rad2px * -Data::get()->ownship.target_box_tht,
+            osg::Vec3 r_box( _rad2px * -Data::view()->ownship.target_box_psi,
+                            -_rad2px * -Data::view()->ownship.target_box_tht,
                              0.0f );
 
-            _patTargetBox->setPosition( r_box );
+            _batch->draw( _shapeTargetBar, color,
+                          r_box + osg::Vec3( dx, 0.0f, 0.0f ), 0.0f,
+                          osg::Vec3( sx, 1.0f, 1.0f ) );
+
+            _batch->draw( _shapeTargetBarBox , osg::Vec4( Color::black, 1.0f ), r_box );
+            _batch->draw( _shapeTargetBox    , osg::Vec4( Color::red, 0.7f ), r_box );
+        }
 
+        if ( Data::view()->ownship.target_cue )
+        {
             // cue
-            osg::Vec3 r_cue( _rad2px * -Data::get()->ownship.target_cue_psi,
-                            -_rad2px * -Data::get()->ownship.target_cue_tht,
+            osg::Vec3 r_cue( _rad2px * -Data::view()->ownship.target_cue_psi,
+                            -_rad2px * -Data::view()->ownship.target_cue_tht,
                              0.0f );
 
-            _patTargetCue->setPosition( r_cue );
-        }
-        else
-        {
-            _switchTargetIndicators->setValue( 0, false );
-            _switchTargetIndicators->setValue( 1, false );
-        }
+            _batch->draw( _shapeTargetCue, osg::Vec4( Color::red, 0.7f ), r_cue );
 
-        if ( !Data::get()->ownship.target_cue )
-        {
-            _switchTargetIndicators->setValue( 2, true );
-            _patTargetDir->setAttitude( osg::Quat( Data::get()->ownship.target_dir_phi, osg::Z_AXIS ) );
+            if ( _tutorial && Data::view()->message.pointer_target
+              && Data::view()->message.visible
+              && ( Data::view()->mission.status == Pending || Data::view()->paused ) )
+            {
+                _batch->draw( _shapePointer, osg::Vec4( Color::lime, 1.0f ),
+                              r_cue + osg::Vec3( 0.0f, -10.0f, 0.0f ) );
+            }
         }
         else
         {
-            _switchTargetIndicators->setValue( 2, false );
+            _batch->draw( _shapeDir, osg::Vec4( Color::red, 0.7f ), osg::Vec3(),
+                          Data::view()->ownship.target_dir_phi );
         }
     }
-    else
-    {
-        _switchTargetIndicators->setAllChildrenOff();
-    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void HUD::updateTutorialSymbols()
 {
-    if ( Data::get()->message.visible && ( Data::get()->mission.status == Pending || Data::get()->paused ) )
+    if ( Data::view()->message.visible && ( Data::view()->mission.status == Pending || Data::view()->paused ) )
     {
         // custom pointer
-        if ( Data::get()->message.pointer_custom )
+        if ( Data::view()->message.pointer_custom )
         {
-            _switchPointerCustom->setAllChildrenOn();
-
-            _patPointerCustom->setPosition( osg::Vec3( Data::get()->message.pointer_x,
-                                                       Data::get()->message.pointer_y,
-                                                       0.0f ) );
-            _patPointerCustom->setAttitude( osg::Quat( Data::get()->message.pointer_phi,
-                                                       osg::Z_AXIS ) );
-        }
-        else
-        {
-            _switchPointerCustom->setAllChildrenOff();
+            _batch->draw( _shapePointer, osg::Vec4( Color::lime, 1.0f ),
+                          osg::Vec3( Data::view()->message.pointer_x,
+                                     Data::view()->message.pointer_y,
+                                     0.0f ),
+                          Data::view()->message.pointer_phi );
         }
 
 #       ifndef SIM_DESKTOP
         // RPM pointer
-        if ( Data::get()->message.pointer_rpm_dec
-          || Data::get()->message.pointer_rpm_inc )
+        if ( Data::view()->message.pointer_rpm_dec
+          || Data::view()->message.pointer_rpm_inc )
         {
-            _switchPointerRpm->setAllChildrenOn();
-
             float time = _timerTutorial;
 
             while ( time > 4.0f )
@@ -2268,10 +1331,10 @@ void HUD::updateTutorialSymbols()
             }
 
             osg::Vec3 pos;
-            osg::Vec3 pos0 = osg::Vec3( 0.0f, -50.0f + Data::get()->controls.throttle * 100.0f, 0.0f );
+            osg::Vec3 pos0 = osg::Vec3( 0.0f, -50.0f + Data::view()->controls.throttle * 100.0f, 0.0f );
             osg::Vec3 pos1;
 
-            if ( Data::get()->message.pointer_rpm_dec )
+            if ( Data::view()->message.pointer_rpm_dec )
             {
                 pos1 = osg::Vec3( 0.0f, -50.0f, 0.0 );
             }
@@ -2299,91 +1362,60 @@ void HUD::updateTutorialSymbols()
                 pos = pos0;
             }
 
-            _patPointerRpm->setPosition( pos );
-        }
-        else
-        {
-            _switchPointerRpm->setAllChildrenOff();
-        }
-#       endif
+            pos += osg::Vec3( -_maxX, 10.0f, 0.0f );
 
-        // target pointer
-        if ( Data::get()->message.pointer_target )
-        {
-            _switchPointerTarget->setAllChildrenOn();
-        }
-        else
-        {
-            _switchPointerTarget->setAllChildrenOff();
+            _batch->draw( _shapeThrottleGrip, osg::Vec4( Color::white, 0.2f ), pos );
+            _batch->draw( _shapePointer, osg::Vec4( Color::lime, 1.0f ),
+                          pos + osg::Vec3( 52.0f, 0.0f, 0.0f ), M_PI_2 );
         }
 
-#       ifndef SIM_DESKTOP
         // trigger pointer
-        if ( Data::get()->message.pointer_trigger )
-        {
-            _switchPointerTrigger->setAllChildrenOn();
-        }
-        else
+        if ( Data::view()->message.pointer_trigger )
         {
-            _switchPointerTrigger->setAllChildrenOff();
+            const osg::Vec3 pos_trigger( _maxX - 5.0f - 25.0f, 0.0f, 0.0f );
+
+            _batch->draw( _shapeTriggerRing, osg::Vec4( Color::lime, 1.0f ), pos_trigger );
+            _batch->draw( _shapePointer, osg::Vec4( Color::lime, 1.0f ),
+                          pos_trigger + osg::Vec3( -33.0f, 0.0f, 0.0f ), -M_PI_2 );
         }
 
         // tutorial tip
-        if ( Data::get()->message.tip != NoTip )
+        int tip = -1;
+
+        switch ( Data::view()->message.tip )
         {
-            _switchTutorialTips->setAllChildrenOn();
+        case BankLeft:
+            tip = 0;
+            break;
 
-            std::string textureFile = "";
+        case BankRight:
+            tip = 1;
+            break;
 
-            switch ( Data::get()->message.tip )
-            {
-            case BankLeft:
-                textureFile = getPath( "textures/hud_tip_bank_l.rgb" );
-                break;
-
-            case BankRight:
-                textureFile = getPath( "textures/hud_tip_bank_r.rgb" );
-                break;
-
-            case PitchUp:
-                textureFile = getPath( "textures/hud_tip_pitch_u.rgb" );
-                break;
-
-            case PitchDown:
-                textureFile = getPath( "textures/hud_tip_pitch_d.rgb" );
-                break;
-
-            default:
-                textureFile = "";
-                _switchTutorialTips->setAllChildrenOff();
-                break;
-            }
+        case PitchUp:
+            tip = 2;
+            break;
 
-            if ( textureFile.length() > 0 )
-            {
-                osg::ref_ptr<osg::StateSet> stateSet = _tutorialTip->getOrCreateStateSet();
+        case PitchDown:
+            tip = 3;
+            break;
 
-                stateSet->setTextureAttributeAndModes( 0, Textures::get( textureFile ), osg::StateAttribute::ON );
-            }
+        default:
+            tip = -1;
+            break;
         }
-        else
+
+        if ( tip >= 0 )
         {
-            _switchTutorialTips->setAllChildrenOff();
+            _batch->draw( _shapeTipBox, osg::Vec4( Color::black, 0.5f ) );
+            _batch->draw( _shapeTips[ tip ], osg::Vec4( Color::white, 1.0f ) );
         }
 #       endif
 
-        _timerTutorial += Data::get()->mission.time_step;
+        _timerTutorial += Data::view()->mission.time_step;
     }
     else
     {
-        _switchPointerCustom->setAllChildrenOff();
-        _switchPointerTarget->setAllChildrenOff();
-#       ifndef SIM_DESKTOP
-        _switchPointerRpm->setAllChildrenOff();
-        _switchPointerTrigger->setAllChildrenOff();
-        _switchTutorialTips->setAllChildrenOff();
-#       endif
-
         _timerTutorial = 0.0;
     }
 }
@@ -2392,40 +1424,25 @@ void HUD::updateTutorialSymbols()
 
 void HUD::updateWaypointIndicators()
 {
-    if ( Data::get()->ownship.waypoint && Data::get()->mission.status == Pending )
+    if ( Data::view()->ownship.waypoint && Data::view()->mission.status == Pending )
     {
         // waypoint box
-        if ( Data::get()->ownship.waypoint_dist >= Gates::_distMax )
+        if ( Data::view()->ownship.waypoint_dist >= Gates::_distMax )
         {
-            _switchWaypointIndicators->setValue( 0, true );
-
-            osg::Vec3 r_box( _rad2px * -Data::get()->ownship.waypoint_psi,
-                            -_rad2px * -Data::get()->ownship.waypoint_tht,
+            osg::Vec3 r_box( _rad2px * -Data::view()->ownship.waypoint_psi,
+                            -_rad2px * -Data::view()->ownship.waypoint_tht,
                              0.0f );
 
-            _patWaypointBox->setPosition( r_box );
-            _patWaypointBox->setAttitude( osg::Quat( Data::get()->ownship.rollAngle, osg::Z_AXIS ) );
-        }
-        else
-        {
-            _switchWaypointIndicators->setValue( 0, false );
+            _batch->draw( _shapeWaypointBox, osg::Vec4( Color::lime, 0.8f ), r_box,
+                          Data::view()->ownship.rollAngle );
         }
 
         // waypoint dir
-        if ( ( fabs( Data::get()->ownship.waypoint_tht ) < _rad11deg && fabs( Data::get()->ownship.waypoint_psi ) < _rad11deg )
-          || Data::get()->ownship.waypoint_dist < 50.0f )
-        {
-            _switchWaypointIndicators->setValue( 1, false );
-        }
-        else
+        if ( !( ( fabs( Data::view()->ownship.waypoint_tht ) < _rad11deg && fabs( Data::view()->ownship.waypoint_psi ) < _rad11deg )
+             || Data::view()->ownship.waypoint_dist < 50.0f ) )
         {
-            _switchWaypointIndicators->setValue( 1, true );
-
-            _patWaypointDir->setAttitude( osg::Quat( Data::get()->ownship.waypoint_phi, osg::Z_AXIS ) );
+            _batch->draw( _shapeDir, osg::Vec4( Color::lime, 0.8f ), osg::Vec3(),
+                          Data::view()->ownship.waypoint_phi );
         }
     }
-    else
-    {
-        _switchWaypointIndicators->setAllChildrenOff();
-    }
 }
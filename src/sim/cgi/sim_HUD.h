@@ -19,7 +19,6 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <osg/Material>
 #include <osg/PositionAttitudeTransform>
 #include <osg/Switch>
 
@@ -28,6 +27,8 @@
 #include <sim/sim_Base.h>
 #include <sim/sim_Types.h>
 
+#include <sim/cgi/sim_HUDBatch.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace sim
@@ -58,7 +59,7 @@ public:
     /** @brief Initializes HUD. */
     void init( bool tutorial );
 
-    /** */
+    /** @brief Removes splash screen. */
     void load();
 
     /** @brief Updates HUD. */
@@ -76,68 +77,51 @@ private:
 
     const int _maxX;                    ///< [px] maximum x-coordinate value (depending on screen ratio)
 
+    const float _linesWidthHUD;         ///< lines width expressed in HUD coordinates
+
     osg::ref_ptr<osg::Group> _root;     ///< HUD root group
+    osg::ref_ptr<osg::Group> _splash;   ///< splash screen, displayed until HUD is loaded
 
     osg::ref_ptr<osg::Switch> _switch;  ///< HUD master switch
 
     osg::ref_ptr<osgText::Font> _font;  ///< HUD font
 
     osg::ref_ptr<osg::Switch> _switchCaption;               ///< captions switch
-    osg::ref_ptr<osg::Switch> _switchEnemyIndicators;       ///< enemy indicators switch
     osg::ref_ptr<osg::Switch> _switchMessage;               ///< message switch
-    osg::ref_ptr<osg::Switch> _switchPointerCustom;         ///< custom pointer switch
-    osg::ref_ptr<osg::Switch> _switchPointerTarget;         ///< target cue pointer switch
-    osg::ref_ptr<osg::Switch> _switchRadarMarksEnemy;       ///< radar marks switch enemy
-    osg::ref_ptr<osg::Switch> _switchRadarMarksFriend;      ///< radar marks switch friend
-    osg::ref_ptr<osg::Switch> _switchTargetIndicators;      ///< target indicator switch
-    osg::ref_ptr<osg::Switch> _switchWaypointIndicators;    ///< waypoint indicators switch
-#   ifndef SIM_DESKTOP
-    osg::ref_ptr<osg::Switch> _switchTrigger;               ///< trigger switch
-    osg::ref_ptr<osg::Switch> _switchPointerRpm;            ///< RPM pointer switch
-    osg::ref_ptr<osg::Switch> _switchPointerTrigger;        ///< trigger pointer switch
-    osg::ref_ptr<osg::Switch> _switchTutorialTips;          ///< tutorial tips switch (only in tutorial mode)
-#   endif
 
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patCaption;           ///< caption position and scale
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patCrosshair;         ///< crosshair (target sight) position
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patHitIndicator;      ///< hit indicator position and attitude
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patIndicatorALT1;     ///< altimeter 1000 ft hand rotation
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patIndicatorALT2;     ///< altimeter 100 ft hand rotation
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patIndicatorASI;      ///< airspeed inidicator hand rotation
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patIndicatorRadar;    ///< radar heading rotation
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patIndicatorVSI;      ///< vertical speed indicator hand rotation
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patPlayerBar;         ///< player health bar scale and position
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patPointerCustom;     ///< custom pointer position and rotation
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patTargetBar;         ///< target health bar position and scaler
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patTargetBox;         ///< target box position
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patTargetCue;         ///< target cue postion relative to target box
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patTargetDir;         ///< target direction indicator rotation
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patWaypointBox;       ///< wayposint box position
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patWaypointDir;       ///< waypoint direction indicator rotation
+    osg::ref_ptr<osg::PositionAttitudeTransform> _patCaption;   ///< caption position and scale
+
+    HUDBatch *_batch;                           ///< HUD elements batch
+
+    HUDBatch::Shape _shapeCrosshair;            ///< crosshair (target sight)
+    HUDBatch::Shape _shapeDir;                  ///< direction indicator
+    HUDBatch::Shape _shapeEnemyBox;             ///< enemy indicator box
+    HUDBatch::Shape _shapeFaceALT;              ///< altimeter face
+    HUDBatch::Shape _shapeFaceASI;              ///< airspeed indicator face
+    HUDBatch::Shape _shapeFaceRadar;            ///< radar face
+    HUDBatch::Shape _shapeFaceVSI;              ///< vertical speed indicator face
+    HUDBatch::Shape _shapeHandALT1;             ///< altimeter 1000 ft hand
+    HUDBatch::Shape _shapeHandALT2;             ///< altimeter 100 ft hand
+    HUDBatch::Shape _shapeHandASI;              ///< airspeed indicator hand
+    HUDBatch::Shape _shapeHandVSI;              ///< vertical speed indicator hand
+    HUDBatch::Shape _shapeHitIndicator;         ///< hit indicator
+    HUDBatch::Shape _shapePlayerBar;            ///< player health bar
+    HUDBatch::Shape _shapePlayerBarBox;         ///< player health bar box
+    HUDBatch::Shape _shapePlayerHeart;          ///< player health heart
+    HUDBatch::Shape _shapePointer;              ///< tutorial pointer
+    HUDBatch::Shape _shapeRadarMark;            ///< radar mark
+    HUDBatch::Shape _shapeTargetBar;            ///< target health bar
+    HUDBatch::Shape _shapeTargetBarBox;         ///< target health bar box
+    HUDBatch::Shape _shapeTargetBox;            ///< target box
+    HUDBatch::Shape _shapeTargetCue;            ///< target cue
+    HUDBatch::Shape _shapeWaypointBox;          ///< waypoint box
 #   ifndef SIM_DESKTOP
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patControlsThrottle;  ///< throttle grip position
-    osg::ref_ptr<osg::PositionAttitudeTransform> _patPointerRpm;        ///< RPM pointer position
-#   endif
-
-    std::vector< osg::ref_ptr<osg::PositionAttitudeTransform> > _patRadarMarksEnemy;    ///< list of enemy markings PATs
-    std::vector< osg::ref_ptr<osg::PositionAttitudeTransform> > _patRadarMarksFriend;   ///< list of friend markings PATs
-
-    std::vector< osg::ref_ptr<osg::PositionAttitudeTransform> > _patEnemyBox;           ///< target box position
-    std::vector< osg::ref_ptr<osg::PositionAttitudeTransform> > _patEnemyDir;           ///< target direction indicator rotation
-
-    osg::ref_ptr<osg::Geode> _geodeRadarMarkEnemy;      ///< radar mark geode enemy
-    osg::ref_ptr<osg::Geode> _geodeRadarMarkFriend;     ///< radar mark geode friend
-
-    osg::ref_ptr<osg::Geometry> _hitIndicator;          ///< hit indicator geometry
-    osg::ref_ptr<osg::Geometry> _playerLifeBar;         ///< player life bar geometry
-    osg::ref_ptr<osg::Geometry> _targetLifeBar;         ///< target life bar geometry
-#   ifndef SIM_DESKTOP
-    osg::ref_ptr<osg::Geometry> _tutorialTip;           ///< tutorial tip
-#   endif
-
-    osg::ref_ptr<osg::Material> _materialIndicators;    ///< indicators material
-#   ifndef SIM_DESKTOP
-    osg::ref_ptr<osg::Material> _materialControls;      ///< controls material
+    HUDBatch::Shape _shapeThrottleBase;         ///< throttle base
+    HUDBatch::Shape _shapeThrottleGrip;         ///< throttle grip
+    HUDBatch::Shape _shapeTrigger[ 2 ];         ///< trigger (released and pressed)
+    HUDBatch::Shape _shapeTriggerRing;          ///< trigger tutorial ring
+    HUDBatch::Shape _shapeTipBox;               ///< tutorial tip box
+    HUDBatch::Shape _shapeTips[ 4 ];            ///< tutorial tips (bank left, bank right, pitch up, pitch down)
 #   endif
 
     osg::ref_ptr<osgText::Text> _textPlayerHP;          ///< player's hit points text
@@ -148,67 +132,44 @@ private:
 
     float _timerTutorial;       ///< [s] timer for tutorial symbols
 
-    void createBox( osg::Geode *geode, osg::Vec4 color, float width = 1.0f );
+    HUDBatch::Shape createBox( float width = 1.0f );
 
     void createCaption();
 
 #   ifndef SIM_DESKTOP
     void createControls();
     void createControlsThrottle();
-    void createControlsThrottleGrip( osg::Group *parent, float alpha, float z_offset = 0.0f );
     void createControlsTrigger();
 #   endif
 
     void createCrosshair();
 
-    void createDir( osg::Geode *geode, osg::Vec4 color );
+    HUDBatch::Shape createDir();
 
     void createHitIndicator();
 
-    void createEnemyIndicators();
-
     /**
      * Creates indicator face.
-     * @param parent parent group
      * @param radius face radius
-     * @param material face material
-     * @param textureFile texture file "independent" path
-     * @param alpha face transparency
+     * @param texture atlas texture index
+     * @return face shape
      */
-    void createFace( osg::Group *parent, float radius,
-                     osg::Material *material,
-                     const std::string &textureFile,
-                     float alpha = 1.0f );
+    HUDBatch::Shape createFace( float radius, int texture );
 
     void createIndicators();
-    void createIndicatorHand( osg::Group *parent, float l, float w );
-    void createIndicatorALT();
-    void createIndicatorASI();
-    void createIndicatorRadar();
-    void createIndicatorVSI();
+    HUDBatch::Shape createIndicatorHand( float l, float w );
 
     void createMessage();
 
     void createPlayerBar();
 
-    void createPointer( osg::Group *parent );
-
-    void createRadarMark( osg::Geode *geode, osg::Vec4 color );
+    HUDBatch::Shape createPointer();
 
     void createTargetIndicators();
-    void createTargetIndicatorBar();
-    void createTargetIndicatorBox();
-    void createTargetIndicatorCue();
-    void createTargetIndicatorDir();
 
     void createTutorialSymbols();
-#   ifndef SIM_DESKTOP
-    void createTutorialTips();
-#   endif
 
     void createWaypointIndicators();
-    void createWaypointIndicatorBox();
-    void createWaypointIndicatorDir();
 
     void updateCaption();
     void updateControls();
@@ -0,0 +1,318 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/cgi/sim_HUDBatch.h>
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <osg/Texture2D>
+
+#include <osgDB/ReadFile>
+
+#include <sim/sim_Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const int HUDBatch::_cellSize = 256;
+
+////////////////////////////////////////////////////////////////////////////////
+
+HUDBatch::Shape HUDBatch::createFan( const osg::Vec3Array *v, int texture,
+                                     const osg::Vec4Array *c )
+{
+    Shape shape;
+
+    shape.texture = texture;
+
+    osg::Vec2 min( v->front().x(), v->front().y() );
+    osg::Vec2 max( v->front().x(), v->front().y() );
+
+    for ( unsigned int i = 1; i < v->size(); i++ )
+    {
+        min.x() = std::min( min.x(), (*v)[ i ].x() );
+        min.y() = std::min( min.y(), (*v)[ i ].y() );
+        max.x() = std::max( max.x(), (*v)[ i ].x() );
+        max.y() = std::max( max.y(), (*v)[ i ].y() );
+    }
+
+    osg::Vec2 size = max - min;
+
+    for ( unsigned int i = 1; i + 1 < v->size(); i++ )
+    {
+        unsigned int indices[] = { 0, i, i + 1 };
+
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            const osg::Vec3 &vertex = (*v)[ indices[ j ] ];
+
+            shape.v.push_back( vertex );
+
+            if ( c ) shape.c.push_back( (*c)[ indices[ j ] ] );
+
+            if ( texture >= 0 )
+            {
+                shape.t.push_back( osg::Vec2( ( vertex.x() - min.x() ) / size.x(),
+                                              ( vertex.y() - min.y() ) / size.y() ) );
+            }
+        }
+    }
+
+    return shape;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+HUDBatch::Shape HUDBatch::createLines( const osg::Vec3Array *v, float width, bool loop )
+{
+    Shape shape;
+
+    const float w_2 = width / 2.0f;
+
+    unsigned int segments = loop ? v->size() : v->size() / 2;
+
+    for ( unsigned int i = 0; i < segments; i++ )
+    {
+        osg::Vec3 a = loop ? (*v)[ i ] : (*v)[ 2 * i ];
+        osg::Vec3 b = loop ? (*v)[ ( i + 1 ) % v->size() ] : (*v)[ 2 * i + 1 ];
+
+        osg::Vec3 d = b - a;
+        d.normalize();
+
+        // segments are extended by half of width to close corners
+        osg::Vec3 n( -d.y() * w_2, d.x() * w_2, 0.0f );
+
+        a -= d * w_2;
+        b += d * w_2;
+
+        shape.v.push_back( a - n );
+        shape.v.push_back( b - n );
+        shape.v.push_back( b + n );
+
+        shape.v.push_back( a - n );
+        shape.v.push_back( b + n );
+        shape.v.push_back( a + n );
+    }
+
+    return shape;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+HUDBatch::Shape HUDBatch::createStrip( const osg::Vec3Array *v, const osg::Vec4Array *c )
+{
+    Shape shape;
+
+    for ( unsigned int i = 0; i + 2 < v->size(); i++ )
+    {
+        for ( unsigned int j = i; j < i + 3; j++ )
+        {
+            shape.v.push_back( (*v)[ j ] );
+
+            if ( c ) shape.c.push_back( (*c)[ j ] );
+        }
+    }
+
+    return shape;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+HUDBatch::HUDBatch() :
+    _cols ( 1 ),
+    _rows ( 1 )
+{
+    _geode = new osg::Geode();
+    _geometry = new osg::Geometry();
+
+    _v = new osg::Vec3Array();
+    _c = new osg::Vec4Array();
+    _t = new osg::Vec2Array();
+
+    _drawArrays = new osg::DrawArrays( osg::PrimitiveSet::TRIANGLES, 0, 0 );
+
+    _geometry->setDataVariance( osg::Object::DYNAMIC );
+    _geometry->setUseDisplayList( false );
+    _geometry->setUseVertexBufferObjects( true );
+
+    _geometry->setVertexArray( _v.get() );
+    _geometry->addPrimitiveSet( _drawArrays.get() );
+
+    _geometry->setColorArray( _c.get() );
+    _geometry->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+
+    _geometry->setTexCoordArray( 0, _t.get() );
+
+    _geode->addDrawable( _geometry.get() );
+
+    // elements are written in HUD frame every frame
+    _geode->setCullingActive( false );
+
+    osg::ref_ptr<osg::StateSet> stateSet = _geode->getOrCreateStateSet();
+
+    stateSet->setMode( GL_LIGHTING   , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
+    stateSet->setMode( GL_BLEND      , osg::StateAttribute::OVERRIDE | osg::StateAttribute::ON  );
+    stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OVERRIDE | osg::StateAttribute::OFF );
+
+    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
+    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_HUD, "RenderBin" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+HUDBatch::~HUDBatch() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int HUDBatch::addTexture( const std::string &textureFile )
+{
+    _textures.push_back( textureFile );
+
+    return _textures.size() - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HUDBatch::build()
+{
+    // last cell is white and used by untextured elements
+    int cells = _textures.size() + 1;
+
+    _cols = std::min( cells, 4 );
+    _rows = ( cells + _cols - 1 ) / _cols;
+
+    while ( _rows & ( _rows - 1 ) )
+    {
+        _rows++;
+    }
+
+    osg::ref_ptr<osg::Image> atlas = new osg::Image();
+    atlas->allocateImage( _cols * _cellSize, _rows * _cellSize, 1, GL_RGBA, GL_UNSIGNED_BYTE );
+
+    memset( atlas->data(), 255, atlas->getTotalSizeInBytes() );
+
+    for ( unsigned int i = 0; i < _textures.size(); i++ )
+    {
+        osg::ref_ptr<osg::Image> image = osgDB::readImageFile( _textures[ i ] );
+
+        if ( !image.valid() )
+        {
+            Log::e() << "Cannot open texture file: " << _textures[ i ] << std::endl;
+            continue;
+        }
+
+        // image is resampled with filtering, so that cell texels match image texels
+        if ( !image->isCompressed() && ( image->s() != _cellSize || image->t() != _cellSize ) )
+        {
+            image->scaleImage( _cellSize, _cellSize, 1 );
+        }
+
+        int s0 = ( i % _cols ) * _cellSize;
+        int t0 = ( i / _cols ) * _cellSize;
+
+        for ( int t = 0; t < _cellSize; t++ )
+        {
+            for ( int s = 0; s < _cellSize; s++ )
+            {
+                osg::Vec4 color = image->getColor( osg::Vec2( ( s + 0.5f ) / _cellSize,
+                                                              ( t + 0.5f ) / _cellSize ) );
+
+                unsigned char *data = atlas->data( s0 + s, t0 + t );
+
+                for ( int j = 0; j < 4; j++ )
+                {
+                    data[ j ] = (unsigned char)( 255.0f * std::max( 0.0f, std::min( 1.0f, color[ j ] ) ) + 0.5f );
+                }
+            }
+        }
+    }
+
+    osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D( atlas.get() );
+
+    texture->setWrap( osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE );
+    texture->setWrap( osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE );
+    texture->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR );
+    texture->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+
+    _geode->getOrCreateStateSet()->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HUDBatch::begin()
+{
+    _v->clear();
+    _c->clear();
+    _t->clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HUDBatch::draw( const Shape &shape, const osg::Vec4 &color,
+                     const osg::Vec3 &pos, float angle,
+                     const osg::Vec3 &scale )
+{
+    const float sinA = sin( angle );
+    const float cosA = cos( angle );
+
+    const osg::Vec2 center( 0.5f, 0.5f );
+
+    for ( unsigned int i = 0; i < shape.v.size(); i++ )
+    {
+        float x = scale.x() * shape.v[ i ].x();
+        float y = scale.y() * shape.v[ i ].y();
+
+        _v->push_back( osg::Vec3( pos.x() + cosA * x - sinA * y,
+                                  pos.y() + sinA * x + cosA * y,
+                                  pos.z() ) );
+
+        _c->push_back( i < shape.c.size() ? osg::componentMultiply( color, shape.c[ i ] ) : color );
+        _t->push_back( getTexCoord( shape.texture, i < shape.t.size() ? shape.t[ i ] : center ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HUDBatch::end()
+{
+    _drawArrays->setCount( _v->size() );
+
+    _v->dirty();
+    _c->dirty();
+    _t->dirty();
+
+    _geometry->dirtyBound();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Vec2 HUDBatch::getTexCoord( int texture, const osg::Vec2 &t ) const
+{
+    int cell = ( texture < 0 ) ? _textures.size() : texture;
+
+    float s0 = ( cell % _cols ) * _cellSize;
+    float t0 = ( cell / _cols ) * _cellSize;
+
+    // half texel inset prevents sampling neighbouring cells
+    return osg::Vec2( ( s0 + 0.5f + t.x() * ( _cellSize - 1 ) ) / ( _cols * _cellSize ),
+                      ( t0 + 0.5f + t.y() * ( _cellSize - 1 ) ) / ( _rows * _cellSize ) );
+}
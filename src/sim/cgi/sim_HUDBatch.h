@@ -0,0 +1,144 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_HUDBATCH_H
+#define SIM_HUDBATCH_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+
+#include <sim/sim_Base.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief HUD elements batch class.
+ *
+ * All HUD elements are written every frame into single dynamic vertex buffer
+ * and drawn with single draw call. Textured elements use texture atlas built
+ * once from all HUD textures, untextured elements use its white cell.
+ */
+class HUDBatch : public Base
+{
+public:
+
+    static const int _cellSize;     ///< [px] atlas cell size
+
+    /** Element shape struct. */
+    struct Shape
+    {
+        std::vector< osg::Vec3 > v;     ///< triangles vertices
+        std::vector< osg::Vec4 > c;     ///< vertices color coefficients (optional)
+        std::vector< osg::Vec2 > t;     ///< vertices texture coordinates (optional)
+
+        int texture;                    ///< atlas texture index, -1 if not textured
+
+        Shape() : texture ( -1 ) {}
+    };
+
+    /**
+     * @brief Creates shape from triangle fan.
+     * @param v fan vertices
+     * @param texture atlas texture index, texture is stretched over vertices bounds
+     * @param c vertices color coefficients
+     */
+    static Shape createFan( const osg::Vec3Array *v, int texture = -1,
+                            const osg::Vec4Array *c = 0 );
+
+    /**
+     * @brief Creates shape from lines.
+     * @param v lines vertices, pairs of vertices or line loop vertices
+     * @param width line width
+     * @param loop specifies if vertices are line loop
+     */
+    static Shape createLines( const osg::Vec3Array *v, float width, bool loop = false );
+
+    /**
+     * @brief Creates shape from triangle strip.
+     * @param v strip vertices
+     * @param c vertices color coefficients
+     */
+    static Shape createStrip( const osg::Vec3Array *v, const osg::Vec4Array *c = 0 );
+
+    /** @brief Constructor. */
+    HUDBatch();
+
+    /** @brief Destructor. */
+    virtual ~HUDBatch();
+
+    /**
+     * @brief Adds texture to the atlas, must be called before build().
+     * @param textureFile texture file path
+     * @return atlas texture index
+     */
+    int addTexture( const std::string &textureFile );
+
+    /** @brief Builds texture atlas. */
+    void build();
+
+    /** @brief Removes all elements, should be called before writing frame elements. */
+    void begin();
+
+    /**
+     * @brief Writes element.
+     * @param shape element shape
+     * @param color element color
+     * @param pos element position
+     * @param angle [rad] element rotation angle
+     * @param scale element scale
+     */
+    void draw( const Shape &shape, const osg::Vec4 &color,
+               const osg::Vec3 &pos = osg::Vec3(), float angle = 0.0f,
+               const osg::Vec3 &scale = osg::Vec3( 1.0f, 1.0f, 1.0f ) );
+
+    /** @brief Uploads frame elements, should be called after writing frame elements. */
+    void end();
+
+    /** @brief Returns OSG node. */
+    inline osg::Geode* getNode() { return _geode.get(); }
+
+private:
+
+    osg::ref_ptr<osg::Geode> _geode;            ///< batch geode
+    osg::ref_ptr<osg::Geometry> _geometry;      ///< batch geometry
+    osg::ref_ptr<osg::DrawArrays> _drawArrays;  ///< batch primitive set
+
+    osg::ref_ptr<osg::Vec3Array> _v;            ///< vertices
+    osg::ref_ptr<osg::Vec4Array> _c;            ///< colors
+    osg::ref_ptr<osg::Vec2Array> _t;            ///< texture coordinates
+
+    std::vector< std::string > _textures;       ///< atlas textures files
+
+    int _cols;                                  ///< atlas columns number
+    int _rows;                                  ///< atlas rows number
+
+    /** Returns atlas texture coordinates. */
+    osg::Vec2 getTexCoord( int texture, const osg::Vec2 &t ) const;
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_HUDBATCH_H
@@ -0,0 +1,408 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/cgi/sim_Impostors.h>
+
+#include <osg/AlphaFunc>
+#include <osg/LightSource>
+#include <osg/MatrixTransform>
+#include <osg/Projection>
+
+#include <sim/cgi/sim_Color.h>
+#include <sim/cgi/sim_HUD.h>
+
+#include <sim/entities/sim_Entities.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const int Impostors::_azimuths   = 8;
+const int Impostors::_elevations = 4;
+const int Impostors::_cellSize   = 64;
+const int Impostors::_atlasSize  = 2048;
+
+int Impostors::_pixelSize = SIM_IMPOSTORS_PIXEL_SIZE;
+
+osg::ref_ptr<osg::Group>       Impostors::_root;
+osg::ref_ptr<osg::Group>       Impostors::_cameras;
+osg::ref_ptr<osg::Geode>       Impostors::_geode;
+osg::ref_ptr<osg::Geometry>    Impostors::_geometry;
+osg::ref_ptr<osg::Vec3Array>   Impostors::_v;
+osg::ref_ptr<osg::Vec2Array>   Impostors::_t;
+osg::ref_ptr<osg::DrawArrays>  Impostors::_drawArrays;
+osg::ref_ptr<osg::Texture2D>   Impostors::_texture;
+
+Impostors::List Impostors::_impostors;
+
+float Impostors::_rad2px = 1.0f;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Impostors::RenderedCallback::RenderedCallback( Impostor *impostor ) :
+    _impostor ( impostor )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Impostors::RenderedCallback::operator() ( osg::RenderInfo & ) const
+{
+    _impostor->ready = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Group* Impostors::getNode()
+{
+    if ( !_root.valid() )
+    {
+        _root = new osg::Group();
+        _root->setName( "impostors" );
+
+        _cameras = new osg::Group();
+        _root->addChild( _cameras.get() );
+
+        _texture = new osg::Texture2D();
+        _texture->setTextureSize( _atlasSize, _atlasSize );
+        _texture->setInternalFormat( GL_RGBA );
+        _texture->setWrap( osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE );
+        _texture->setWrap( osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE );
+        _texture->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR_MIPMAP_LINEAR );
+        _texture->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+
+        _geode = new osg::Geode();
+        _root->addChild( _geode.get() );
+
+        _geometry = new osg::Geometry();
+        _geode->addDrawable( _geometry.get() );
+
+        _v = new osg::Vec3Array();
+        _t = new osg::Vec2Array();
+
+        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();
+        c->push_back( osg::Vec4( 1.0f, 1.0f, 1.0f, 1.0f ) );
+
+        _drawArrays = new osg::DrawArrays( osg::PrimitiveSet::QUADS, 0, 0 );
+
+        _geometry->setDataVariance( osg::Object::DYNAMIC );
+        _geometry->setUseDisplayList( false );
+        _geometry->setUseVertexBufferObjects( true );
+
+        _geometry->setVertexArray( _v.get() );
+        _geometry->addPrimitiveSet( _drawArrays.get() );
+
+        _geometry->setColorArray( c.get() );
+        _geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+
+        _geometry->setTexCoordArray( 0, _t.get() );
+
+        osg::ref_ptr<osg::StateSet> stateSet = _geode->getOrCreateStateSet();
+
+        // lighting is already baked into sprites
+        stateSet->setMode( GL_LIGHTING , osg::StateAttribute::OFF );
+        stateSet->setMode( GL_BLEND    , osg::StateAttribute::OFF );
+
+        stateSet->setAttributeAndModes( new osg::AlphaFunc( osg::AlphaFunc::GREATER, 0.5f ), osg::StateAttribute::ON );
+        stateSet->setTextureAttributeAndModes( 0, _texture.get(), osg::StateAttribute::ON );
+    }
+
+    return _root.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Impostors::init( int height )
+{
+    // HUD spans 200 units vertically
+    _rad2px = HUD::_rad2px * (float)height / 200.0f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Impostors::load()
+{
+    if ( _pixelSize > 0 )
+    {
+        load( Entities::instance()->getUnitsAerial() );
+        load( Entities::instance()->getUnitsMarine() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Impostors::reset()
+{
+    if ( _root.valid() )
+    {
+        _cameras->removeChildren( 0, _cameras->getNumChildren() );
+
+        _v->clear();
+        _t->clear();
+
+        _drawArrays->setCount( 0 );
+    }
+
+    for ( List::iterator it = _impostors.begin(); it != _impostors.end(); ++it )
+    {
+        DELPTR( it->second );
+    }
+
+    _impostors.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Impostors::update()
+{
+    if ( _pixelSize <= 0 || !_root.valid() )
+    {
+        return;
+    }
+
+    // sprites are rendered only once
+    for ( List::iterator it = _impostors.begin(); it != _impostors.end(); ++it )
+    {
+        if ( it->second->ready && it->second->camera.valid() )
+        {
+            _cameras->removeChild( it->second->camera.get() );
+            it->second->camera = 0;
+        }
+    }
+
+    osg::Vec3 pos_cam( Data::view()->camera.pos_x,
+                       Data::view()->camera.pos_y,
+                       Data::view()->camera.pos_z );
+
+    _v->clear();
+    _t->clear();
+
+    update( Entities::instance()->getUnitsAerial(), pos_cam );
+    update( Entities::instance()->getUnitsMarine(), pos_cam );
+
+    _drawArrays->setCount( _v->size() );
+
+    _v->dirty();
+    _t->dirty();
+
+    _geometry->dirtyBound();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Impostors::Impostor* Impostors::create( osg::Node *model )
+{
+    int row = _impostors.size();
+
+    if ( row >= _atlasSize / _cellSize )
+    {
+        return NULLPTR;
+    }
+
+    Impostor *impostor = new Impostor();
+
+    impostor->bound = model->getBound();
+    impostor->row   = row;
+    impostor->ready = false;
+
+    const int cells = _azimuths * _elevations;
+
+    const osg::Vec3 center = impostor->bound.center();
+    const float r = impostor->bound.radius();
+
+    // whole model row is rendered by a single camera
+    impostor->camera = new osg::Camera();
+
+    impostor->camera->setReferenceFrame( osg::Transform::ABSOLUTE_RF );
+    impostor->camera->setRenderOrder( osg::Camera::PRE_RENDER );
+    impostor->camera->setRenderTargetImplementation( osg::Camera::FRAME_BUFFER_OBJECT );
+    impostor->camera->setComputeNearFarMode( osg::CullSettings::DO_NOT_COMPUTE_NEAR_FAR );
+    impostor->camera->setCullingActive( false );
+
+    impostor->camera->setClearColor( osg::Vec4() );
+    impostor->camera->setClearMask( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+    impostor->camera->setViewport( 0, row * _cellSize, cells * _cellSize, _cellSize );
+    impostor->camera->attach( osg::Camera::COLOR_BUFFER, _texture.get(), 0, 0, true );
+
+    impostor->camera->setFinalDrawCallback( new RenderedCallback( impostor ) );
+
+    // head light
+    osg::ref_ptr<osg::Light> light = new osg::Light();
+
+    light->setLightNum( SIM_LIGHT_SUN_NUM );
+    light->setPosition( osg::Vec4( 0.0f, 0.0f, 1.0f, 0.0f ) );
+    light->setAmbient( osg::Vec4( Color::sun, 1.0f ) );
+    light->setDiffuse( osg::Vec4( Color::sun, 1.0f ) );
+
+    osg::ref_ptr<osg::LightSource> lightSource = new osg::LightSource();
+    impostor->camera->addChild( lightSource.get() );
+
+    lightSource->setLight( light.get() );
+    lightSource->setLocalStateSetModes( osg::StateAttribute::ON );
+    lightSource->setStateSetModes( *impostor->camera->getOrCreateStateSet(), osg::StateAttribute::ON );
+
+    for ( int el = 0; el < _elevations; el++ )
+    {
+        for ( int az = 0; az < _azimuths; az++ )
+        {
+            const int cell = el * _azimuths + az;
+
+            double psi = 2.0 * M_PI * az / _azimuths;
+            double tht = -M_PI_2 + M_PI * ( el + 0.5 ) / _elevations;
+
+            osg::Vec3 dir( cos( tht ) * cos( psi ), cos( tht ) * sin( psi ), sin( tht ) );
+
+            // cell is a slice of the row viewport normalized device coordinates
+            osg::Matrixd matrix = osg::Matrixd::ortho( -r, r, -r, r, 0.0, 4.0 * r )
+                                * osg::Matrixd::scale( 1.0 / cells, 1.0, 1.0 )
+                                * osg::Matrixd::translate( -1.0 + ( 2.0 * cell + 1.0 ) / cells, 0.0, 0.0 );
+
+            osg::ref_ptr<osg::Projection> projection = new osg::Projection( matrix );
+            impostor->camera->addChild( projection.get() );
+
+            osg::ref_ptr<osg::MatrixTransform> view = new osg::MatrixTransform();
+            projection->addChild( view.get() );
+
+            view->setReferenceFrame( osg::Transform::ABSOLUTE_RF );
+            view->setMatrix( osg::Matrixd::lookAt( center + dir * 2.0f * r, center, osg::Z_AXIS ) );
+            view->addChild( model );
+
+            projection->setCullingActive( false );
+            view->setCullingActive( false );
+        }
+    }
+
+    _cameras->addChild( impostor->camera.get() );
+
+    _impostors[ model ] = impostor;
+
+    return impostor;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Impostors::draw( const Impostor *impostor, const osg::Vec3 &pos, const osg::Quat &att,
+                      const osg::Vec3 &pos_cam )
+{
+    osg::Vec3 f = pos - pos_cam;
+    f.normalize();
+
+    // sprite is selected by direction to the camera expressed in model frame
+    osg::Vec3 d = att.inverse() * ( -f );
+
+    double psi = atan2( d.y(), d.x() );
+    double tht = asin( d.z() > 1.0f ? 1.0f : ( d.z() < -1.0f ? -1.0f : d.z() ) );
+
+    int az = (int)floor( _azimuths * psi / ( 2.0 * M_PI ) + 0.5 );
+    int el = (int)floor( _elevations * ( tht + M_PI_2 ) / M_PI );
+
+    az = ( az % _azimuths + _azimuths ) % _azimuths;
+
+    if ( el < 0 ) el = 0;
+    if ( el > _elevations - 1 ) el = _elevations - 1;
+
+    // sprites are rendered with model up axis as view up axis
+    osg::Vec3 s = f ^ ( att * osg::Z_AXIS );
+
+    if ( s.length2() < 1.0e-6 )
+    {
+        s = f ^ ( att * osg::X_AXIS );
+    }
+
+    s.normalize();
+
+    osg::Vec3 u = s ^ f;
+
+    const float r = impostor->bound.radius();
+
+    s *= r;
+    u *= r;
+
+    _v->push_back( pos - s - u );
+    _v->push_back( pos + s - u );
+    _v->push_back( pos + s + u );
+    _v->push_back( pos - s + u );
+
+    const float ds = (float)_cellSize / (float)_atlasSize;
+
+    const float s0 = ds * ( el * _azimuths + az );
+    const float t0 = ds * impostor->row;
+
+    _t->push_back( osg::Vec2( s0      , t0      ) );
+    _t->push_back( osg::Vec2( s0 + ds , t0      ) );
+    _t->push_back( osg::Vec2( s0 + ds , t0 + ds ) );
+    _t->push_back( osg::Vec2( s0      , t0 + ds ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Impostors::load( const std::vector< Unit* > *units )
+{
+    getNode();
+
+    for ( std::vector< Unit* >::const_iterator it = units->begin(); it != units->end(); ++it )
+    {
+        osg::Node *model = (*it)->getModel();
+
+        if ( model && _impostors.find( model ) == _impostors.end() )
+        {
+            create( model );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Impostors::update( const std::vector< Unit* > *units, const osg::Vec3 &pos_cam )
+{
+    for ( std::vector< Unit* >::const_iterator it = units->begin(); it != units->end(); ++it )
+    {
+        Unit *unit = *it;
+
+        bool impostor = false;
+
+        if ( unit->isActive() && !unit->isOwnship() )
+        {
+            List::iterator itImpostor = _impostors.find( unit->getModel() );
+
+            if ( itImpostor != _impostors.end() && itImpostor->second->ready )
+            {
+                const Impostor *data = itImpostor->second;
+
+                Quat att = unit->getAttInterpolated();
+                Vec3 pos = unit->getPosInterpolated() + att * data->bound.center();
+
+                float distance = ( pos - pos_cam ).length();
+
+                if ( distance > data->bound.radius() )
+                {
+                    float size = _rad2px * 2.0f * data->bound.radius() / distance;
+
+                    if ( size < _pixelSize )
+                    {
+                        impostor = true;
+                        draw( data, pos, att, pos_cam );
+                    }
+                }
+            }
+        }
+
+        unit->setImpostor( impostor );
+    }
+}
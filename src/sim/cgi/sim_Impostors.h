@@ -0,0 +1,139 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_IMPOSTORS_H
+#define SIM_IMPOSTORS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include <osg/Camera>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Texture2D>
+
+#include <sim/sim_Base.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+class Unit;
+
+/**
+ * @brief Distant units impostors class.
+ *
+ * Impostor is a set of model sprites pre-rendered at several view angles
+ * into a single texture atlas, one atlas row per model. Sprites are rendered
+ * once, at load time. Units smaller on screen than the impostors pixel size
+ * have their models hidden and are drawn as camera facing quads, all of them
+ * with a single geometry.
+ */
+class Impostors : public Base
+{
+public:
+
+    static const int _azimuths;     ///< number of sprites azimuths
+    static const int _elevations;   ///< number of sprites elevations
+    static const int _cellSize;     ///< [px] sprite size
+    static const int _atlasSize;    ///< [px] atlas texture size
+
+    static int _pixelSize;          ///< [px] units smaller on screen are drawn as impostors, 0 disables impostors
+
+    /** @brief Returns impostors node, it must be placed in world frame. */
+    static osg::Group* getNode();
+
+    /**
+     * @brief Initializes impostors.
+     * @param height [px] viewport height
+     */
+    static void init( int height );
+
+    /** @brief Creates impostors of all aerial and marine units models. */
+    static void load();
+
+    /** @brief Removes all impostors. */
+    static void reset();
+
+    /** @brief Updates units level of detail and impostors geometry, must be called after camera update. */
+    static void update();
+
+private:
+
+    /** Impostor data struct. */
+    struct Impostor
+    {
+        osg::ref_ptr<osg::Camera> camera;   ///< sprites pre-render camera, removed once rendered
+        osg::BoundingSphere bound;          ///< model bounding sphere
+        int row;                            ///< atlas row
+        std::atomic< bool > ready;          ///< specifies if sprites have been rendered, set by camera final draw callback
+    };
+
+    /** Impostor sprites rendered callback class. */
+    class RenderedCallback : public osg::Camera::DrawCallback
+    {
+    public:
+
+        /** Constructor. */
+        RenderedCallback( Impostor *impostor );
+
+        /** */
+        void operator() ( osg::RenderInfo & ) const;
+
+    private:
+
+        Impostor *_impostor;    ///< impostor
+    };
+
+    typedef std::map< osg::Node*, Impostor* > List;
+
+    static osg::ref_ptr<osg::Group> _root;              ///< impostors root
+    static osg::ref_ptr<osg::Group> _cameras;           ///< sprites pre-render cameras group
+    static osg::ref_ptr<osg::Geode> _geode;             ///< impostors geode
+    static osg::ref_ptr<osg::Geometry> _geometry;       ///< impostors geometry
+    static osg::ref_ptr<osg::Vec3Array> _v;             ///< impostors vertices
+    static osg::ref_ptr<osg::Vec2Array> _t;             ///< impostors texture coordinates
+    static osg::ref_ptr<osg::DrawArrays> _drawArrays;   ///< impostors primitive set
+    static osg::ref_ptr<osg::Texture2D> _texture;       ///< sprites atlas texture
+
+    static List _impostors;         ///< impostors indexed by model
+
+    static float _rad2px;           ///< [px/rad] viewport pixels per radian
+
+    /** Creates model impostor, returns NULLPTR if atlas is full. */
+    static Impostor* create( osg::Node *model );
+
+    /** Adds impostor quad. */
+    static void draw( const Impostor *impostor, const osg::Vec3 &pos, const osg::Quat &att,
+                      const osg::Vec3 &pos_cam );
+
+    /** Creates impostors of units models. */
+    static void load( const std::vector< Unit* > *units );
+
+    /** Updates units level of detail. */
+    static void update( const std::vector< Unit* > *units, const osg::Vec3 &pos_cam );
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_IMPOSTORS_H
@@ -0,0 +1,428 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/cgi/sim_Instances.h>
+
+#include <string.h>
+
+#include <osg/Geode>
+#include <osg/LOD>
+#include <osg/Program>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef SIM_DESKTOP
+bool Instances::_enabled = true;
+#else
+bool Instances::_enabled = false;
+#endif
+
+const int Instances::_textureUnit = 4;
+
+const char Instances::_frag[] =
+    "uniform sampler2D texture0;\n"
+    "uniform bool fogEnabled;\n"
+    "varying vec4 color;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   vec4 fragColor = color * texture2D(texture0, gl_TexCoord[0].st);\n"
+    "   float fog = 1.0;\n"
+    "   if (fogEnabled) fog = clamp((gl_Fog.end - gl_FogFragCoord) * gl_Fog.scale, 0.0, 1.0);\n"
+    "   gl_FragColor = vec4(mix(gl_Fog.color.rgb, fragColor.rgb, fog), fragColor.a);\n"
+    "}\n"
+    "\n";
+
+const char Instances::_vert[] =
+    "#version 120\n"
+    "#extension GL_ARB_draw_instanced : require\n"
+    "uniform mat4 osg_ViewMatrix;\n"
+    "uniform mat4 osg_ViewMatrixInverse;\n"
+    "uniform sampler2D instancesMatrices;\n"
+    "uniform float instancesSize;\n"
+    "varying vec4 color;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   float t = (float(gl_InstanceIDARB) + 0.5) / instancesSize;\n"
+    "   mat4 instance = mat4(texture2DLod(instancesMatrices, vec2(0.125, t), 0.0),\n"
+    "                        texture2DLod(instancesMatrices, vec2(0.375, t), 0.0),\n"
+    "                        texture2DLod(instancesMatrices, vec2(0.625, t), 0.0),\n"
+    "                        texture2DLod(instancesMatrices, vec2(0.875, t), 0.0));\n"
+    "\n"
+    "   mat4 modelView = osg_ViewMatrix * instance * osg_ViewMatrixInverse * gl_ModelViewMatrix;\n"
+    "   vec4 vertexInEye = modelView * gl_Vertex;\n"
+    "\n"
+    "   vec3 N = normalize(mat3(modelView) * gl_Normal);\n"
+    "   vec3 L = normalize(gl_LightSource[0].position.xyz);\n"
+    "   float diffuse = max(dot(N, L), 0.0);\n"
+    "\n"
+    "   color = gl_FrontLightModelProduct.sceneColor\n"
+    "         + gl_FrontLightProduct[0].ambient\n"
+    "         + gl_FrontLightProduct[0].diffuse * diffuse;\n"
+    "   color.a = gl_FrontMaterial.diffuse.a;\n"
+    "\n"
+    "   gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+    "   gl_FogFragCoord = length(vertexInEye.xyz);\n"
+    "   gl_Position = gl_ProjectionMatrix * vertexInEye;\n"
+    "}\n"
+    "\n";
+
+osg::ref_ptr<osg::Group>    Instances::_root;
+osg::ref_ptr<osg::StateSet> Instances::_stateSet;
+
+Instances::Batches Instances::_batches;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Instances::BoundCallback::BoundCallback( Batch *batch, const osg::Matrixd &inverse ) :
+    _batch ( batch ),
+    _inverse ( inverse )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::BoundingBox Instances::BoundCallback::computeBound( const osg::Drawable & ) const
+{
+    osg::BoundingBox bound;
+
+    if ( _batch->bound.valid() )
+    {
+        for ( unsigned int i = 0; i < 8; i++ )
+        {
+            bound.expandBy( _batch->bound.corner( i ) * _inverse );
+        }
+    }
+
+    return bound;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Instances::VisitorInstances::VisitorInstances( Batch *batch ) :
+    osg::NodeVisitor( osg::NodeVisitor::TRAVERSE_ALL_CHILDREN ),
+    _batch ( batch )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instances::VisitorInstances::apply( osg::Node &searchNode )
+{
+    osg::ref_ptr<osg::LOD> lod = dynamic_cast<osg::LOD*>( &searchNode );
+
+    if ( lod.valid() )
+    {
+        osg::ref_ptr<osg::Node> node = 0;
+
+        if ( lod->getNumChildren() > 0 )
+        {
+            node = lod->getChild( 0 );
+            lod->removeChildren( 0, lod->getNumChildren() );
+        }
+
+        if ( node.valid() )
+        {
+            lod->addChild( node.get(), 0.0f, 1.0e8 );
+        }
+    }
+
+    osg::ref_ptr<osg::Geode> geode = dynamic_cast<osg::Geode*>( &searchNode );
+
+    if ( geode.valid() )
+    {
+        // instances bounding box is expressed in batch root frame
+        osg::Matrixd inverse = osg::Matrixd::inverse( osg::computeLocalToWorld( getNodePath() ) );
+
+        for ( unsigned int i = 0; i < geode->getNumDrawables(); i++ )
+        {
+            osg::Geometry *geometry = geode->getDrawable( i )->asGeometry();
+
+            if ( geometry )
+            {
+                geometry->setUseDisplayList( false );
+                geometry->setUseVertexBufferObjects( true );
+                geometry->setComputeBoundingBoxCallback( new BoundCallback( _batch, inverse ) );
+
+                _batch->geometries.push_back( geometry );
+
+                for ( unsigned int j = 0; j < geometry->getNumPrimitiveSets(); j++ )
+                {
+                    _batch->primitives.push_back( geometry->getPrimitiveSet( j ) );
+                }
+            }
+        }
+    }
+
+    traverse( searchNode );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Instances::Instance* Instances::create( osg::Node *model )
+{
+    if ( !_enabled || !model )
+    {
+        return NULLPTR;
+    }
+
+    getNode();
+
+    osg::ref_ptr<Batch> batch = 0;
+
+    Batches::iterator it = _batches.find( model );
+
+    if ( it != _batches.end() )
+    {
+        batch = it->second;
+    }
+    else
+    {
+        batch = createBatch( model );
+
+        _batches[ model ] = batch;
+        _root->addChild( batch->root.get() );
+    }
+
+    Instance *instance = new Instance();
+
+    instance->batch = batch;
+    instance->index = -1;
+
+    return instance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Group* Instances::getNode()
+{
+    if ( !_root.valid() )
+    {
+        _root = new osg::Group();
+        _root->setName( "instances" );
+
+        // untextured geometries sample white texture
+        osg::ref_ptr<osg::Image> white = new osg::Image();
+        white->allocateImage( 1, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE );
+        memset( white->data(), 255, white->getTotalSizeInBytes() );
+
+        osg::ref_ptr<osg::Program> program = new osg::Program();
+        program->addShader( new osg::Shader( osg::Shader::VERTEX   , _vert ) );
+        program->addShader( new osg::Shader( osg::Shader::FRAGMENT , _frag ) );
+
+        _stateSet = _root->getOrCreateStateSet();
+        _stateSet->setTextureAttributeAndModes( 0, new osg::Texture2D( white.get() ) );
+        _stateSet->setAttributeAndModes( program.get() );
+        _stateSet->addUniform( new osg::Uniform( "texture0", 0 ) );
+        _stateSet->addUniform( new osg::Uniform( "instancesMatrices", _textureUnit ) );
+    }
+
+    return _root.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instances::remove( Instance *instance )
+{
+    if ( instance && instance->index >= 0 )
+    {
+        erase( instance );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instances::reset()
+{
+    if ( _root.valid() )
+    {
+        _root->removeChildren( 0, _root->getNumChildren() );
+    }
+
+    _batches.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instances::update( Instance *instance, const osg::Vec3 &pos, const osg::Quat &att,
+                        bool visible )
+{
+    if ( !visible )
+    {
+        remove( instance );
+        return;
+    }
+
+    osg::Matrixf matrix = osg::Matrixf::rotate( att ) * osg::Matrixf::translate( pos );
+
+    if ( instance->index < 0 )
+    {
+        instance->matrix = matrix;
+        add( instance );
+    }
+    else if ( matrix != instance->matrix )
+    {
+        instance->matrix = matrix;
+        write( instance );
+        updateBatch( instance->batch.get() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instances::add( Instance *instance )
+{
+    Batch *batch = instance->batch.get();
+
+    instance->index = batch->visible.size();
+    batch->visible.push_back( instance );
+
+    int rows = batch->image->t();
+
+    if ( (int)batch->visible.size() > rows )
+    {
+        // texture height is doubled and existing rows are copied
+        osg::ref_ptr<osg::Image> image = new osg::Image();
+        image->allocateImage( 4, 2 * rows, 1, GL_RGBA, GL_FLOAT );
+        image->setInternalTextureFormat( GL_RGBA32F_ARB );
+
+        memcpy( image->data(), batch->image->data(), batch->image->getTotalSizeInBytes() );
+
+        batch->image = image;
+        batch->texture->setImage( image.get() );
+        batch->size->set( (float)image->t() );
+    }
+
+    write( instance );
+    updateBatch( batch );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Instances::Batch* Instances::createBatch( osg::Node *model )
+{
+    osg::ref_ptr<Batch> batch = new Batch();
+
+    osg::CopyOp copyOp( osg::CopyOp::DEEP_COPY_NODES
+                      | osg::CopyOp::DEEP_COPY_DRAWABLES
+                      | osg::CopyOp::DEEP_COPY_PRIMITIVES );
+
+    osg::ref_ptr<osg::Node> copy = dynamic_cast<osg::Node*>( model->clone( copyOp ) );
+
+    batch->root = new osg::Group();
+    batch->model = model->getBound();
+
+    if ( copy.valid() )
+    {
+        VisitorInstances visitor( batch.get() );
+        copy->accept( visitor );
+
+        batch->root->addChild( copy.get() );
+    }
+
+    batch->image = new osg::Image();
+    batch->image->allocateImage( 4, 16, 1, GL_RGBA, GL_FLOAT );
+    batch->image->setInternalTextureFormat( GL_RGBA32F_ARB );
+
+    batch->texture = new osg::Texture2D( batch->image.get() );
+    batch->texture->setDataVariance( osg::Object::DYNAMIC );
+    batch->texture->setInternalFormat( GL_RGBA32F_ARB );
+    batch->texture->setSourceFormat( GL_RGBA );
+    batch->texture->setSourceType( GL_FLOAT );
+    batch->texture->setResizeNonPowerOfTwoHint( false );
+    batch->texture->setWrap( osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE );
+    batch->texture->setWrap( osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE );
+    batch->texture->setFilter( osg::Texture::MIN_FILTER, osg::Texture::NEAREST );
+    batch->texture->setFilter( osg::Texture::MAG_FILTER, osg::Texture::NEAREST );
+
+    batch->size = new osg::Uniform( "instancesSize", (float)batch->image->t() );
+
+    osg::ref_ptr<osg::StateSet> stateSet = batch->root->getOrCreateStateSet();
+
+    stateSet->setTextureAttribute( _textureUnit, batch->texture.get() );
+    stateSet->addUniform( batch->size.get() );
+
+    // there is nothing to draw until any instance is visible
+    batch->root->setNodeMask( 0 );
+
+    return batch.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instances::erase( Instance *instance )
+{
+    Batch *batch = instance->batch.get();
+
+    Instance *last = batch->visible.back();
+
+    if ( last != instance )
+    {
+        last->index = instance->index;
+        batch->visible[ last->index ] = last;
+
+        write( last );
+    }
+
+    batch->visible.pop_back();
+    instance->index = -1;
+
+    updateBatch( batch );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instances::updateBatch( Batch *batch )
+{
+    unsigned int count = batch->visible.size();
+
+    for ( Batch::Primitives::iterator it = batch->primitives.begin(); it != batch->primitives.end(); ++it )
+    {
+        (*it)->setNumInstances( count );
+    }
+
+    // primitive sets with no instances would be drawn once
+    batch->root->setNodeMask( count > 0 ? 0xffffffff : 0 );
+
+    batch->bound.init();
+
+    for ( Batch::List::iterator it = batch->visible.begin(); it != batch->visible.end(); ++it )
+    {
+        batch->bound.expandBy( osg::BoundingSphere( batch->model.center() * (*it)->matrix,
+                                                    batch->model.radius() ) );
+    }
+
+    for ( Batch::Geometries::iterator it = batch->geometries.begin(); it != batch->geometries.end(); ++it )
+    {
+        (*it)->dirtyBound();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instances::write( Instance *instance )
+{
+    Batch *batch = instance->batch.get();
+
+    // matrix is stored column by column as expected by GLSL mat4 constructor
+    memcpy( batch->image->data( 0, instance->index ), instance->matrix.ptr(), 16 * sizeof(float) );
+
+    batch->image->dirty();
+}
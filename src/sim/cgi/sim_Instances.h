@@ -0,0 +1,189 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_INSTANCES_H
+#define SIM_INSTANCES_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <vector>
+
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Image>
+#include <osg/NodeVisitor>
+#include <osg/Texture2D>
+#include <osg/Uniform>
+
+#include <sim/sim_Base.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Hardware instanced static models class.
+ *
+ * Identical models are grouped into batches. Each batch is a single copy
+ * of the model whose primitive sets are drawn once per instance. Instances
+ * transforms are stored in a floating point texture, one row per instance,
+ * which is read by the vertex shader using instance ID. Visible instances
+ * are kept packed at the beginning of the texture.
+ *
+ * Fragment shader applies fog only if "fogEnabled" uniform, which is set
+ * by FogScene together with GL_FOG mode, is true.
+ */
+class Instances : public Base
+{
+public:
+
+    struct Batch;
+
+    /** Instance handle struct. */
+    struct Instance : public osg::Referenced
+    {
+        osg::ref_ptr<Batch> batch;      ///< instance batch
+        int index;                      ///< instance row index, -1 if instance is hidden
+        osg::Matrixf matrix;            ///< instance transform
+    };
+
+    /** Instances batch struct. */
+    struct Batch : public osg::Referenced
+    {
+        typedef std::vector< osg::ref_ptr<osg::PrimitiveSet> > Primitives;
+        typedef std::vector< osg::ref_ptr<osg::Geometry> > Geometries;
+        typedef std::vector< Instance* > List;
+
+        osg::ref_ptr<osg::Group> root;          ///< batch root node
+        osg::ref_ptr<osg::Image> image;         ///< instances transforms image
+        osg::ref_ptr<osg::Texture2D> texture;   ///< instances transforms texture
+        osg::ref_ptr<osg::Uniform> size;        ///< instances transforms texture height
+
+        Primitives primitives;                  ///< instanced primitive sets
+        Geometries geometries;                  ///< instanced geometries
+
+        List visible;                           ///< visible instances in rows order
+
+        osg::BoundingSphere model;              ///< model bounding sphere
+        osg::BoundingBox bound;                 ///< visible instances bounding box
+    };
+
+    /**
+     * Instances visitor class. It prepares copy of the model to be drawn
+     * as instances. Every LOD node is reduced to its first child, as LOD
+     * center is common for all instances, and geometries are collected.
+     */
+    class VisitorInstances : public osg::NodeVisitor
+    {
+    public:
+
+        /** Constructor. */
+        VisitorInstances( Batch *batch );
+
+        /** */
+        void apply( osg::Node &searchNode );
+
+    private:
+
+        Batch *_batch;      ///< batch being prepared
+    };
+
+    /**
+     * Instanced geometry bounding box callback class. It returns bounding
+     * box of all visible instances expressed in the geometry frame.
+     */
+    class BoundCallback : public osg::Drawable::ComputeBoundingBoxCallback
+    {
+    public:
+
+        /** Constructor. */
+        BoundCallback( Batch *batch, const osg::Matrixd &inverse );
+
+        /** */
+        osg::BoundingBox computeBound( const osg::Drawable & ) const;
+
+    private:
+
+        Batch *_batch;              ///< batch the geometry belongs to
+        osg::Matrixd _inverse;      ///< batch root to geometry frame matrix
+    };
+
+    static bool _enabled;               ///< specifies if instancing is enabled
+
+    static const int _textureUnit;      ///< instances transforms texture unit
+
+    static const char _frag[];          ///<
+    static const char _vert[];          ///<
+
+    /**
+     * @brief Creates hidden instance of the model.
+     * @param model model node
+     * @return instance handle or NULLPTR if instancing is disabled
+     */
+    static Instance* create( osg::Node *model );
+
+    /** @brief Returns shared instances node, it must be placed in world frame. */
+    static osg::Group* getNode();
+
+    /** @brief Hides instance, the same as update() with visible set to false. */
+    static void remove( Instance *instance );
+
+    /** @brief Removes all batches. */
+    static void reset();
+
+    /**
+     * @brief Updates instance transform and visibility.
+     * Transforms texture is modified only if instance has changed.
+     * @param instance instance handle
+     * @param pos position expressed in world frame
+     * @param att attitude expressed in world frame
+     * @param visible specifies if instance is visible
+     */
+    static void update( Instance *instance, const osg::Vec3 &pos, const osg::Quat &att,
+                        bool visible = true );
+
+private:
+
+    typedef std::map< osg::Node*, osg::ref_ptr<Batch> > Batches;
+
+    static osg::ref_ptr<osg::Group> _root;          ///< instances root
+    static osg::ref_ptr<osg::StateSet> _stateSet;   ///< instances state set
+
+    static Batches _batches;                        ///< batches indexed by model
+
+    /** Appends instance as the last row. */
+    static void add( Instance *instance );
+
+    /** Creates batch drawing the model. */
+    static Batch* createBatch( osg::Node *model );
+
+    /** Removes instance moving the last row in its place. */
+    static void erase( Instance *instance );
+
+    /** Updates batch instances count and bounding box. */
+    static void updateBatch( Batch *batch );
+
+    /** Writes instance transform to its row. */
+    static void write( Instance *instance );
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_INSTANCES_H
@@ -0,0 +1,140 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/cgi/sim_Loader.h>
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Loader::Loader() :
+    _total ( 0 ),
+    _finished ( 0 ),
+    _quit ( false )
+{
+    // reading files is mostly disk bound, so a few threads are enough
+    UInt32 threads = std::min( 4u, std::thread::hardware_concurrency() / 2 );
+
+    if ( threads < 1 ) threads = 1;
+
+    for ( UInt32 i = 0; i < threads; i++ )
+    {
+        _threads.push_back( std::thread( &Loader::worker, this ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Loader::~Loader()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _quit = true;
+    }
+
+    _wake.notify_all();
+
+    for ( UInt32 i = 0; i < _threads.size(); i++ )
+    {
+        _threads[ i ].join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Loader::push( const Task &task )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        if ( _finished == _total )
+        {
+            _total    = 0;
+            _finished = 0;
+        }
+
+        _tasks.push_back( task );
+        _total++;
+    }
+
+    _wake.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Loader::wait()
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+    _done.wait( lock, [ this ]() { return _finished == _total; } );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+float Loader::getProgress()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    if ( _total > 0 )
+    {
+        return (float)_finished / (float)_total;
+    }
+
+    return 1.0f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Loader::isIdle()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    return _finished == _total;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Loader::worker()
+{
+    while ( true )
+    {
+        Task task;
+
+        {
+            std::unique_lock< std::mutex > lock( _mutex );
+            _wake.wait( lock, [ this ]() { return _quit || !_tasks.empty(); } );
+
+            if ( _quit ) return;
+
+            task = _tasks.front();
+            _tasks.pop_front();
+        }
+
+        task();
+
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _finished++;
+
+        if ( _finished == _total )
+        {
+            _done.notify_all();
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_LOADER_H
+#define SIM_LOADER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sim/sim_Types.h>
+
+#include <sim/utils/sim_Singleton.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Background assets loader class.
+ *
+ * Loading tasks are executed in queued order by a small pool of worker
+ * threads. Progress is counted since the loader was idle last time.
+ */
+class Loader : public Singleton< Loader >
+{
+    friend class Singleton< Loader >;
+
+public:
+
+    typedef std::function< void() > Task;
+
+private:
+
+    /**
+     * You should use static function instance() due to get refernce
+     * to Loader class instance.
+     */
+    Loader();
+
+    /** Using this constructor is forbidden. */
+    Loader( const Loader & ) : Singleton< Loader >() {}
+
+public:
+
+    /** @brief Destructor. */
+    virtual ~Loader();
+
+    /**
+     * @brief Queues task to be executed in background.
+     * @param task loading task
+     */
+    void push( const Task &task );
+
+    /** @brief Waits until all queued tasks are done. */
+    void wait();
+
+    /** @brief Returns loading progress within range from 0.0 to 1.0. */
+    float getProgress();
+
+    /** @brief Returns true if there are no queued nor executing tasks. */
+    bool isIdle();
+
+private:
+
+    std::vector< std::thread > _threads;    ///< worker threads
+    std::deque< Task > _tasks;              ///< queued tasks
+
+    std::mutex _mutex;                      ///< tasks mutex
+    std::condition_variable _wake;          ///< signaled when tasks are queued
+    std::condition_variable _done;          ///< signaled when all tasks are done
+
+    UInt32 _total;                          ///< number of tasks pushed since being idle
+    UInt32 _finished;                       ///< number of tasks finished since being idle
+
+    bool _quit;                             ///< specifies if workers should quit
+
+    /** Worker thread loop. */
+    void worker();
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_LOADER_H
@@ -31,7 +31,7 @@ using namespace sim;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-osg::ref_ptr<osg::LOD> Models::_tracer;
+osg::ref_ptr<osg::StateSet> Models::_tracerStateSet;
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -68,86 +68,23 @@ void Models::VisitorLOD::apply( osg::Node &searchNode )
 
 void Models::createTracer( float linesWidth )
 {
-    const float range = 500.0f;
-
-    _tracer = 0;
-
-    _tracer = new osg::LOD();
-
-    _tracer->setCenterMode( osg::LOD::USER_DEFINED_CENTER );
-    _tracer->setCenter( osg::Vec3( 0.0f, 0.0f, 0.0f ) );
-    _tracer->setRadius( 5.0f );
-    _tracer->setRangeMode( osg::LOD::DISTANCE_FROM_EYE_POINT );
-
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-
-    _tracer->addChild( geode.get(), 0.0f, range );
-    _tracer->setRange( 0, 0.0f, range );
-
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
-    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();  // vertices
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-    v->push_back( osg::Vec3( -3.0f, 0.0f, 0.0f ) );
-    v->push_back( osg::Vec3(  3.0f, 0.0f, 0.0f ) );
-
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-
-    c->push_back( osg::Vec4( 1.0f, 0.9f, 0.5f, 1.0f ) );
-    c->push_back( osg::Vec4( 1.0f, 0.9f, 0.5f, 0.1f ) );
-
-    geometry->setVertexArray( v.get() );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::LINES, 0, v->size() ) );
-
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
-
-    geode->addDrawable( geometry.get() );
-
-    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
+    _tracerStateSet = new osg::StateSet();
 
     osg::ref_ptr<osg::LineWidth> lineWidth = new osg::LineWidth();
     lineWidth->setWidth( linesWidth );
 
-    stateSet->setAttributeAndModes( lineWidth, osg::StateAttribute::ON );
+    _tracerStateSet->setAttributeAndModes( lineWidth, osg::StateAttribute::ON );
 
-    stateSet->setMode( GL_LIGHTING , osg::StateAttribute::OFF );
-    stateSet->setMode( GL_BLEND    , osg::StateAttribute::ON  );
-    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
+    _tracerStateSet->setMode( GL_LIGHTING , osg::StateAttribute::OFF );
+    _tracerStateSet->setMode( GL_BLEND    , osg::StateAttribute::ON  );
+    _tracerStateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 osg::Node* Models::get( const std::string &objectFile, bool straight )
 {
-    for ( unsigned int i = 0; i < instance()->_fileNames.size(); i++ )
-    {
-        if ( objectFile == instance()->_fileNames.at( i ) )
-        {
-            return instance()->_objects.at( i );
-        }
-    }
-
-    osg::ref_ptr<osg::Node> object = ( straight ) ? osgDB::readNodeFile( objectFile ) : readNodeFile( objectFile );
-
-    if ( object.valid() )
-    {
-        instance()->_objects.push_back( object.get() );
-        instance()->_fileNames.push_back( objectFile );
-
-        return object.get();
-    }
-    else
-    {
-        Log::e() << "Cannot open object file: " << objectFile << std::endl;
-    }
-
-    return 0;
+    return instance()->_objects.get( objectFile, [ objectFile, straight ]() { return read( objectFile, straight ); } );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -175,18 +112,34 @@ osg::Node* Models::readNodeFile( std::string objectFile )
 
 void Models::reset()
 {
-    instance()->_fileNames.clear();
     instance()->_objects.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Models::Models()
+void Models::request( const std::string &objectFile, bool straight )
 {
-    _fileNames.clear();
-    _objects.clear();
+    instance()->_objects.request( objectFile, [ objectFile, straight ]() { return read( objectFile, straight ); } );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+Models::Models() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Models::~Models() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* Models::read( const std::string &objectFile, bool straight )
+{
+    osg::ref_ptr<osg::Node> object = ( straight ) ? osgDB::readNodeFile( objectFile ) : readNodeFile( objectFile );
+
+    if ( !object.valid() )
+    {
+        Log::e() << "Cannot open object file: " << objectFile << std::endl;
+    }
+
+    return object.release();
+}
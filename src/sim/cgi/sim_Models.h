@@ -21,6 +21,9 @@
 
 #include <osg/LOD>
 #include <osg/NodeVisitor>
+#include <osg/StateSet>
+
+#include <sim/cgi/sim_Cache.h>
 
 #include <sim/utils/sim_Singleton.h>
 
@@ -53,23 +56,22 @@ public:
         void apply( osg::Node &searchNode );
     };
 
-    typedef std::vector< osg::ref_ptr<osg::Node> > List;
-
     /**
-     * Creates tracer bullet object.
+     * Creates tracer bullets state set.
      * @param linesWidth
      */
     static void createTracer( float linesWidth );
 
     /**
+     * Returns cached object, waits if it is still being read in background.
      * @param objectFile
      * @param straight
      * @return
      */
     static osg::Node* get( const std::string &objectFile, bool straight = false );
 
-    /** Returns tracer bullet object. */
-    inline static osg::LOD* getTracer() { return _tracer.get(); }
+    /** Returns tracer bullets state set. */
+    inline static osg::StateSet* getTracerStateSet() { return _tracerStateSet.get(); }
 
     /** Reads object from file. */
     static osg::Node* readNodeFile( std::string objectFile );
@@ -77,6 +79,13 @@ public:
     /** Resets object list. */
     static void reset();
 
+    /**
+     * Queues object to be read in background.
+     * @param objectFile
+     * @param straight
+     */
+    static void request( const std::string &objectFile, bool straight = false );
+
 private:
 
     /**
@@ -95,10 +104,12 @@ public:
 
 private:
 
-    List _objects;                          ///< objects list
-    std::vector< std::string > _fileNames;  ///< file names
+    Cache< osg::Node > _objects;            ///< objects cache
+
+    static osg::ref_ptr<osg::StateSet> _tracerStateSet;   ///< tracer bullets state set
 
-    static osg::ref_ptr<osg::LOD> _tracer;  ///< tracer bullet object
+    /** Reads object from file, used by objects cache. */
+    static osg::Node* read( const std::string &objectFile, bool straight );
 };
 
 } // end of sim namespace
@@ -0,0 +1,183 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/cgi/sim_PagedTerrain.h>
+
+#include <stdio.h>
+
+#include <limits>
+
+#include <osg/Group>
+#include <osg/PagedLOD>
+
+#include <osgDB/FileNameUtils>
+#include <osgDB/ReadFile>
+#include <osgDB/Registry>
+
+#include <sim/sim_Log.h>
+
+#include <sim/cgi/sim_Models.h>
+
+#include <sim/utils/sim_String.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char PagedTerrain::_extension[] = "sim_tiles";
+const float PagedTerrain::_rangeCoef = 1.5f;
+
+osg::ref_ptr<PagedTerrain::ReaderWriter> PagedTerrain::_readerWriter;
+
+////////////////////////////////////////////////////////////////////////////////
+
+PagedTerrain::ReaderWriter::ReaderWriter()
+{
+    supportsExtension( _extension, "Paged terrain children tiles pseudo-loader" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* PagedTerrain::ReaderWriter::className() const
+{
+    return "Paged terrain children tiles pseudo-loader";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osgDB::ReaderWriter::ReadResult PagedTerrain::ReaderWriter::readNode( const std::string &fileName,
+                                                                      const osgDB::Options *options ) const
+{
+    if ( !acceptsExtension( osgDB::getLowerCaseFileExtension( fileName ) ) || !options )
+    {
+        return ReadResult::FILE_NOT_HANDLED;
+    }
+
+    std::string dir = osgDB::getFilePath( fileName );
+
+    int level = 0;
+    int ix = 0;
+    int iy = 0;
+
+    if ( 3 != sscanf( osgDB::getSimpleFileName( fileName ).c_str(), "%d_%d_%d", &level, &ix, &iy ) )
+    {
+        return ReadResult::FILE_NOT_HANDLED;
+    }
+
+    osg::ref_ptr<osg::Group> group = new osg::Group();
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        int ix_child = 2 * ix + i % 2;
+        int iy_child = 2 * iy + i / 2;
+
+        std::string tileFile = getTileFile( dir, level + 1, ix_child, iy_child );
+
+        // tiles are not cached, they are released together with their parent
+        osg::ref_ptr<osg::Node> node = osgDB::readNodeFile( tileFile );
+
+        if ( node.valid() )
+        {
+            group->addChild( createTile( node.get(), options, dir, level + 1, ix_child, iy_child ) );
+        }
+        else
+        {
+            Log::e() << "Cannot open terrain tile file: " << tileFile << std::endl;
+        }
+    }
+
+    return group.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* PagedTerrain::create( const std::string &dir, int levels, float size )
+{
+    if ( !_readerWriter.valid() )
+    {
+        _readerWriter = new ReaderWriter();
+        osgDB::Registry::instance()->addReaderWriter( _readerWriter.get() );
+    }
+
+    osg::ref_ptr<osg::Node> node = Models::get( getTileFile( dir, 0, 0, 0 ), true );
+
+    if ( !node.valid() )
+    {
+        return NULLPTR;
+    }
+
+    osg::ref_ptr<osgDB::Options> options = new osgDB::Options();
+
+    options->setPluginStringData( "levels" , String::toString( levels ) );
+    options->setPluginStringData( "size"   , String::toString( size   ) );
+
+    return createTile( node.get(), options.get(), dir, 0, 0, 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string PagedTerrain::getTileFile( const std::string &dir, int level, int ix, int iy )
+{
+    char name[ 64 ];
+
+    sprintf( name, "%d_%d_%d.osgb", level, ix, iy );
+
+    return osgDB::concatPaths( dir, name );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* PagedTerrain::createTile( osg::Node *node, const osgDB::Options *options,
+                                     const std::string &dir, int level, int ix, int iy )
+{
+    int levels = String::toInt( options->getPluginStringData( "levels" ) );
+    float size = String::toFloat( options->getPluginStringData( "size" ) );
+
+    if ( level + 1 >= levels )
+    {
+        return node;
+    }
+
+    const float tileSize = size / (float)( 1 << level );
+    const float range = _rangeCoef * tileSize;
+
+    const float x = -0.5f * size + ( ix + 0.5f ) * tileSize;
+    const float y = -0.5f * size + ( iy + 0.5f ) * tileSize;
+
+    char name[ 64 ];
+
+    sprintf( name, "%d_%d_%d.%s", level, ix, iy, _extension );
+
+    osg::ref_ptr<osg::PagedLOD> lod = new osg::PagedLOD();
+
+    // range is computed from tile center, bound includes tile model
+    lod->setCenterMode( osg::LOD::UNION_OF_BOUNDING_SPHERE_AND_USER_DEFINED );
+    lod->setCenter( osg::Vec3( x, y, 0.0f ) );
+    lod->setRadius( 0.5f * M_SQRT2 * tileSize );
+
+    lod->addChild( node, range, std::numeric_limits< float >::max() );
+
+    lod->setFileName( 1, osgDB::concatPaths( dir, name ) );
+    lod->setRange( 1, 0.0f, range );
+
+    lod->setDatabaseOptions( const_cast< osgDB::Options* >( options ) );
+    lod->setNumChildrenThatCannotBeExpired( 1 );
+
+    return lod.release();
+}
@@ -0,0 +1,107 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_PAGEDTERRAIN_H
+#define SIM_PAGEDTERRAIN_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+
+#include <osg/Node>
+
+#include <osgDB/Options>
+#include <osgDB/ReaderWriter>
+
+#include <sim/sim_Base.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Paged terrain class.
+ *
+ * Terrain is divided into quadtree of tiles stored in single directory as
+ * "<level>_<ix>_<iy>.osgb" files, level 0 tile covers the whole terrain and
+ * every next level halves tiles size. Tiles vertices are expressed in world
+ * frame. Tile is replaced with its 4 children tiles when camera is closer
+ * than _rangeCoef tile sizes. Children tiles are read in background and
+ * released when no longer visible by OSG database pager threads, so memory
+ * usage and load time depend on view range rather than on terrain size.
+ */
+class PagedTerrain : public Base
+{
+public:
+
+    static const char _extension[];     ///< children tiles pseudo-file extension
+    static const float _rangeCoef;      ///< children tiles range expressed in tile sizes
+
+    /** @brief Children tiles pseudo-loader, used by database pager threads. */
+    class ReaderWriter : public osgDB::ReaderWriter
+    {
+    public:
+
+        /** @brief Constructor. */
+        ReaderWriter();
+
+        /** @brief Returns class name. */
+        virtual const char* className() const;
+
+        /** @brief Reads children tiles of the tile given by pseudo-file name. */
+        virtual ReadResult readNode( const std::string &fileName,
+                                     const osgDB::Options *options ) const;
+    };
+
+    /**
+     * @brief Creates paged terrain.
+     * @param dir tiles directory
+     * @param levels number of quadtree levels
+     * @param size [m] terrain side length
+     * @return terrain root node or null if level 0 tile cannot be read
+     */
+    static osg::Node* create( const std::string &dir, int levels, float size );
+
+    /**
+     * @brief Returns tile file name.
+     * @param dir tiles directory
+     * @param level tile level
+     * @param ix tile index along x-axis
+     * @param iy tile index along y-axis
+     * @return tile file name
+     */
+    static std::string getTileFile( const std::string &dir, int level, int ix, int iy );
+
+private:
+
+    static osg::ref_ptr<ReaderWriter> _readerWriter;    ///< registered children tiles pseudo-loader
+
+    /**
+     * @brief Creates tile node.
+     * @param node tile model
+     * @param options tile options (terrain levels and size)
+     * @return tile node, either paged LOD or tile model if tile is at the last level
+     */
+    static osg::Node* createTile( osg::Node *node, const osgDB::Options *options,
+                                  const std::string &dir, int level, int ix, int iy );
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_PAGEDTERRAIN_H
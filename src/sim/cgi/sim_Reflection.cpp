@@ -0,0 +1,258 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/cgi/sim_Reflection.h>
+
+#include <osg/ClipNode>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/LOD>
+#include <osg/MatrixTransform>
+#include <osg/Program>
+
+#include <sim/cgi/sim_Textures.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const float Reflection::_level = 0.1f;
+
+const char Reflection::_frag[] =
+    "uniform sampler2D reflection;\n"
+    "uniform sampler2D refraction;\n"
+    "uniform sampler2D normalTex;\n"
+    "varying vec4 projCoords;\n"
+    "varying vec3 lightDir, eyeDir;\n"
+    "varying vec2 flowCoords, rippleCoords;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   vec2 rippleEffect = 0.02 * texture2D(refraction, rippleCoords * 0.1).xy;\n"
+    "   vec4 N = texture2D(reflection, flowCoords + rippleEffect);\n"
+    "   N = N * 2.0 - vec4(1.0);\n"
+    "   N.a = 1.0; N = normalize(N);\n"
+    "\n"
+    "   vec3 refVec = normalize(reflect(-lightDir, vec3(N) * 0.6));\n"
+    "   float refAngle = clamp(dot(eyeDir, refVec), 0.0, 1.0);\n"
+    "   vec4 specular = vec4(pow(refAngle, 40.0));\n"
+    "\n"
+    "   vec2 dist = texture2D(refraction, flowCoords + rippleEffect).xy;\n"
+    "   float dist_inv = 1.0 / sqrt( dist.x*dist.x + dist.y*dist.y );\n"
+    "   dist = (dist * 2.0 - vec2(1.0)) * dist_inv * 0.02;\n"
+    "   vec2 uv = projCoords.xy / projCoords.w;\n"
+    "   uv = clamp((uv + 1.0) * 0.5 + dist, 0.0, 1.0);\n"
+    "\n"
+    "   vec4 refl = texture2D(reflection, uv);\n"
+    "   refl.w = refl.w * 0.4;\n"
+    "   gl_FragColor = mix(refl, refl + specular, 0.6);\n"
+    "}\n"
+    "\n";
+
+const char Reflection::_vert[] =
+    "uniform float osg_FrameTime;\n"
+    "varying vec4 projCoords;\n"
+    "varying vec3 lightDir, eyeDir;\n"
+    "varying vec2 flowCoords, rippleCoords;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   vec3 T = vec3(0.0, 1.0, 0.0);\n"
+    "   vec3 N = vec3(0.0, 0.0, 1.0);\n"
+    "   vec3 B = vec3(1.0, 0.0, 0.0);\n"
+    "   T = normalize(gl_NormalMatrix * T);\n"
+    "   B = normalize(gl_NormalMatrix * B);\n"
+    "   N = normalize(gl_NormalMatrix * N);\n"
+    "\n"
+    "   mat3 TBNmat;\n"
+    "   TBNmat[0][0] = T[0]; TBNmat[1][0] = T[1]; TBNmat[2][0] = T[2];\n"
+    "   TBNmat[0][1] = B[0]; TBNmat[1][1] = B[1]; TBNmat[2][1] = B[2];\n"
+    "   TBNmat[0][2] = N[0]; TBNmat[1][2] = N[1]; TBNmat[2][2] = N[2];\n"
+    "\n"
+    "   vec3 vertexInEye = vec3(gl_ModelViewMatrix * gl_Vertex);\n"
+    "   lightDir =  gl_LightSource[0].position.xyz - vertexInEye;\n"
+    "   lightDir = normalize(TBNmat * lightDir);\n"
+    "   eyeDir = normalize(TBNmat * (-vertexInEye));\n"
+    "\n"
+    "   vec2 t1 = vec2(osg_FrameTime*0.02, osg_FrameTime*0.02);\n"
+    "   vec2 t2 = vec2(osg_FrameTime*0.05, osg_FrameTime*0.05);\n"
+    "   flowCoords = gl_MultiTexCoord0.xy * 5.0 + t1;\n"
+    "   rippleCoords = gl_MultiTexCoord0.xy * 10.0 + t2;\n"
+    "\n"
+    "   gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+    "   gl_Position = ftransform();\n"
+    "   projCoords = gl_Position;\n"
+    "}\n"
+    "\n";
+
+osg::ref_ptr<osg::Camera>    Reflection::_camera;
+osg::ref_ptr<osg::Group>     Reflection::_models;
+osg::ref_ptr<osg::Texture2D> Reflection::_texture;
+osg::ref_ptr<osg::StateSet>  Reflection::_stateSet;
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::PositionAttitudeTransform* Reflection::addModel( osg::Node *model )
+{
+    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
+    pat->addChild( model );
+
+    addModel( pat.get() );
+
+    return pat.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Reflection::addModel( osg::PositionAttitudeTransform *pat )
+{
+    getNode();
+
+    _models->addChild( pat );
+    _camera->setNodeMask( 0xffffffff );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* Reflection::createWater( osg::Node *model )
+{
+    getNode();
+
+    if ( !_stateSet.valid() )
+    {
+        osg::ref_ptr<osg::Texture2D> texWaterDUDV = Textures::get( Path::get( "textures/water_DUDV.png" ) );
+        texWaterDUDV->setWrap( osg::Texture::WRAP_S, osg::Texture::REPEAT );
+        texWaterDUDV->setWrap( osg::Texture::WRAP_T, osg::Texture::REPEAT );
+        texWaterDUDV->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR );
+        texWaterDUDV->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+
+        osg::ref_ptr<osg::Texture2D> texWaterNM = Textures::get( Path::get( "textures/water_NM.png" ) );
+        texWaterNM->setWrap( osg::Texture::WRAP_S, osg::Texture::REPEAT );
+        texWaterNM->setWrap( osg::Texture::WRAP_T, osg::Texture::REPEAT );
+        texWaterNM->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR );
+        texWaterNM->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+
+        _stateSet = new osg::StateSet();
+        _stateSet->setTextureAttributeAndModes( 0, _texture.get() );
+        _stateSet->setTextureAttributeAndModes( 1, texWaterDUDV.get() );
+        _stateSet->setTextureAttributeAndModes( 2, texWaterNM.get() );
+
+        osg::ref_ptr<osg::Program> program = new osg::Program();
+        program->addShader( new osg::Shader( osg::Shader::VERTEX   , _vert ) );
+        program->addShader( new osg::Shader( osg::Shader::FRAGMENT , _frag ) );
+        _stateSet->setAttributeAndModes( program.get() );
+        _stateSet->addUniform( new osg::Uniform("reflection", 0) );
+        _stateSet->addUniform( new osg::Uniform("refraction", 1) );
+        _stateSet->addUniform( new osg::Uniform("normalTex", 2) );
+    }
+
+    const osg::Vec3& center = model->getBound().center();
+    float planeSize = 500.0f;
+
+    osg::Vec3 planeCorner( center.x() - 0.5f*planeSize, center.y() - 0.5f*planeSize, _level );
+
+    osg::ref_ptr<osg::Geometry> quad = osg::createTexturedQuadGeometry(
+                planeCorner,
+                osg::Vec3( planeSize, 0.0f, 0.0f ),
+                osg::Vec3( 0.0f, planeSize, 0.0f ) );
+
+    osg::ref_ptr<osg::Geode> geodeQuad = new osg::Geode;
+    geodeQuad->addDrawable( quad.get() );
+    geodeQuad->setStateSet( _stateSet.get() );
+
+    osg::ref_ptr<osg::LOD> lodWater = new osg::LOD();
+    lodWater->addChild( geodeQuad.get(), 0.0f, 10000.0f );
+
+    return lodWater.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Group* Reflection::getNode()
+{
+    if ( !_camera.valid() )
+    {
+        // models are mirrored about reflection plane in world frame
+        osg::ref_ptr<osg::MatrixTransform> reverse = new osg::MatrixTransform;
+        reverse->preMult( osg::Matrix::translate(0.0f, 0.0f, -_level) *
+                          osg::Matrix::scale(1.0f, 1.0f, -1.0f) *
+                          osg::Matrix::translate(0.0f, 0.0f, _level) );
+
+        _models = new osg::Group();
+        reverse->addChild( _models.get() );
+
+        osg::ref_ptr<osg::ClipPlane> clipPlane = new osg::ClipPlane;
+        clipPlane->setClipPlane( 0.0, 0.0, -1.0, _level );
+        clipPlane->setClipPlaneNum( 0 );
+
+        osg::ref_ptr<osg::ClipNode> clipNode = new osg::ClipNode;
+        clipNode->addClipPlane( clipPlane.get() );
+        clipNode->addChild( reverse.get() );
+
+        _texture = new osg::Texture2D();
+        _texture->setTextureSize( 1024, 1024 );
+        _texture->setInternalFormat( GL_RGBA );
+        _texture->setFilter( osg::Texture2D::MIN_FILTER, osg::Texture2D::LINEAR );
+        _texture->setFilter( osg::Texture2D::MAG_FILTER, osg::Texture2D::LINEAR );
+
+        // camera inherits current view and projection
+        _camera = new osg::Camera();
+
+        _camera->setClearColor( osg::Vec4() );
+        _camera->setClearMask( GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT );
+        _camera->setRenderTargetImplementation( osg::Camera::FRAME_BUFFER_OBJECT );
+        _camera->setRenderOrder( osg::Camera::PRE_RENDER );
+
+        _camera->setViewport( 0, 0, _texture->getTextureWidth(), _texture->getTextureHeight() );
+        _camera->attach( osg::Camera::COLOR_BUFFER, _texture.get() );
+
+        _camera->addChild( clipNode.get() );
+
+        // there is no reflection pass until any model is added
+        _camera->setNodeMask( 0 );
+    }
+
+    return _camera.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Reflection::removeModel( osg::PositionAttitudeTransform *pat )
+{
+    if ( _models.valid() )
+    {
+        _models->removeChild( pat );
+
+        if ( _models->getNumChildren() == 0 )
+        {
+            _camera->setNodeMask( 0 );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Reflection::reset()
+{
+    if ( _models.valid() )
+    {
+        _models->removeChildren( 0, _models->getNumChildren() );
+        _camera->setNodeMask( 0 );
+    }
+}
@@ -0,0 +1,92 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_REFLECTION_H
+#define SIM_REFLECTION_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <osg/Camera>
+#include <osg/Group>
+#include <osg/PositionAttitudeTransform>
+#include <osg/StateSet>
+#include <osg/Texture2D>
+
+#include <sim/sim_Base.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Water reflection class.
+ *
+ * All marine units share single sea level planar reflection. Reflected models
+ * are rendered once per frame by single pre-render camera from the current
+ * view, water planes placed around units sample its texture.
+ */
+class Reflection : public Base
+{
+public:
+
+    static const float _level;      ///< [m] reflection plane level
+
+    static const char _frag[];      ///<
+    static const char _vert[];      ///<
+
+    /**
+     * @brief Adds model to the shared reflection.
+     * @param model model node
+     * @return reflected model transform, its position and attitude should follow model
+     */
+    static osg::PositionAttitudeTransform* addModel( osg::Node *model );
+
+    /**
+     * @brief Adds reflected model transform to the shared reflection.
+     * @param pat reflected model transform containing model
+     */
+    static void addModel( osg::PositionAttitudeTransform *pat );
+
+    /**
+     * @brief Creates water plane sampling shared reflection texture.
+     * @param model model node the water plane is placed around
+     * @return water plane node, it must be placed in model frame
+     */
+    static osg::Node* createWater( osg::Node *model );
+
+    /** @brief Returns shared reflection node, it must be placed in world frame. */
+    static osg::Group* getNode();
+
+    /** @brief Removes reflected model transform returned by addModel(). */
+    static void removeModel( osg::PositionAttitudeTransform *pat );
+
+    /** @brief Removes all reflected models. */
+    static void reset();
+
+private:
+
+    static osg::ref_ptr<osg::Camera> _camera;       ///< reflection pre-render camera
+    static osg::ref_ptr<osg::Group> _models;        ///< reflected models group
+    static osg::ref_ptr<osg::Texture2D> _texture;   ///< reflection texture
+    static osg::ref_ptr<osg::StateSet> _stateSet;   ///< water planes state set
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_REFLECTION_H
@@ -0,0 +1,154 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/cgi/sim_SceneQueue.h>
+
+#include <sim/cgi/sim_Reflection.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+SceneQueue::Changes SceneQueue::_changes;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SceneQueue::addChild( osg::Group *parent, osg::Node *child )
+{
+    push( AddChild, parent, child );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SceneQueue::addReflection( osg::PositionAttitudeTransform *pat )
+{
+    push( AddReflection, 0, pat );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SceneQueue::removeChild( osg::Group *parent, osg::Node *child )
+{
+    push( RemoveChild, parent, child );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SceneQueue::removeInstance( Instances::Instance *instance )
+{
+    if ( instance )
+    {
+        Change change;
+
+        change.type     = RemoveInstance;
+        change.instance = instance;
+        change.value    = false;
+
+        _changes.push_back( change );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SceneQueue::removeReflection( osg::PositionAttitudeTransform *pat )
+{
+    push( RemoveReflection, 0, pat );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SceneQueue::setAllChildren( osg::Switch *parent, bool value )
+{
+    push( SetAllChildren, parent, 0, value );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SceneQueue::setChildValue( osg::Switch *parent, osg::Node *child, bool value )
+{
+    push( SetChildValue, parent, child, value );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SceneQueue::apply()
+{
+    for ( Changes::iterator it = _changes.begin(); it != _changes.end(); ++it )
+    {
+        osg::Switch *parentSwitch = dynamic_cast< osg::Switch* >( it->parent.get() );
+
+        switch ( it->type )
+        {
+        case AddChild:
+            it->parent->addChild( it->child.get() );
+            break;
+
+        case AddReflection:
+            Reflection::addModel( dynamic_cast< osg::PositionAttitudeTransform* >( it->child.get() ) );
+            break;
+
+        case RemoveChild:
+            it->parent->removeChild( it->child.get() );
+            break;
+
+        case RemoveInstance:
+            Instances::remove( it->instance.get() );
+            break;
+
+        case RemoveReflection:
+            Reflection::removeModel( dynamic_cast< osg::PositionAttitudeTransform* >( it->child.get() ) );
+            break;
+
+        case SetAllChildren:
+            if ( parentSwitch )
+            {
+                if ( it->value )
+                    parentSwitch->setAllChildrenOn();
+                else
+                    parentSwitch->setAllChildrenOff();
+            }
+            break;
+
+        case SetChildValue:
+            if ( parentSwitch ) parentSwitch->setChildValue( it->child.get(), it->value );
+            break;
+        }
+    }
+
+    _changes.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SceneQueue::push( Type type, osg::Group *parent, osg::Node *child, bool value )
+{
+    bool reflection = ( type == AddReflection || type == RemoveReflection );
+
+    if ( ( parent || reflection ) && ( child || type == SetAllChildren ) )
+    {
+        Change change;
+
+        change.type   = type;
+        change.parent = parent;
+        change.child  = child;
+        change.value  = value;
+
+        _changes.push_back( change );
+    }
+}
@@ -0,0 +1,109 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_SCENEQUEUE_H
+#define SIM_SCENEQUEUE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <osg/Group>
+#include <osg/PositionAttitudeTransform>
+#include <osg/Switch>
+
+#include <sim/cgi/sim_Instances.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Scene graph changes queue class.
+ *
+ * Simulation steps may run concurrently with rendering, so they must not
+ * modify scene graph being drawn. Structural changes requested during
+ * simulation step (nodes added, removed, switched on or off) are queued
+ * and applied on the view side before the view is updated.
+ *
+ * Queued nodes are referenced until changes are applied.
+ */
+class SceneQueue
+{
+public:
+
+    /** @brief Queues adding child node to the parent group. */
+    static void addChild( osg::Group *parent, osg::Node *child );
+
+    /** @brief Queues adding reflected model transform, the same as Reflection::addModel(). */
+    static void addReflection( osg::PositionAttitudeTransform *pat );
+
+    /** @brief Queues removing child node from the parent group. */
+    static void removeChild( osg::Group *parent, osg::Node *child );
+
+    /** @brief Queues removing instance, the same as Instances::remove(). */
+    static void removeInstance( Instances::Instance *instance );
+
+    /** @brief Queues removing reflected model, the same as Reflection::removeModel(). */
+    static void removeReflection( osg::PositionAttitudeTransform *pat );
+
+    /** @brief Queues setting all switch children on or off. */
+    static void setAllChildren( osg::Switch *parent, bool value );
+
+    /** @brief Queues setting switch child node value. */
+    static void setChildValue( osg::Switch *parent, osg::Node *child, bool value );
+
+    /** @brief Applies queued changes in order, must be called on the view side. */
+    static void apply();
+
+private:
+
+    /** Queued change type. */
+    enum Type
+    {
+        AddChild = 0,                   ///< add child
+        AddReflection,                  ///< add reflected model
+        RemoveChild,                    ///< remove child
+        RemoveInstance,                 ///< remove instance
+        RemoveReflection,               ///< remove reflected model
+        SetAllChildren,                 ///< set all switch children
+        SetChildValue                   ///< set switch child value
+    };
+
+    /** Queued change data struct. */
+    struct Change
+    {
+        Type type;                                      ///< change type
+        osg::ref_ptr<osg::Group> parent;                ///< parent group
+        osg::ref_ptr<osg::Node> child;                  ///< child node
+        osg::ref_ptr<Instances::Instance> instance;     ///< instance
+        bool value;                                     ///< switch value
+    };
+
+    typedef std::vector< Change > Changes;
+
+    static Changes _changes;    ///< queued changes
+
+    /** Queues change. */
+    static void push( Type type, osg::Group *parent, osg::Node *child, bool value = true );
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_SCENEQUEUE_H
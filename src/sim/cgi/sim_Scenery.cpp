@@ -17,17 +17,25 @@
 
 #include <sim/cgi/sim_Scenery.h>
 
+#include <osg/Depth>
+#include <osg/PolygonOffset>
+
 #ifdef SIM_DESKTOP
-#   include <osg/Geode>
-#   include <osg/Geometry>
 #   include <osg/Material>
 #   include <osg/TexEnv>
 #endif
 
+#include <sim/sim_Elevation.h>
+
 #include <sim/cgi/sim_Models.h>
+#include <sim/cgi/sim_PagedTerrain.h>
 #include <sim/cgi/sim_Textures.h>
 
+#include <sim/entities/sim_Entities.h>
+
+#include <sim/utils/sim_Angles.h>
 #include <sim/utils/sim_Misc.h>
+#include <sim/utils/sim_Profiler.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -40,10 +48,18 @@ const float Scenery::_size   = 2.0f * Scenery::_size_2;
 const float Scenery::_limit  = Scenery::_size_2 - SIM_SKYDOME_RAD;
 
 std::string Scenery::_terrainFile = "scenery/ocean.osgb";
+int Scenery::_terrainLevels = 0;
+int Scenery::_terrainTiles = 1;
 std::string Scenery::_genericFile = "scenery/ocean.osgb";
 
 Scenery::ObjectFiles Scenery::_objectFiles;
 
+#ifdef SIM_DESKTOP
+ShadowType Scenery::_shadowType = ShadowOverlay;
+#else
+ShadowType Scenery::_shadowType = ShadowOff;
+#endif
+
 osg::ref_ptr<osg::Node> Scenery::_terrainNode = 0;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -51,14 +67,26 @@ osg::ref_ptr<osg::Node> Scenery::_terrainNode = 0;
 Scenery::Scenery( Module *parent ) :
     Module( new osg::Group(), parent ),
 
-    _counter ( 100 )
+    _counter ( 100 ),
+    _counterShadow ( 0 )
 {
 #   ifdef SIM_DESKTOP
-    osgSim::OverlayNode::OverlayTechnique technique = osgSim::OverlayNode::OBJECT_DEPENDENT_WITH_ORTHOGRAPHIC_OVERLAY;
-    _root = _overlayNode = new osgSim::OverlayNode( technique );
+    if ( _shadowType == ShadowOverlay )
+    {
+        osgSim::OverlayNode::OverlayTechnique technique = osgSim::OverlayNode::OBJECT_DEPENDENT_WITH_ORTHOGRAPHIC_OVERLAY;
+        _root = _overlayNode = new osgSim::OverlayNode( technique );
+
+        _overlayNode->getOrCreateStateSet()->setTextureAttribute( 1, new osg::TexEnv( osg::TexEnv::DECAL ) );
 
-    _overlayNode->getOrCreateStateSet()->setTextureAttribute( 1, new osg::TexEnv( osg::TexEnv::DECAL ) );
-    _overlayNode->setContinuousUpdate( true );
+        // overlay texture is rendered only when dirty (see updateShadowOverlay())
+        _overlayNode->setContinuousUpdate( false );
+    }
+#   else
+    // overlay node is not available on mobile devices
+    if ( _shadowType == ShadowOverlay )
+    {
+        _shadowType = ShadowBlob;
+    }
 #   endif
 
     _root->setName( "scenery" );
@@ -67,8 +95,16 @@ Scenery::Scenery( Module *parent ) :
     createObjects();
     createGeneric();
 
+    if ( _shadowType == ShadowBlob )
+    {
+        createShadowBlobs();
+    }
+
 #   ifdef SIM_DESKTOP
-    createShadow();
+    if ( _overlayNode.valid() )
+    {
+        createShadowOverlay();
+    }
 #   endif
 }
 
@@ -91,6 +127,11 @@ void Scenery::load()
     loadTerrain();
     createObjects();
     createGeneric();
+
+    if ( _blobs.valid() )
+    {
+        _root->addChild( _blobs.get() );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -101,19 +142,30 @@ void Scenery::update()
     Module::update();
     /////////////////
 
+    if ( _blobs.valid() )
+    {
+        Profiler::Scope scope( "shadow.blob" );
+        updateShadowBlobs();
+    }
+
 #   ifdef SIM_DESKTOP
-    _mt->setMatrix( osg::Matrixd::rotate( osg::Quat( -Data::get()->ownship.heading, osg::Z_AXIS ) )
-                  * osg::Matrixd::translate( osg::Vec3( Data::get()->ownship.pos_x,
-                                                        Data::get()->ownship.pos_y,
-                                                        0.0f ) ) );
+    if ( _overlayNode.valid() )
+    {
+        Profiler::Scope scope( "shadow.overlay" );
+        updateShadowOverlay();
+    }
 #   endif
 
     if ( _counter == 100 )
     {
         _counter = 0;
 
-        if ( fabs( Data::get()->camera.pos_x ) > _limit
-          || fabs( Data::get()->camera.pos_y ) > _limit )
+        // terrain may span more than one generic tile
+        const short n = _terrainTiles / 2;
+        const float limit = _limit + n * _size;
+
+        if ( fabs( Data::view()->camera.pos_x ) > limit
+          || fabs( Data::view()->camera.pos_y ) > limit )
         {
             _switchGeneric->setValue( 1, true );
             _switchGeneric->setValue( 2, true );
@@ -122,34 +174,34 @@ void Scenery::update()
             short ix = 0;
             short iy = 0;
 
-            if ( fabs( Data::get()->camera.pos_x ) > _size_2 )
+            if ( fabs( Data::view()->camera.pos_x ) > _size_2 )
             {
-                if ( Data::get()->camera.pos_x > 0.0 )
+                if ( Data::view()->camera.pos_x > 0.0 )
                 {
-                    ix = ( Data::get()->camera.pos_x - _size_2 ) / _size + 1;
+                    ix = ( Data::view()->camera.pos_x - _size_2 ) / _size + 1;
                 }
                 else
                 {
-                    ix = ( Data::get()->camera.pos_x + _size_2 ) / _size - 1;
+                    ix = ( Data::view()->camera.pos_x + _size_2 ) / _size - 1;
                 }
             }
 
-            if ( fabs( Data::get()->camera.pos_y ) > _size_2 )
+            if ( fabs( Data::view()->camera.pos_y ) > _size_2 )
             {
-                if ( Data::get()->camera.pos_y > 0.0 )
+                if ( Data::view()->camera.pos_y > 0.0 )
                 {
-                    iy = ( Data::get()->camera.pos_y - _size_2 ) / _size + 1;
+                    iy = ( Data::view()->camera.pos_y - _size_2 ) / _size + 1;
                 }
                 else
                 {
-                    iy = ( Data::get()->camera.pos_y + _size_2 ) / _size - 1;
+                    iy = ( Data::view()->camera.pos_y + _size_2 ) / _size - 1;
                 }
             }
 
             float xc = ix * _size;
             float yc = iy * _size;
 
-            if ( ix == 0 && iy == 0 )
+            if ( abs( ix ) <= n && abs( iy ) <= n )
             {
                 _switchGeneric->setValue( 0, false );
             }
@@ -160,12 +212,12 @@ void Scenery::update()
                 _pat_0->setPosition( osg::Vec3d( xc, yc, 0.0 ) );
             }
 
-            short dix = Misc::sign( Data::get()->camera.pos_x - xc );
-            short diy = Misc::sign( Data::get()->camera.pos_y - yc );
+            short dix = Misc::sign( Data::view()->camera.pos_x - xc );
+            short diy = Misc::sign( Data::view()->camera.pos_y - yc );
 
-            setPositionC( xc, yc, ix, iy, dix, diy );
-            setPositionX( xc, yc, ix, iy, dix );
-            setPositionY( xc, yc, ix, iy, diy );
+            setPositionC( xc, yc, ix, iy, dix, diy, n );
+            setPositionX( xc, yc, ix, iy, dix, n );
+            setPositionY( xc, yc, ix, iy, diy, n );
         }
         else
         {
@@ -213,8 +265,54 @@ void Scenery::createObjects()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Scenery::createShadowBlobs()
+{
+    _blobs = new osg::Geode();
+    _root->addChild( _blobs.get() );
+
+    _blobsGeom = new osg::Geometry();
+    _blobs->addDrawable( _blobsGeom.get() );
+
+    _blobsV = new osg::Vec3Array();
+    _blobsC = new osg::Vec4Array();
+    _blobsT = new osg::Vec2Array();
+
+    _blobsDraw = new osg::DrawArrays( osg::PrimitiveSet::QUADS, 0, 0 );
+
+    _blobsGeom->setDataVariance( osg::Object::DYNAMIC );
+    _blobsGeom->setUseDisplayList( false );
+    _blobsGeom->setUseVertexBufferObjects( true );
+
+    _blobsGeom->setVertexArray( _blobsV.get() );
+    _blobsGeom->addPrimitiveSet( _blobsDraw.get() );
+
+    _blobsGeom->setColorArray( _blobsC.get() );
+    _blobsGeom->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+
+    _blobsGeom->setTexCoordArray( 0, _blobsT.get() );
+
+    osg::ref_ptr<osg::StateSet> stateSet = _blobs->getOrCreateStateSet();
+
+    osg::ref_ptr<osg::Depth> depth = new osg::Depth();
+    depth->setWriteMask( false );
+
+    stateSet->setAttributeAndModes( depth.get(), osg::StateAttribute::ON );
+    stateSet->setAttributeAndModes( new osg::PolygonOffset( -1.0f, -1.0f ), osg::StateAttribute::ON );
+
+    stateSet->setMode( GL_LIGHTING , osg::StateAttribute::OFF );
+    stateSet->setMode( GL_BLEND    , osg::StateAttribute::ON  );
+
+    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
+    stateSet->setRenderBinDetails( SIM_DEPTH_SORTED_BIN_OTHER, "DepthSortedBin" );
+
+    osg::ref_ptr<osg::Texture2D> texture = Textures::get( getPath( "textures/shadow.png" ) );
+    stateSet->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 #ifdef SIM_DESKTOP
-void Scenery::createShadow()
+void Scenery::createShadowOverlay()
 {
     const double w_2 = 8.0;
     const double l_2 = 8.0;
@@ -292,7 +390,16 @@ void Scenery::loadGeneric()
 
 void Scenery::loadTerrain()
 {
-    osg::ref_ptr<osg::Node> terrain = Models::get( getPath( _terrainFile ), true );
+    osg::ref_ptr<osg::Node> terrain = 0;
+
+    if ( _terrainLevels > 0 )
+    {
+        terrain = PagedTerrain::create( getPath( _terrainFile ), _terrainLevels, _terrainTiles * _size );
+    }
+    else
+    {
+        terrain = Models::get( getPath( _terrainFile ), true );
+    }
 
     if ( terrain.valid() )
     {
@@ -304,15 +411,15 @@ void Scenery::loadTerrain()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Scenery::setPositionC( float xc, float yc, short ix, short iy, short dix, short diy )
+void Scenery::setPositionC( float xc, float yc, short ix, short iy, short dix, short diy, short n )
 {
-    if ( ix + dix == 0 && iy + diy == 0 )
+    if ( abs( ix + dix ) <= n && abs( iy + diy ) <= n )
     {
-        if ( dix < 0 ) dix -= 2;
-        else           dix += 2;
+        if ( dix < 0 ) dix -= 2 * n + 2;
+        else           dix += 2 * n + 2;
 
-        if ( diy < 0 ) diy -= 2;
-        else           diy += 2;
+        if ( diy < 0 ) diy -= 2 * n + 2;
+        else           diy += 2 * n + 2;
     }
 
     _pat_c->setPosition( osg::Vec3d( xc + dix * _size, yc + diy * _size, 0.0 ) );
@@ -320,12 +427,12 @@ void Scenery::setPositionC( float xc, float yc, short ix, short iy, short dix, s
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Scenery::setPositionX( float xc, float yc, short ix, short iy, short dix )
+void Scenery::setPositionX( float xc, float yc, short ix, short iy, short dix, short n )
 {
-    if ( ix + dix == 0 && iy == 0 )
+    if ( abs( ix + dix ) <= n && abs( iy ) <= n )
     {
-        if ( dix < 0 ) dix -= 2;
-        else           dix += 2;
+        if ( dix < 0 ) dix -= 2 * n + 2;
+        else           dix += 2 * n + 2;
     }
 
     _pat_x->setPosition( osg::Vec3d( xc + dix * _size, yc, 0.0 ) );
@@ -333,14 +440,101 @@ void Scenery::setPositionX( float xc, float yc, short ix, short iy, short dix )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Scenery::setPositionY( float xc, float yc, short ix, short iy, short diy )
+void Scenery::setPositionY( float xc, float yc, short ix, short iy, short diy, short n )
 {
-    if ( iy + diy == 0 && ix == 0 )
+    if ( abs( iy + diy ) <= n && abs( ix ) <= n )
     {
-        if ( diy < 0 ) diy -= 2;
-        else           diy += 2;
+        if ( diy < 0 ) diy -= 2 * n + 2;
+        else           diy += 2 * n + 2;
     }
 
     _pat_y->setPosition( osg::Vec3d( xc, yc + diy * _size, 0.0 ) );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenery::updateShadowBlobs()
+{
+    _blobsV->clear();
+    _blobsC->clear();
+    _blobsT->clear();
+
+    const Entities::Units *units = Entities::instance()->getUnitsAerial();
+
+    for ( Entities::Units::const_iterator it = units->begin(); it != units->end(); ++it )
+    {
+        Unit *unit = *it;
+
+        if ( !unit->isActive() )
+        {
+            continue;
+        }
+
+        Vec3 pos = unit->getPosInterpolated();
+
+        float elevation = Elevation::instance()->getElevation( pos.x(), pos.y() );
+        float altitude_agl = pos.z() - elevation;
+
+        if ( altitude_agl < 0.0f )
+        {
+            altitude_agl = 0.0f;
+        }
+
+        // shadow fades out with altitude above ground level
+        if ( altitude_agl < SIM_SHADOW_BLOB_AGL_MAX )
+        {
+            float alpha = 1.0f - altitude_agl / SIM_SHADOW_BLOB_AGL_MAX;
+
+            Angles angles( unit->getAttInterpolated() );
+
+            const float r = unit->getRadius();
+
+            // the same orientation as the overlay shadow, rotated by -heading
+            const float sinA = sin( angles.psi() + M_PI_2 );
+            const float cosA = cos( angles.psi() + M_PI_2 );
+
+            const float x[] = { -r,  r, r, -r };
+            const float y[] = { -r, -r, r,  r };
+
+            for ( int i = 0; i < 4; i++ )
+            {
+                _blobsV->push_back( osg::Vec3( pos.x() + cosA * x[ i ] - sinA * y[ i ],
+                                               pos.y() + sinA * x[ i ] + cosA * y[ i ],
+                                               elevation ) );
+
+                _blobsC->push_back( osg::Vec4( 0.5f, 0.5f, 0.5f, alpha ) );
+                _blobsT->push_back( osg::Vec2( x[ i ] > 0.0f ? 1.0f : 0.0f,
+                                               y[ i ] > 0.0f ? 1.0f : 0.0f ) );
+            }
+        }
+    }
+
+    _blobsDraw->setCount( _blobsV->size() );
+
+    _blobsV->dirty();
+    _blobsC->dirty();
+    _blobsT->dirty();
+
+    _blobsGeom->dirtyBound();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef SIM_DESKTOP
+void Scenery::updateShadowOverlay()
+{
+    // overlay texture is the single most expensive per-frame pass on low-end
+    // GPUs, so it is re-rendered every few frames only
+    if ( _counterShadow == 0 )
+    {
+        _mt->setMatrix( osg::Matrixd::rotate( osg::Quat( -Data::view()->ownship.heading, osg::Z_AXIS ) )
+                      * osg::Matrixd::translate( osg::Vec3( Data::view()->ownship.pos_x,
+                                                            Data::view()->ownship.pos_y,
+                                                            0.0f ) ) );
+
+        _overlayNode->dirtyOverlayTexture();
+    }
+
+    _counterShadow = ( _counterShadow + 1 ) % SIM_SHADOW_OVERLAY_FRAMES;
+}
+#endif
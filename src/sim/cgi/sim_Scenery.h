@@ -19,6 +19,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <osg/Geode>
+#include <osg/Geometry>
 #include <osg/Group>
 #include <osg/PositionAttitudeTransform>
 #include <osg/Switch>
@@ -35,7 +37,14 @@
 namespace sim
 {
 
-/** @brief Scenery module class. */
+/**
+ * @brief Scenery module class.
+ *
+ * Aircraft shadows are drawn according to the selected shadow type. Blob
+ * shadows of all aircraft are projected onto terrain elevation and drawn
+ * with a single geometry. Overlay shadow of the ownship is rendered into
+ * the overlay texture every few frames only.
+ */
 class Scenery : public Module
 {
 public:
@@ -46,10 +55,14 @@ public:
     static const float _size;           ///< [m]
     static const float _limit;          ///< [m] minimum distance in main directions from scenery center when generic terrain tiles are visible
 
-    static std::string _terrainFile;    ///< terrain file
+    static std::string _terrainFile;    ///< terrain file or paged terrain tiles directory
+    static int _terrainLevels;          ///< paged terrain quadtree levels number, 0 if terrain is not paged
+    static int _terrainTiles;           ///< terrain side length expressed in generic terrain tiles (odd number)
     static std::string _genericFile;    ///< generic terrain file
     static ObjectFiles _objectFiles;    ///< object files
 
+    static ShadowType _shadowType;      ///< shadow type
+
     /** */
     inline static osg::Node* getTerrainNode()
     {
@@ -75,6 +88,13 @@ private:
     osg::ref_ptr<osg::MatrixTransform> _mt;                 ///<
 #   endif
 
+    osg::ref_ptr<osg::Geode> _blobs;                        ///< blob shadows geode
+    osg::ref_ptr<osg::Geometry> _blobsGeom;                 ///< blob shadows geometry
+    osg::ref_ptr<osg::Vec3Array> _blobsV;                   ///< blob shadows vertices
+    osg::ref_ptr<osg::Vec4Array> _blobsC;                   ///< blob shadows colors
+    osg::ref_ptr<osg::Vec2Array> _blobsT;                   ///< blob shadows texture coordinates
+    osg::ref_ptr<osg::DrawArrays> _blobsDraw;               ///< blob shadows primitive set
+
     static osg::ref_ptr<osg::Node> _terrainNode;            ///< static terrain node for world view camera manipulator
 
     osg::ref_ptr<osg::Switch> _switchGeneric;               ///< generic terrain tile switch
@@ -85,19 +105,26 @@ private:
     osg::ref_ptr<osg::PositionAttitudeTransform> _pat_c;    ///< NE/NW/SE/SW (xy) corner
 
     UInt16 _counter;                                        ///< generic terrain update counter
+    UInt16 _counterShadow;                                  ///< overlay shadow update counter
 
     void createGeneric();
     void createObjects();
+    void createShadowBlobs();
 #   ifdef SIM_DESKTOP
-    void createShadow();
+    void createShadowOverlay();
 #   endif
 
     void loadGeneric();
     void loadTerrain();
 
-    void setPositionC( float xc, float yc, short ix, short iy, short dix, short diy );
-    void setPositionX( float xc, float yc, short ix, short iy, short dix );
-    void setPositionY( float xc, float yc, short ix, short iy, short diy );
+    void updateShadowBlobs();
+#   ifdef SIM_DESKTOP
+    void updateShadowOverlay();
+#   endif
+
+    void setPositionC( float xc, float yc, short ix, short iy, short dix, short diy, short n );
+    void setPositionX( float xc, float yc, short ix, short iy, short dix, short n );
+    void setPositionY( float xc, float yc, short ix, short iy, short diy, short n );
 };
 
 } // end of sim namespace
@@ -73,7 +73,7 @@ void SkyDome::update()
     /////////////////
 
 #   ifdef SIM_TEST
-    if ( Data::get()->camera.type == ViewWorld )
+    if ( Data::view()->camera.type == ViewWorld )
     {
         _switch->setAllChildrenOff();
     }
@@ -83,8 +83,8 @@ void SkyDome::update()
     }
 #   endif
 
-    _patSky->setPosition( osg::Vec3d( Data::get()->camera.pos_x,
-                                      Data::get()->camera.pos_y,
+    _patSky->setPosition( osg::Vec3d( Data::view()->camera.pos_x,
+                                      Data::view()->camera.pos_y,
                                       0.0 ) );
 }
 
@@ -25,12 +25,18 @@
 #include <sim/cgi/sim_Color.h>
 #include <sim/cgi/sim_Fonts.h>
 
+#include <sim/utils/sim_String.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace sim;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+osg::ref_ptr<osgText::Text> SplashScreen::_text;
+
+////////////////////////////////////////////////////////////////////////////////
+
 osg::Group* SplashScreen::create( int width, int height )
 {
     float maxX = floor( 100.0f * (float)( width ) / (float)( height ) + 0.5f );
@@ -57,6 +63,20 @@ osg::Group* SplashScreen::create( int width, int height )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void SplashScreen::setProgress( float progress )
+{
+    if ( _text.valid() )
+    {
+        int percent = floor( 100.0f * progress + 0.5f );
+
+        std::string text = Captions::instance()->getLoading() + " " + String::toString( percent ) + "%";
+
+        _text->setText( osgText::String( text, osgText::String::ENCODING_UTF8 ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void SplashScreen::createBack( osg::Group *parent, float maxX )
 {
     osg::ref_ptr<osg::Geode> geode = new osg::Geode();
@@ -120,6 +140,8 @@ void SplashScreen::createText( osg::Group *parent )
     osg::ref_ptr<osgText::Text> text = new osgText::Text();
     geode->addDrawable( text.get() );
 
+    _text = text.get();
+
     text->setFont( Fonts::get( Base::getPath( "fonts/fsg_stencil.ttf" ) ) );
     text->setColor( osg::Vec4( Color::white, 1.0f ) );
     text->setCharacterSize( 12.0f );
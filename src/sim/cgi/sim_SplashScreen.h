@@ -21,6 +21,8 @@
 
 #include <osg/Group>
 
+#include <osgText/Text>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace sim
@@ -34,8 +36,16 @@ public:
     /** @brief Returns splash sreen node.  */
     static osg::Group* create( int width, int height );
 
+    /**
+     * @brief Sets loading progress displayed by the last created splash screen.
+     * @param progress loading progress within range from 0.0 to 1.0
+     */
+    static void setProgress( float progress );
+
 private:
 
+    static osg::ref_ptr<osgText::Text> _text;   ///< loading text
+
     /** @brief Creates background. */
     static void createBack( osg::Group *parent, float maxX );
 
@@ -17,8 +17,19 @@
 
 #include <sim/cgi/sim_Textures.h>
 
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include <osgDB/FileUtils>
+#include <osgDB/ImageProcessor>
 #include <osgDB/ReadFile>
+#include <osgDB/Registry>
+#include <osgDB/WriteFile>
 
+#include <sim/sim_Base.h>
+#include <sim/sim_Defines.h>
 #include <sim/sim_Log.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -27,20 +38,323 @@ using namespace sim;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const char Textures::_cacheDir[] = "cache/textures/";
+const UInt32 Textures::_version = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Textures::compile( const std::string &textureFile )
+{
+    std::string cacheFile = getCacheFile( textureFile );
+
+    if ( cacheFile.empty() )
+    {
+        Log::e() << "Cannot open texture file: " << textureFile << std::endl;
+        return SIM_FAILURE;
+    }
+
+    if ( osgDB::fileExists( cacheFile ) )
+    {
+        return SIM_SUCCESS;
+    }
+
+    osg::ref_ptr<osg::Image> image = compileImage( textureFile );
+
+    if ( image.valid() )
+    {
+        return writeImage( image.get(), cacheFile );
+    }
+
+    return SIM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 osg::Texture2D* Textures::get( const std::string &textureFile, float maxAnisotropy,
                                osg::Texture::WrapMode mode )
 {
-    for ( unsigned int i = 0; i < instance()->_fileNames.size(); i++ )
+    osg::Texture2D *texture = instance()->_textures.get( textureFile, [ textureFile, maxAnisotropy, mode ]()
+    {
+        return read( textureFile, maxAnisotropy, mode );
+    });
+
+    if ( texture )
+    {
+        texture->setMaxAnisotropy( maxAnisotropy );
+    }
+
+    return texture;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Textures::request( const std::string &textureFile, float maxAnisotropy,
+                        osg::Texture::WrapMode mode )
+{
+    instance()->_textures.request( textureFile, [ textureFile, maxAnisotropy, mode ]()
+    {
+        return read( textureFile, maxAnisotropy, mode );
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Textures::Textures() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Textures::~Textures() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string Textures::getCacheFile( const std::string &textureFile )
+{
+    FILE *file = fopen( textureFile.c_str(), "rb" );
+
+    if ( file )
+    {
+        // FNV-1a hash of the source file content
+        unsigned long long hash = 14695981039346656037ULL ^ _version;
+
+        unsigned char buffer[ 4096 ];
+        size_t size = 0;
+
+        while ( ( size = fread( buffer, 1, sizeof(buffer), file ) ) > 0 )
+        {
+            for ( size_t i = 0; i < size; i++ )
+            {
+                hash ^= buffer[ i ];
+                hash *= 1099511628211ULL;
+            }
+        }
+
+        fclose( file );
+
+        char name[ 32 ];
+        sprintf( name, "%016llx", hash );
+
+        // textures compiled without image processor are recompiled once it is available
+        const char *suffix = getImageProcessor() ? ".dds" : ".cpu.dds";
+
+        return Base::getPath( _cacheDir ) + name + suffix;
+    }
+
+    return std::string();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Image* Textures::readImage( const std::string &textureFile )
+{
+    std::string cacheFile = getCacheFile( textureFile );
+
+    if ( cacheFile.empty() )
+    {
+        return 0;
+    }
+
+    if ( osgDB::fileExists( cacheFile ) )
     {
-        if ( textureFile == instance()->_fileNames.at( i ) )
+        // flipped, so image origin is the same as of the source file
+        osg::ref_ptr<osgDB::Options> options = new osgDB::Options( "dds_flip" );
+        osg::ref_ptr<osg::Image> image = osgDB::readImageFile( cacheFile, options.get() );
+
+        if ( image.valid() )
         {
-            instance()->_textures.at( i )->setMaxAnisotropy( maxAnisotropy );
-            return instance()->_textures.at( i );
+            return image.release();
         }
+
+        Log::e() << "Cannot read compiled texture file: " << cacheFile << std::endl;
     }
 
+    osg::ref_ptr<osg::Image> image = compileImage( textureFile );
+
+    // compiled image is used even if it cannot be cached
+    if ( image.valid() )
+    {
+        writeImage( image.get(), cacheFile );
+    }
+
+    return image.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Image* Textures::compileImage( const std::string &textureFile )
+{
     osg::ref_ptr<osg::Image> image = osgDB::readImageFile( textureFile );
 
+    if ( image.valid() )
+    {
+        osgDB::ImageProcessor *processor = getImageProcessor();
+
+        if ( processor )
+        {
+#           ifdef SIM_DESKTOP
+            osg::Texture::InternalFormatMode format = image->isImageTranslucent()
+                    ? osg::Texture::USE_S3TC_DXT5_COMPRESSION
+                    : osg::Texture::USE_S3TC_DXT1_COMPRESSION;
+
+            processor->compress( *image, format, true, true,
+                                 osgDB::ImageProcessor::USE_CPU,
+                                 osgDB::ImageProcessor::PRODUCTION );
+#           else
+            // DXT compression is not commonly supported by mobile devices
+            processor->generateMipMap( *image, true, osgDB::ImageProcessor::USE_CPU );
+#           endif
+        }
+        else
+        {
+            // images that cannot be processed on CPU are used as they are
+            generateMipMaps( image.get() );
+        }
+    }
+
+    return image.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osgDB::ImageProcessor* Textures::getImageProcessor()
+{
+    // registry tries to load plugin on every call, so it is done only once
+    static osgDB::ImageProcessor *processor = []()
+    {
+        osgDB::ImageProcessor *result = osgDB::Registry::instance()->getImageProcessor();
+
+        if ( !result )
+        {
+            Log::w() << "No image processor (osgdb_nvtt plugin), textures are not compressed and mipmaps are generated on CPU" << std::endl;
+        }
+
+        return result;
+    }();
+
+    return processor;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Textures::generateMipMaps( osg::Image *image )
+{
+    const int s = image->s();
+    const int t = image->t();
+
+    const unsigned int components = osg::Image::computeNumComponents( image->getPixelFormat() );
+
+    if ( image->isMipmap() || image->isCompressed() || image->r() != 1
+      || image->getDataType() != GL_UNSIGNED_BYTE
+      || image->getRowSizeInBytes() != s * components )
+    {
+        return false;
+    }
+
+    osg::Image::MipmapDataType offsets;
+
+    unsigned int size = s * t * components;
+
+    int level_s = s;
+    int level_t = t;
+
+    while ( level_s > 1 || level_t > 1 )
+    {
+        level_s = std::max( 1, level_s / 2 );
+        level_t = std::max( 1, level_t / 2 );
+
+        offsets.push_back( size );
+        size += level_s * level_t * components;
+    }
+
+    unsigned char *data = new unsigned char [ size ];
+    memcpy( data, image->data(), s * t * components );
+
+    const unsigned char *src = data;
+
+    level_s = s;
+    level_t = t;
+
+    // every level is box filtered from the previous one
+    for ( unsigned int i = 0; i < offsets.size(); i++ )
+    {
+        int next_s = std::max( 1, level_s / 2 );
+        int next_t = std::max( 1, level_t / 2 );
+
+        unsigned char *dst = data + offsets[ i ];
+
+        for ( int y = 0; y < next_t; y++ )
+        {
+            int y0 = std::min( 2 * y     , level_t - 1 ) * level_s;
+            int y1 = std::min( 2 * y + 1 , level_t - 1 ) * level_s;
+
+            for ( int x = 0; x < next_s; x++ )
+            {
+                int x0 = std::min( 2 * x     , level_s - 1 );
+                int x1 = std::min( 2 * x + 1 , level_s - 1 );
+
+                for ( unsigned int c = 0; c < components; c++ )
+                {
+                    unsigned int sum = src[ ( y0 + x0 ) * components + c ]
+                                     + src[ ( y0 + x1 ) * components + c ]
+                                     + src[ ( y1 + x0 ) * components + c ]
+                                     + src[ ( y1 + x1 ) * components + c ];
+
+                    dst[ ( y * next_s + x ) * components + c ] = ( sum + 2 ) / 4;
+                }
+            }
+        }
+
+        src = dst;
+
+        level_s = next_s;
+        level_t = next_t;
+    }
+
+    image->setImage( s, t, 1, image->getInternalTextureFormat(), image->getPixelFormat(),
+                     GL_UNSIGNED_BYTE, data, osg::Image::USE_NEW_DELETE, 1 );
+    image->setMipmapLevels( offsets );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Textures::writeImage( const osg::Image *image, const std::string &cacheFile )
+{
+    if ( !image->isMipmap() )
+    {
+        // not compiled images are not cached
+        return SIM_FAILURE;
+    }
+
+    osgDB::makeDirectoryForFile( cacheFile );
+
+    // written to temporary file first not to leave incomplete compiled file
+    std::string tempFile = cacheFile.substr( 0, cacheFile.length() - 4 ) + ".tmp.dds";
+
+    if ( osgDB::writeImageFile( *image, tempFile ) )
+    {
+        remove( cacheFile.c_str() );
+
+        if ( 0 == rename( tempFile.c_str(), cacheFile.c_str() ) )
+        {
+            return SIM_SUCCESS;
+        }
+    }
+
+    remove( tempFile.c_str() );
+
+    Log::w() << "Cannot write compiled texture file: " << cacheFile << std::endl;
+
+    return SIM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Texture2D* Textures::read( const std::string &textureFile, float maxAnisotropy,
+                                osg::Texture::WrapMode mode )
+{
+    osg::ref_ptr<osg::Image> image = readImage( textureFile );
+
     if ( image.valid() )
     {
         osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D();
@@ -57,10 +371,7 @@ osg::Texture2D* Textures::get( const std::string &textureFile, float maxAnisotro
 
         texture->setUnRefImageDataAfterApply( false );
 
-        instance()->_textures.push_back( texture.get() );
-        instance()->_fileNames.push_back( textureFile );
-
-        return texture.get();
+        return texture.release();
     }
     else
     {
@@ -69,15 +380,3 @@ osg::Texture2D* Textures::get( const std::string &textureFile, float maxAnisotro
 
     return 0;
 }
-
-////////////////////////////////////////////////////////////////////////////////
-
-Textures::Textures()
-{
-    _fileNames.clear();
-    _textures.clear();
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Textures::~Textures() {}
@@ -21,6 +21,12 @@
 
 #include <osg/Texture2D>
 
+#include <osgDB/ImageProcessor>
+
+#include <sim/sim_Types.h>
+
+#include <sim/cgi/sim_Cache.h>
+
 #include <sim/utils/sim_Singleton.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,19 +34,41 @@
 namespace sim
 {
 
-/** @brief Textures container class. */
+/**
+ * @brief Textures container class.
+ *
+ * Textures are compiled on first use into cache directory as DDS files with
+ * precomputed mipmaps (DXT compressed on desktop), named after the source
+ * file content hash, and read directly from there afterwards.
+ *
+ * Compilation requires OpenSceneGraph image processor provided by
+ * osgdb_nvtt plugin (NVIDIA Texture Tools). If it is not available textures
+ * are not compressed and their mipmaps are generated on CPU instead.
+ */
 class Textures : public Singleton< Textures >
 {
     friend class Singleton< Textures >;
 
 public:
 
-    typedef std::vector< osg::ref_ptr<osg::Texture2D> > List;
+    static const char _cacheDir[];          ///< compiled textures directory (relative to the base path)
+    static const UInt32 _version;           ///< compiled textures version, changing it invalidates cache
 
-    /** */
+    /**
+     * Compiles texture into cache directory unless it is already compiled.
+     * @param textureFile source texture file path
+     * @return SIM_SUCCESS on success or SIM_FAILURE on failure
+     */
+    static int compile( const std::string &textureFile );
+
+    /** Returns cached texture, waits if it is still being read in background. */
     static osg::Texture2D* get( const std::string &textureFile, float maxAnisotropy = 1.0f,
                                 osg::Texture::WrapMode mode = osg::Texture::MIRROR );
 
+    /** Queues texture to be read in background. */
+    static void request( const std::string &textureFile, float maxAnisotropy = 1.0f,
+                         osg::Texture::WrapMode mode = osg::Texture::MIRROR );
+
 private:
 
     /**
@@ -59,8 +87,32 @@ public:
 
 private:
 
-    List _textures;                         ///<
-    std::vector< std::string > _fileNames;  ///<
+    Cache< osg::Texture2D > _textures;      ///< textures cache
+
+    /** Returns compiled texture file path, empty if source file cannot be read. */
+    static std::string getCacheFile( const std::string &textureFile );
+
+    /** Reads compiled image, compiles it if necessary. */
+    static osg::Image* readImage( const std::string &textureFile );
+
+    /** Reads source image and compresses it, generating mipmaps. */
+    static osg::Image* compileImage( const std::string &textureFile );
+
+    /** Returns image processor, NULLPTR if it is not available, looked for only once. */
+    static osgDB::ImageProcessor* getImageProcessor();
+
+    /**
+     * Generates image mipmaps on CPU, used when there is no image processor.
+     * @return true if mipmaps have been generated, false if image format is not supported
+     */
+    static bool generateMipMaps( osg::Image *image );
+
+    /** Writes compiled image to cache directory. */
+    static int writeImage( const osg::Image *image, const std::string &cacheFile );
+
+    /** Reads texture from file, used by textures cache. */
+    static osg::Texture2D* read( const std::string &textureFile, float maxAnisotropy,
+                                 osg::Texture::WrapMode mode );
 };
 
 } // end of sim namespace
@@ -29,12 +29,9 @@
 #include <sim/cgi/sim_FindNode.h>
 #include <sim/cgi/sim_Geometry.h>
 #include <sim/cgi/sim_Models.h>
+#include <sim/cgi/sim_Reflection.h>
 #include <sim/cgi/sim_Textures.h>
 
-#ifdef SIM_DESKTOP
-#   include <sim/entities/sim_UnitMarine.h>
-#endif
-
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace sim;
@@ -90,6 +87,10 @@ void Viewer::load()
     _propeller3 = 0;
     _propeller4 = 0;
 
+#   ifdef SIM_DESKTOP
+    Reflection::reset();
+#   endif
+
     createSky();
     createSun();
 
@@ -356,7 +357,9 @@ void Viewer::loadUnit()
             else if ( data.type == ListUnits::Marine )
             {
 #               ifdef SIM_DESKTOP
-                UnitMarine::createReflection( model.get(), _root.get() );
+                Reflection::addModel( model.get() );
+                _root->addChild( Reflection::getNode() );
+                _root->addChild( Reflection::createWater( model.get() ) );
 #               endif
             }
             else if ( data.type == ListUnits::Ground )
@@ -23,11 +23,10 @@
 #include <sim/cgi/sim_Effects.h>
 #include <sim/cgi/sim_FindNode.h>
 #include <sim/cgi/sim_Models.h>
+#include <sim/cgi/sim_SceneQueue.h>
 
 #include <sim/entities/sim_Explosion.h>
-#include <sim/entities/sim_Tracer.h>
 
-#include <sim/sim_Elevation.h>
 #include <sim/sim_Ownship.h>
 
 #include <sim/utils/sim_Inertia.h>
@@ -108,6 +107,7 @@ Aircraft::Aircraft( Affiliation affiliation ) :
     _flash_count   ( 0 ),
     _flash_devider ( 2 ),
     _flash_angle ( 0.0f ),
+    _flash ( false ),
 
     _time_drop   ( 1000.0f ),
     _time_launch ( 1000.0f ),
@@ -151,6 +151,13 @@ Aircraft::~Aircraft()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool Aircraft::isElevationRequired() const
+{
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Aircraft::destroy()
 {
     if ( isActive() )
@@ -159,7 +166,7 @@ void Aircraft::destroy()
         explosion->setPos( _pos );
         explosion->setAtt( _att );
 
-        _wreckage = new WreckageAircraft( _modelFile, _livery, _smokeTrail.get(), _ownship );
+        _wreckage = new WreckageAircraft( _modelFile, _livery, _ownship );
         _wreckage->init( _pos, _att, _vel, _omg );
 
         if ( _ownship )
@@ -208,6 +215,73 @@ void Aircraft::destroy()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Aircraft::interpolate( double alpha )
+{
+    /////////////////////////////////
+    UnitAerial::interpolate( alpha );
+    /////////////////////////////////
+
+    if ( _ownship )
+    {
+        float ailerons = _maxAilerons * _ctrlRoll;
+        float elevator = _maxElevator * _ctrlPitch;
+        float rudder   = _maxRudder   * _ctrlYaw;
+
+        // ailerons
+        if ( _aileronL.valid() && _aileronR.valid() )
+        {
+            _aileronL->setAttitude( Quat( -ailerons, osg::Y_AXIS ) );
+            _aileronR->setAttitude( Quat(  ailerons, osg::Y_AXIS ) );
+        }
+
+        // elevator
+        if ( _elevator.valid() )
+        {
+            _elevator->setAttitude( Quat( -elevator, osg::Y_AXIS ) );
+        }
+
+        // rudder
+        if ( _rudderL.valid() && _rudderR.valid() )
+        {
+            _rudderL->setAttitude( Quat( -rudder, osg::Z_AXIS ) );
+            _rudderR->setAttitude( Quat( -rudder, osg::Z_AXIS ) );
+        }
+    }
+
+    // propellers
+    if ( _propeller1.valid() ) _propeller1->setAttitude( Quat( -_prop_angle, osg::X_AXIS ) );
+    if ( _propeller2.valid() ) _propeller2->setAttitude( Quat(  _prop_angle, osg::X_AXIS ) );
+    if ( _propeller3.valid() ) _propeller3->setAttitude( Quat( -_prop_angle, osg::X_AXIS ) );
+    if ( _propeller4.valid() ) _propeller4->setAttitude( Quat(  _prop_angle, osg::X_AXIS ) );
+
+    // muzzle flash
+    osg::ref_ptr<osg::StateSet> stateSet = _switch->getOrCreateStateSet();
+
+    if ( _flash )
+    {
+        _flashSwitch->setAllChildrenOn();
+
+        stateSet->setMode( GL_LIGHT1, osg::StateAttribute::ON );
+        stateSet->setMode( GL_LIGHT2, osg::StateAttribute::ON );
+
+        osg::Quat q( _flash_angle, osg::X_AXIS );
+
+        for ( unsigned int i = 0; i < _flashPAT.size(); i++ )
+        {
+            _flashPAT[ i ]->setAttitude( q );
+        }
+    }
+    else
+    {
+        _flashSwitch->setAllChildrenOff();
+
+        stateSet->setMode( GL_LIGHT1, osg::StateAttribute::OFF );
+        stateSet->setMode( GL_LIGHT2, osg::StateAttribute::OFF );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Aircraft::load()
 {
     if ( _flashSwitch->getNumChildren() > 0 )
@@ -272,6 +346,8 @@ void Aircraft::load()
 
     setLivery( _livery );
 
+    WreckageAircraft::prepare( _modelFile, _livery );
+
     if ( _ownship )
     {
         createMuzzleFlash( _flashes, Vec3( 0.5, 0.5, 0.5 ) );
@@ -452,38 +528,8 @@ void Aircraft::update( double timeStep )
             {
                 _flash_devider = 3;
             }
-
-            float ailerons = _maxAilerons * _ctrlRoll;
-            float elevator = _maxElevator * _ctrlPitch;
-            float rudder   = _maxRudder   * _ctrlYaw;
-
-            // ailerons
-            if ( _aileronL.valid() && _aileronR.valid() )
-            {
-                _aileronL->setAttitude( Quat( -ailerons, osg::Y_AXIS ) );
-                _aileronR->setAttitude( Quat(  ailerons, osg::Y_AXIS ) );
-            }
-
-            // elevator
-            if ( _elevator.valid() )
-            {
-                _elevator->setAttitude( Quat( -elevator, osg::Y_AXIS ) );
-            }
-
-            // rudder
-            if ( _rudderL.valid() && _rudderR.valid() )
-            {
-                _rudderL->setAttitude( Quat( -rudder, osg::Z_AXIS ) );
-                _rudderR->setAttitude( Quat( -rudder, osg::Z_AXIS ) );
-            }
         }
 
-        // propellers
-        if ( _propeller1.valid() ) _propeller1->setAttitude( Quat( -_prop_angle, osg::X_AXIS ) );
-        if ( _propeller2.valid() ) _propeller2->setAttitude( Quat(  _prop_angle, osg::X_AXIS ) );
-        if ( _propeller3.valid() ) _propeller3->setAttitude( Quat( -_prop_angle, osg::X_AXIS ) );
-        if ( _propeller4.valid() ) _propeller4->setAttitude( Quat(  _prop_angle, osg::X_AXIS ) );
-
         if ( _ownship && !Data::get()->controls.autopilot )
         {
             _ctrlRoll  = Ownship::instance()->getCtrlRoll();
@@ -493,22 +539,34 @@ void Aircraft::update( double timeStep )
         }
         else
         {
-            updateControls();
             updateWingman();
         }
 
-        updateDestination();
         updatePropeller();
 
         if ( _altitude_agl < 1.0 || ( _ownship && _altitude_agl < fabs( sin( _rollAngle ) ) * _radius ) )
         {
             destroy();
         }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
-        if ( _smokeTrail.valid() )
+void Aircraft::updateParallel( double timeStep )
+{
+    ///////////////////////////////////////
+    UnitAerial::updateParallel( timeStep );
+    ///////////////////////////////////////
+
+    if ( isActive() )
+    {
+        if ( !_ownship || Data::get()->controls.autopilot )
         {
-            _smokeTrail->setPosition( _pos );
+            updateControls();
         }
+
+        updateDestination();
     }
 }
 
@@ -600,11 +658,15 @@ void Aircraft::setLivery( const std::string &livery )
 {
     _livery = livery;
 
-    osg::ref_ptr<osg::Texture2D> texture = Textures::get( getPath( _livery ), 8.0f );
-
-    if ( texture.valid() && _modelStateSet.valid() )
+    // before loading model livery is only stored, so it can be read in background
+    if ( _modelStateSet.valid() )
     {
-        _modelStateSet->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
+        osg::ref_ptr<osg::Texture2D> texture = Textures::get( getPath( _livery ), 8.0f );
+
+        if ( texture.valid() )
+        {
+            _modelStateSet->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
+        }
     }
 }
 
@@ -642,7 +704,8 @@ void Aircraft::setHP( UInt16 hp )
         {
             _smokeTrail = Effects::createSmokeTrail();
 
-            _root->addChild( _smokeTrail.get() );
+            // trail emitter is moved by aircraft transform
+            SceneQueue::addChild( _pat.get(), _smokeTrail.get() );
         }
     }
 }
@@ -719,24 +782,21 @@ void Aircraft::avoidCollisions( float &phi, float &tht )
 
     UnitAerial *closestUnit = 0;
 
-    List entities = *Entities::instance()->getEntities();
-    List::iterator it = entities.begin();
+    const Entities::Units *units = Entities::instance()->getUnitsAerial();
+    Entities::Units::const_iterator it = units->begin();
 
-    while ( it != entities.end() )
+    while ( it != units->end() )
     {
-        UnitAerial *unit = dynamic_cast< UnitAerial* >(*it);
+        UnitAerial *unit = static_cast< UnitAerial* >(*it);
 
-        if ( unit )
+        if ( unit->isActive() && unit->getId() != _id )
         {
-            if ( unit->isActive() && unit->getId() != _id )
-            {
-                float dist2_new = ( unit->getPos() - _pos ).length2();
+            float dist2_new = ( unit->getPos() - _pos ).length2();
 
-                if ( dist2_new < dist2 )
-                {
-                    dist2 = dist2_new;
-                    closestUnit = unit;
-                }
+            if ( dist2_new < dist2 )
+            {
+                dist2 = dist2_new;
+                closestUnit = unit;
             }
         }
 
@@ -918,7 +978,7 @@ void Aircraft::updateElevation()
     UnitAerial::updateElevation();
     //////////////////////////////
 
-    _elevation = Elevation::instance()->getElevation( _pos.x(), _pos.y() );
+    _elevation = getElevationSample();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1021,7 +1081,7 @@ void Aircraft::updateWeapons()
 {
     updateTrigger();
 
-    osg::ref_ptr<osg::StateSet> stateSet = _switch->getOrCreateStateSet();
+    _flash = false;
 
     if ( _trigger )
     {
@@ -1031,9 +1091,7 @@ void Aircraft::updateWeapons()
 
             for ( UInt8 i = 0; i < _muzzles.size(); i++ )
             {
-                Tracer *tracer = new Tracer( _id, _ownship && _muzzles[ i ].trail );
-                tracer->setPos( _pos + _att * _muzzles[ i ].pos );
-                tracer->setAtt( _att );
+                Entities::instance()->getProjectiles()->fire( _id, _pos + _att * _muzzles[ i ].pos, _att );
             }
         }
 
@@ -1041,44 +1099,16 @@ void Aircraft::updateWeapons()
         {
             if ( _flash_count % _flash_devider == 0 )
             {
-                _flashSwitch->setAllChildrenOn();
-
-                stateSet->setMode( GL_LIGHT1, osg::StateAttribute::ON );
-                stateSet->setMode( GL_LIGHT2, osg::StateAttribute::ON );
-
-                osg::Quat q( _flash_angle, osg::X_AXIS );
-
-                for ( unsigned int i = 0; i < _flashPAT.size(); i++ )
-                {
-                    _flashPAT[ i ]->setAttitude( q );
-                }
+                _flash = true;
 
                 _flash_angle = _flash_angle + 1.0f;
                 _flash_count = 0;
 
                 if ( _flash_angle > 2.0f * M_PI ) _flash_angle = 0.0f;
             }
-            else
-            {
-                _flashSwitch->setAllChildrenOff();
-
-                stateSet->setMode( GL_LIGHT1, osg::StateAttribute::OFF );
-                stateSet->setMode( GL_LIGHT2, osg::StateAttribute::OFF );
-            }
 
             _flash_count++;
         }
-        else
-        {
-            _flashSwitch->setAllChildrenOff();
-        }
-    }
-    else
-    {
-        _flashSwitch->setAllChildrenOff();
-
-        stateSet->setMode( GL_LIGHT1, osg::StateAttribute::OFF );
-        stateSet->setMode( GL_LIGHT2, osg::StateAttribute::OFF );
     }
 
     _time_drop   += _timeStep;
@@ -72,9 +72,19 @@ public:
     /** Destructor. */
     virtual ~Aircraft();
 
+    /** Returns true as aircraft requires terrain elevation. */
+    virtual bool isElevationRequired() const;
+
     /** Destroys aircraft. */
     virtual void destroy();
 
+    /**
+     * Interpolates aircraft scene node, sets control surfaces deflections,
+     * propellers angles and muzzle flash.
+     * @param alpha interpolation coefficient (0 - previous state, 1 - current state)
+     */
+    virtual void interpolate( double alpha );
+
     /** Loads aircraft (models, textures, etc.). */
     virtual void load();
 
@@ -96,6 +106,12 @@ public:
      */
     virtual void update( double timeStep );
 
+    /**
+     * Updates aircraft controls and destination.
+     * @param timeStep [s] simulation time step
+     */
+    virtual void updateParallel( double timeStep );
+
     /** Increments the number of following aircrafts. */
     virtual void wingmenIncrement();
 
@@ -198,7 +214,7 @@ protected:
     osg::ref_ptr<osg::Node> _model;                 ///< aircraft model node
     osg::ref_ptr<osg::StateSet> _modelStateSet;     ///< aircraft model node state set
 
-    osg::ref_ptr<Effects::Smoke> _smokeTrail;       ///< smoke trail
+    osg::ref_ptr<osg::Group> _smokeTrail;           ///< smoke trail
 
     osg::ref_ptr<osg::PositionAttitudeTransform> _aileronL;     ///< left aileron deflection
     osg::ref_ptr<osg::PositionAttitudeTransform> _aileronR;     ///< right aileron deflection
@@ -282,6 +298,8 @@ protected:
     short _flash_devider;           ///< muzzle flash devider
     float _flash_angle;             ///< [rad] muzzle flash "roll" angle
 
+    bool _flash;                    ///< specifies if muzzle flash is visible
+
     float _time_drop;               ///< [s] time since last bomb dropped
     float _time_launch;             ///< [s] time since last rocket launched
     float _time_shoot;              ///< [s] time since last shot
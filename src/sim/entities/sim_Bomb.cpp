@@ -19,7 +19,6 @@
 
 #include <sim/entities/sim_Explosion.h>
 #include <sim/entities/sim_Entities.h>
-#include <sim/sim_Elevation.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -44,6 +43,13 @@ Bomb::~Bomb() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool Bomb::isElevationRequired() const
+{
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Bomb::update( double timeStep )
 {
     /////////////////////////////
@@ -78,31 +84,30 @@ void Bomb::hit( Unit* )
 
 void Bomb::rangeDamage()
 {
-    List entities = *Entities::instance()->getEntities();
-    List::iterator it = entities.begin();
+    UnitsGrid::Units units;
+    Entities::instance()->getUnitsGrid()->getUnits( _pos, _r_limit, &units );
 
-    while ( it != entities.end() )
+    UnitsGrid::Units::iterator it = units.begin();
+
+    while ( it != units.end() )
     {
-        Unit *target = dynamic_cast< Unit* >(*it);
+        Unit *target = (*it);
 
-        if ( target )
+        if ( target->isActive() )
         {
-            if ( target->isActive() )
+            float r2 = ( target->getPos() - _pos ).length2() - target->getRadius2();
+
+            if ( r2 < _r_limit_2 )
             {
-                float r2 = ( target->getPos() - _pos ).length2() - target->getRadius2();
+                UInt16 dp = _dp;
 
-                if ( r2 < _r_limit_2 )
+                if ( r2 > 0.0f )
                 {
-                    UInt16 dp = _dp;
-
-                    if ( r2 > 0.0f )
-                    {
-                        dp = (float)_dp * ( 1.0f - r2 / _r_limit_2 );
-                    }
-
-                    target->hit( dp, this );
-                    reportTargetHit( target );
+                    dp = (float)_dp * ( 1.0f - r2 / _r_limit_2 );
                 }
+
+                target->hit( dp, this );
+                reportTargetHit( target );
             }
         }
 
@@ -123,7 +128,7 @@ void Bomb::updateElevation()
         Munition::updateElevation();
         ////////////////////////////
 
-        _elevation = Elevation::instance()->getElevation( _pos.x(), _pos.y() );
+        _elevation = getElevationSample();
     }
 }
 
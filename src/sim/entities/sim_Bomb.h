@@ -40,6 +40,9 @@ public:
     /** Destructor. */
     virtual ~Bomb();
 
+    /** Returns true as bomb requires terrain elevation. */
+    virtual bool isElevationRequired() const;
+
     /** Updates bomb. */
     virtual void update( double timeStep );
 
@@ -57,13 +57,13 @@ Bomber::~Bomber()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Bomber::update( double timeStep )
+void Bomber::updateParallel( double timeStep )
 {
     if ( isActive() ) _target->update();
 
-    /////////////////////////////
-    Aircraft::update( timeStep );
-    /////////////////////////////
+    /////////////////////////////////////
+    Aircraft::updateParallel( timeStep );
+    /////////////////////////////////////
 
     if ( isActive() )
     {
@@ -41,8 +41,8 @@ public:
     /** Destructor. */
     virtual ~Bomber();
 
-    /** Updates entity. */
-    virtual void update( double timeStep );
+    /** Updates target. */
+    virtual void updateParallel( double timeStep );
 
     /** Returns aircraft target unit pointer. */
     virtual UnitSurface* getTarget() const;
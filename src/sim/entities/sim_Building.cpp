@@ -35,5 +35,8 @@ Building::~Building() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Building::updateCollisions() {}
+bool Building::isDetectingCollisions() const
+{
+    return false;
+}
 
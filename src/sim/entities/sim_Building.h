@@ -39,10 +39,8 @@ public:
     /** Destructor. */
     virtual ~Building();
 
-protected:
-
-    /** Determines if unit collided with another one. */
-    virtual void updateCollisions();
+    /** Returns false as buildings do not detect collisions. */
+    virtual bool isDetectingCollisions() const;
 };
 
 } // end of sim namespace
@@ -44,3 +44,14 @@ Bullet::~Bullet() {}
 ////////////////////////////////////////////////////////////////////////////////
 
 void Bullet::load() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Bullet::reset( UInt32 shooterId )
+{
+    /////////////////////////////
+    Munition::reset( shooterId );
+    /////////////////////////////
+
+    _vel.x() = -_vel_m;
+}
@@ -41,6 +41,11 @@ public:
 
     /** Loads bullet. */
     virtual void load();
+
+protected:
+
+    /** Resets recycled bullet. */
+    virtual void reset( UInt32 shooterId );
 };
 
 } // end of sim namespace
@@ -0,0 +1,95 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/entities/sim_Collisions.h>
+
+#include <algorithm>
+
+#include <sim/entities/sim_Unit.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Collisions::Collisions() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Collisions::~Collisions() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Collisions::clear()
+{
+    _items.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Collisions::update( const Units *units )
+{
+    _items.clear();
+
+    for ( UInt32 i = 0; i < units->size(); i++ )
+    {
+        Unit *unit = units->at( i );
+
+        if ( unit->isActive() )
+        {
+            // units collide when distance squared is less than the sum
+            // of radii squared, which is never more than the sum of radii
+            Item item;
+
+            item.x_min = unit->getPos().x() - unit->getRadius();
+            item.x_max = unit->getPos().x() + unit->getRadius();
+            item.index = i;
+            item.unit  = unit;
+
+            _items.push_back( item );
+        }
+    }
+
+    std::sort( _items.begin(), _items.end() );
+
+    for ( UInt32 i = 0; i < _items.size(); i++ )
+    {
+        Unit *unit_i = _items[ i ].unit;
+
+        for ( UInt32 j = i + 1; j < _items.size() && _items[ j ].x_min <= _items[ i ].x_max; j++ )
+        {
+            // unit might have been destroyed by previous collision
+            if ( !unit_i->isActive() ) break;
+
+            Unit *unit_j = _items[ j ].unit;
+
+            if ( !unit_j->isActive() ) continue;
+
+            if ( unit_i->isDetectingCollisions() || unit_j->isDetectingCollisions() )
+            {
+                Vec3 r = unit_j->getPos() - unit_i->getPos();
+
+                if ( r.length2() < unit_i->getRadius2() + unit_j->getRadius2() )
+                {
+                    unit_i->collide( unit_j );
+                    unit_j->collide( unit_i );
+                }
+            }
+        }
+    }
+}
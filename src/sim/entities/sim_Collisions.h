@@ -0,0 +1,90 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_COLLISIONS_H
+#define SIM_COLLISIONS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <sim/sim_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+class Unit;
+
+/**
+ * @brief Units collisions class.
+ *
+ * Collisions between top level units are detected once per simulation step
+ * using sweep and prune method. Units bounding spheres are projected onto
+ * x-axis and sorted by their lower bounds, so only units which intervals
+ * overlap are tested against each other. Each colliding pair is reported
+ * exactly once, pair is skipped if none of the units detects collisions.
+ *
+ * @see Entities
+ */
+class Collisions
+{
+public:
+
+    typedef std::vector< Unit* > Units;
+
+    /** Constructor. */
+    Collisions();
+
+    /** Destructor. */
+    virtual ~Collisions();
+
+    /** Removes all units. */
+    void clear();
+
+    /**
+     * @brief Detects collisions and makes colliding units collide.
+     * @param units top level units list
+     */
+    void update( const Units *units );
+
+private:
+
+    /** Sweep and prune item struct. */
+    struct Item
+    {
+        double x_min;   ///< [m] interval lower bound
+        double x_max;   ///< [m] interval upper bound
+        UInt32 index;   ///< unit index in top level units list
+        Unit *unit;     ///< unit
+
+        inline bool operator< ( const Item &item ) const
+        {
+            return ( x_min < item.x_min ) || ( x_min == item.x_min && index < item.index );
+        }
+    };
+
+    typedef std::vector< Item > Items;
+
+    Items _items;       ///< items sorted by interval lower bound
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_COLLISIONS_H
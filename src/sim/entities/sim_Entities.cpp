@@ -17,10 +17,25 @@
 
 #include <sim/entities/sim_Entities.h>
 
+#include <algorithm>
+#include <assert.h>
 #include <limits>
 
+#include <sim/sim_Elevation.h>
 #include <sim/sim_Log.h>
+#include <sim/cgi/sim_Effects.h>
+#include <sim/cgi/sim_Impostors.h>
+#include <sim/cgi/sim_Instances.h>
+#include <sim/cgi/sim_Reflection.h>
+#include <sim/entities/sim_Flak.h>
+#include <sim/entities/sim_Munition.h>
+#include <sim/entities/sim_Pool.h>
 #include <sim/entities/sim_Unit.h>
+#include <sim/entities/sim_UnitAerial.h>
+#include <sim/entities/sim_UnitMarine.h>
+
+#include <sim/utils/sim_Jobs.h>
+#include <sim/utils/sim_Profiler.h>
 #include <sim/utils/sim_String.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -29,33 +44,318 @@ using namespace sim;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+/** Inactive entities predicate, clears registered flags of matching entities. */
+class IsInactive
+{
+public:
+
+    IsInactive( std::vector< bool > *registered ) :
+        _registered ( registered )
+    {}
+
+    bool operator()( const Entity *entity ) const
+    {
+        if ( entity->getState() == Inactive )
+        {
+            (*_registered)[ entity->getId() & SIM_ENTITY_ID_INDEX_MASK ] = false;
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+
+    std::vector< bool > *_registered;
+};
+
+template < class TYPE >
+void removeEntity( std::vector< TYPE* > *list, Entity *entity )
+{
+    typename std::vector< TYPE* >::iterator it = std::find( list->begin(), list->end(), entity );
+
+    if ( it != list->end() )
+    {
+        list->erase( it );
+    }
+}
+
+template < class TYPE >
+void removeInactive( std::vector< TYPE* > *list, std::vector< bool > *registered )
+{
+    list->erase( std::remove_if( list->begin(), list->end(), IsInactive( registered ) ), list->end() );
+}
+
+/** Units parallel update job. */
+class UpdateParallel : public Jobs::Job
+{
+public:
+
+    UpdateParallel( const Entities::Units *units, double timeStep ) :
+        _units ( units ),
+        _timeStep ( timeStep )
+    {}
+
+    void execute( UInt32 index )
+    {
+        (*_units)[ index ]->updateParallel( _timeStep );
+    }
+
+private:
+
+    const Entities::Units *_units;
+    const double _timeStep;
+};
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::Registry::add( Unit *unit )
+{
+    all.push_back( unit );
+
+    UInt8 index = unit->getAffiliation();
+
+    if ( index < 4 )
+    {
+        affiliated[ index ].push_back( unit );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::Registry::clear()
+{
+    all.clear();
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        affiliated[ i ].clear();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::Registry::remove( Entity *entity )
+{
+    removeEntity( &all, entity );
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        removeEntity( &affiliated[ i ], entity );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::Registry::removeInactive( std::vector< bool > *registered )
+{
+    ::removeInactive( &all, registered );
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        ::removeInactive( &affiliated[ i ], registered );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Entities::Entities() :
     Group( 0 )
-{}
+{
+    _root->addChild( _projectiles.getNode() );
+
+    // shared particle systems use world frame
+    _root->addChild( Effects::getNode() );
+
+    // shared water reflection camera inherits world frame view
+    _root->addChild( Reflection::getNode() );
+
+    // instanced models transforms are expressed in world frame
+    _root->addChild( Instances::getNode() );
+
+    // distant units impostors are expressed in world frame
+    _root->addChild( Impostors::getNode() );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Entities::~Entities() {}
+Entities::~Entities()
+{
+    // pooled entities are not children, so they are not deleted by Group
+    Pool< Flak >::clear();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Unit* Entities::getUnitByName( const std::string &name )
+void Entities::attachEntity( Entity *entity )
 {
-    List::iterator it = _children.begin();
+    // registries are read concurrently during parallel update phase
+    assert( !Jobs::instance()->isRunning() );
 
-    while ( it != _children.end() )
+    ////////////////////////////////
+    Group::attachEntity( entity );
+    ////////////////////////////////
+
+    if ( entity )
     {
-        Unit *unit = dynamic_cast< Unit* >( *it );
+        _uncategorized.push_back( entity );
+    }
+}
 
-        if ( unit )
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::deleteAllEntities()
+{
+    _units.clear();
+    _unitsAerial.clear();
+    _unitsSurface.clear();
+    _unitsMarine.clear();
+
+    _munitions.clear();
+    _uncategorized.clear();
+    _registered.clear();
+
+    _unitsGrid.clear();
+    _collisions.clear();
+    _targets.clear();
+
+    _projectiles.clear();
+
+    Pool< Flak >::clear();
+
+    ///////////////////////////
+    Group::deleteAllEntities();
+    ///////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::deleteEntity( Entity *entity )
+{
+    unregister( entity );
+
+    ////////////////////////////////
+    Group::deleteEntity( entity );
+    ////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::dettachEntity( Entity *entity )
+{
+    unregister( entity );
+
+    ////////////////////////////////
+    Group::dettachEntity( entity );
+    ////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::interpolate( double alpha )
+{
+    ////////////////////////////
+    Group::interpolate( alpha );
+    ////////////////////////////
+
+    _projectiles.updateGeometry();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::update( double timeStep )
+{
+    {
+        Profiler::Scope scope( "entities.prepare" );
+
+        categorize();
+
+        // inactive entities are about to be deleted
+        _units.removeInactive( &_registered );
+        _unitsAerial.removeInactive( &_registered );
+        _unitsSurface.removeInactive( &_registered );
+        _unitsMarine.removeInactive( &_registered );
+
+        ::removeInactive( &_munitions, &_registered );
+
+        _unitsGrid.rebuild( &_units.all, timeStep );
+
+        for ( UInt8 i = 0; i < 4; i++ )
+        {
+            Affiliation affiliation = (Affiliation)i;
+
+            _targets.rebuild( Targets::All     , affiliation, &_units.affiliated[ i ]        , timeStep );
+            _targets.rebuild( Targets::Aerial  , affiliation, &_unitsAerial.affiliated[ i ]  , timeStep );
+            _targets.rebuild( Targets::Surface , affiliation, &_unitsSurface.affiliated[ i ] , timeStep );
+            _targets.rebuild( Targets::Marine  , affiliation, &_unitsMarine.affiliated[ i ]  , timeStep );
+        }
+
+        sampleElevation();
+    }
+
+    // first phase, units only read state from the previous step
+    {
+        Profiler::Scope scope( "entities.parallel" );
+
+        UpdateParallel job( &_units.all, timeStep );
+        Jobs::instance()->run( &job, _units.all.size() );
+    }
+
+    // second phase, side effects are applied serially
+    {
+        Profiler::Scope scope( "entities.serial" );
+
+        //////////////////////////
+        Group::update( timeStep );
+        //////////////////////////
+    }
+
+    {
+        Profiler::Scope scope( "entities.collisions" );
+        _collisions.update( &_units.all );
+    }
+
+    {
+        Profiler::Scope scope( "entities.projectiles" );
+        _projectiles.update( timeStep );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::load()
+{
+    ///////////////
+    Group::load();
+    ///////////////
+
+    categorize();
+
+    _projectiles.load();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Unit* Entities::getUnitByName( const std::string &name )
+{
+    const Entity::Ids *ids = Entity::findIds( name );
+
+    if ( ids )
+    {
+        for ( Entity::Ids::const_iterator it = ids->begin(); it != ids->end(); ++it )
         {
-            if ( 0 == String::icompare( unit->getName(), name ) )
+            Unit *unit = dynamic_cast< Unit* >( getEntityById( *it ) );
+
+            if ( unit )
             {
                 return unit;
             }
         }
-
-        ++it;
     }
 
     return 0;
@@ -93,7 +393,182 @@ void Entities::listAll()
 
     while ( it != _children.end() )
     {
-        Log::i() << (*it)->getName() << std::endl;
+        if ( (*it) ) Log::i() << (*it)->getName() << std::endl;
         ++it;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Entities::Units* Entities::getUnits() const
+{
+    return &_units.all;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Entities::Units* Entities::getUnits( Affiliation affiliation ) const
+{
+    return &_units.affiliated[ affiliation ];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Entities::Units* Entities::getUnitsAerial() const
+{
+    return &_unitsAerial.all;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Entities::Units* Entities::getUnitsAerial( Affiliation affiliation ) const
+{
+    return &_unitsAerial.affiliated[ affiliation ];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Entities::Units* Entities::getUnitsSurface() const
+{
+    return &_unitsSurface.all;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Entities::Units* Entities::getUnitsSurface( Affiliation affiliation ) const
+{
+    return &_unitsSurface.affiliated[ affiliation ];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Entities::Units* Entities::getUnitsMarine() const
+{
+    return &_unitsMarine.all;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Entities::Units* Entities::getUnitsMarine( Affiliation affiliation ) const
+{
+    return &_unitsMarine.affiliated[ affiliation ];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Entities::Munitions* Entities::getMunitions() const
+{
+    return &_munitions;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::categorize()
+{
+    for ( List::iterator it = _uncategorized.begin(); it != _uncategorized.end(); ++it )
+    {
+        UInt32 index = (*it)->getId() & SIM_ENTITY_ID_INDEX_MASK;
+
+        if ( index >= _registered.size() )
+        {
+            _registered.resize( index + 1, false );
+        }
+
+        _registered[ index ] = true;
+
+        Unit *unit = dynamic_cast< Unit* >( *it );
+
+        if ( unit )
+        {
+            _units.add( unit );
+
+            if ( dynamic_cast< UnitAerial* >( unit ) )
+            {
+                _unitsAerial.add( unit );
+            }
+            else if ( dynamic_cast< UnitSurface* >( unit ) )
+            {
+                _unitsSurface.add( unit );
+
+                if ( dynamic_cast< UnitMarine* >( unit ) )
+                {
+                    _unitsMarine.add( unit );
+                }
+            }
+        }
+        else
+        {
+            Munition *munition = dynamic_cast< Munition* >( *it );
+
+            if ( munition )
+            {
+                _munitions.push_back( munition );
+            }
+        }
+    }
+
+    _uncategorized.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::unregister( Entity *entity )
+{
+    removeEntity( &_uncategorized, entity );
+
+    UInt32 index = entity->getId() & SIM_ENTITY_ID_INDEX_MASK;
+
+    // inactive entities have been already removed from registries and
+    // newly created entities have not been categorized yet
+    if ( index >= _registered.size() || !_registered[ index ] )
+    {
+        return;
+    }
+
+    _registered[ index ] = false;
+
+    _units.remove( entity );
+    _unitsAerial.remove( entity );
+    _unitsSurface.remove( entity );
+    _unitsMarine.remove( entity );
+
+    removeEntity( &_munitions, entity );
+
+    _targets.remove( entity );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::sampleElevation()
+{
+    _elevationEntities.clear();
+
+    _elevation_x.clear();
+    _elevation_y.clear();
+
+    for ( List::iterator it = _children.begin(); it != _children.end(); ++it )
+    {
+        Entity *entity = (*it);
+
+        if ( entity && entity->isActive() && entity->isElevationRequired() )
+        {
+            _elevationEntities.push_back( entity );
+
+            _elevation_x.push_back( entity->getPos().x() );
+            _elevation_y.push_back( entity->getPos().y() );
+        }
+    }
+
+    _elevation_z.resize( _elevationEntities.size() );
+
+    if ( _elevationEntities.size() > 0 )
+    {
+        Elevation::instance()->getElevation( &_elevation_x[ 0 ], &_elevation_y[ 0 ],
+                                             &_elevation_z[ 0 ], _elevationEntities.size() );
+    }
+
+    for ( UInt32 i = 0; i < _elevationEntities.size(); i++ )
+    {
+        _elevationEntities[ i ]->setElevationSample( _elevation_z[ i ] );
+    }
+}
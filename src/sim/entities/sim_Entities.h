@@ -23,22 +23,44 @@
 
 #include <sim/utils/sim_Singleton.h>
 
+#include <sim/entities/sim_Collisions.h>
 #include <sim/entities/sim_Group.h>
+#include <sim/entities/sim_Projectiles.h>
+#include <sim/entities/sim_Targets.h>
+#include <sim/entities/sim_UnitsGrid.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace sim
 {
 
+class Munition;
+
 /**
  * @brief Top level entities class.
  *
  * This singleton class should be used to access top level entities.
+ *
+ * Top level units and munitions are additionally kept in registries grouped
+ * by category and affiliation, so it is not necessary to iterate through all
+ * entities and check their types. Entities are categorized at the beginning
+ * of every step, as it cannot be done before they are fully constructed, so
+ * registries stay unchanged while they are read during parallel update phase.
+ * Entities must not be attached while jobs are running. Inactive entities are
+ * removed from registries in a single pass at the beginning of every step, before being
+ * deleted. Registered entities are flagged by ID index, so only detaching or
+ * deleting an entity which is still active requires searching registries.
+ * Registries preserve entities list order.
  */
 class Entities : public Group, public Singleton< Entities >
 {
     friend class Singleton< Entities >;
 
+public:
+
+    typedef std::vector< Unit* > Units;
+    typedef std::vector< Munition* > Munitions;
+
 private:
 
     /** Constructor. */
@@ -52,8 +74,37 @@ public:
     /** Destructor. */
     virtual ~Entities();
 
+    /** Attaches entity. */
+    virtual void attachEntity( Entity *entity );
+
+    /** Deletes all entities. */
+    virtual void deleteAllEntities();
+
+    /** Deletes entity. */
+    virtual void deleteEntity( Entity *entity );
+
+    /** Detaches entity. */
+    virtual void dettachEntity( Entity *entity );
+
+    /**
+     * Interpolates entities scene nodes and updates tracer rounds geometry.
+     * @param alpha interpolation coefficient (0 - previous state, 1 - current state)
+     */
+    virtual void interpolate( double alpha );
+
     /**
-     * Returns first unit of a given name if exists, otherwise returns 0.
+     * Updates entities. Inactive entities are removed from registries,
+     * units grid and targets lists are rebuilt before updating. Update is done in two
+     * phases. First top level units are updated in parallel, then all
+     * entities are updated serially. Collisions between units are detected
+     * and tracer rounds are updated after entities.
+     * @param timeStep [s] simulation time step
+     */
+    virtual void update( double timeStep );
+
+    /**
+     * Returns unit of a given name if exists, otherwise returns 0. If there
+     * is more than one such unit, the one named first is returned.
      * @param name entity name
      */
     Unit* getUnitByName( const std::string &name );
@@ -63,6 +114,104 @@ public:
 
     /** */
     void listAll();
+
+    /** Returns all top level units. */
+    const Units* getUnits() const;
+
+    /** Returns top level units of a given affiliation. */
+    const Units* getUnits( Affiliation affiliation ) const;
+
+    /** Returns all top level aerial units. */
+    const Units* getUnitsAerial() const;
+
+    /** Returns top level aerial units of a given affiliation. */
+    const Units* getUnitsAerial( Affiliation affiliation ) const;
+
+    /** Returns all top level surface units. */
+    const Units* getUnitsSurface() const;
+
+    /** Returns top level surface units of a given affiliation. */
+    const Units* getUnitsSurface( Affiliation affiliation ) const;
+
+    /** Returns all top level marine units. */
+    const Units* getUnitsMarine() const;
+
+    /** Returns top level marine units of a given affiliation. */
+    const Units* getUnitsMarine( Affiliation affiliation ) const;
+
+    /** Returns top level munitions. */
+    const Munitions* getMunitions() const;
+
+    /**
+     * Adds entities attached since the last call to registries. It is called
+     * at the beginning of every step and on load, so it only has to be called
+     * when registries are read right after attaching entities between steps.
+     * It must not be called while jobs are running.
+     */
+    void categorize();
+
+    /** Returns tracer rounds. */
+    inline Projectiles* getProjectiles() { return &_projectiles; }
+
+    /** Returns targets acquisition service. */
+    inline const Targets* getTargets() const { return &_targets; }
+
+    /** Returns units grid. */
+    inline const UnitsGrid* getUnitsGrid() const { return &_unitsGrid; }
+
+    /** Loads entities. */
+    virtual void load();
+
+private:
+
+    /** Units registry struct. */
+    struct Registry
+    {
+        Units all;              ///< all units
+        Units affiliated[ 4 ];  ///< units indexed by affiliation
+
+        /** Adds unit. */
+        void add( Unit *unit );
+
+        /** Removes all units. */
+        void clear();
+
+        /** Removes unit. */
+        void remove( Entity *entity );
+
+        /** Removes inactive units and clears their registered flags. */
+        void removeInactive( std::vector< bool > *registered );
+    };
+
+    Registry _units;            ///< top level units registry
+    Registry _unitsAerial;      ///< top level aerial units registry
+    Registry _unitsSurface;     ///< top level surface units registry
+    Registry _unitsMarine;      ///< top level marine units registry
+
+    Munitions _munitions;       ///< top level munitions
+
+    List _uncategorized;        ///< entities attached but not categorized yet
+
+    std::vector< bool > _registered;    ///< registered flags indexed by entity ID index
+
+    Projectiles _projectiles;   ///< tracer rounds
+
+    UnitsGrid _unitsGrid;       ///< top level units grid
+
+    Collisions _collisions;     ///< top level units collisions
+
+    Targets _targets;           ///< top level units targets
+
+    List _elevationEntities;                ///< top level entities requiring terrain elevation
+    std::vector< double > _elevation_x;     ///< [m] x-coordinates of entities requiring terrain elevation
+    std::vector< double > _elevation_y;     ///< [m] y-coordinates of entities requiring terrain elevation
+    std::vector< float >  _elevation_z;     ///< [m] terrain elevation at entities positions
+
+    /** Removes entity from registries. */
+    void unregister( Entity *entity );
+
+    /** Samples terrain elevation in batch for top level entities requiring it. */
+    void sampleElevation();
 };
 
 } // end of sim namespace
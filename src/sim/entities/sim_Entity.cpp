@@ -17,10 +17,18 @@
 
 #include <sim/entities/sim_Entity.h>
 
+#include <algorithm>
+
+#include <sim/sim_Elevation.h>
+#include <sim/sim_Log.h>
+
+#include <sim/cgi/sim_SceneQueue.h>
+
 #include <sim/entities/sim_Unit.h>
 #include <sim/entities/sim_Entities.h>
 
 #include <sim/utils/sim_Misc.h>
+#include <sim/utils/sim_String.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -28,63 +36,105 @@ using namespace sim;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-std::vector< UInt32 > Entity::_ids;
+Entity::Slots Entity::_slots;
+std::vector< UInt32 > Entity::_free;
+Entity::Names Entity::_names;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-UInt32 Entity::createId()
-{
-    if ( _ids.size() > 0 )
-    {
-        for ( UInt32 id = 0; id < SIM_ENTITIES_MAX; id++ )
-        {
-            bool exists = false;
+#define SIM_ENTITY_ID_GEN_MAX ( ( 1U << ( 32 - SIM_ENTITY_ID_INDEX_BITS ) ) - 1U )
 
-            std::vector< UInt32 >::iterator it = _ids.begin();
+////////////////////////////////////////////////////////////////////////////////
 
-            while ( it != _ids.end() )
-            {
-                if ( id == (*it) )
-                {
-                    exists = true;
-                    break;
-                }
+UInt32 Entity::createId( Entity *entity )
+{
+    UInt32 index = 0;
 
-                ++it;
-            }
+    if ( _free.size() > 0 )
+    {
+        index = _free.back();
+        _free.pop_back();
 
-            if ( !exists )
-            {
-                _ids.push_back( id );
-                return id;
-            }
+        // generation 0 is skipped so that ID 0 is never used
+        if ( _slots[ index ].generation < SIM_ENTITY_ID_GEN_MAX )
+        {
+            _slots[ index ].generation++;
+        }
+        else
+        {
+            _slots[ index ].generation = 1;
         }
     }
     else
     {
-        _ids.push_back( 0 );
-        return 0;
+        index = _slots.size();
+
+        if ( index > SIM_ENTITY_ID_INDEX_MASK )
+        {
+            Log::e() << "Entities table is full" << std::endl;
+
+#           ifdef SIM_EXITONERROR
+            exit( EXIT_FAILURE );
+#           endif
+
+            return 0;
+        }
+
+        Slot slot;
+
+        slot.entity = 0;
+        slot.generation = 1;
+
+        _slots.push_back( slot );
     }
 
-    return std::numeric_limits< UInt32 >::quiet_NaN();
+    _slots[ index ].entity = entity;
+
+    return ( _slots[ index ].generation << SIM_ENTITY_ID_INDEX_BITS ) | index;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Entity::removeId( UInt32 id )
 {
-    std::vector< UInt32 >::iterator it = _ids.begin();
+    if ( findEntity( id ) )
+    {
+        UInt32 index = id & SIM_ENTITY_ID_INDEX_MASK;
 
-    while ( it != _ids.end() )
+        _slots[ index ].entity = 0;
+        _free.push_back( index );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Entity* Entity::findEntity( UInt32 id )
+{
+    UInt32 index = id & SIM_ENTITY_ID_INDEX_MASK;
+
+    if ( index < _slots.size() )
     {
-        if ( id == (*it) )
+        if ( _slots[ index ].generation == ( id >> SIM_ENTITY_ID_INDEX_BITS ) )
         {
-            _ids.erase( it );
-            return;
+            return _slots[ index ].entity;
         }
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
-        ++it;
+const Entity::Ids* Entity::findIds( const std::string &name )
+{
+    Names::iterator it = _names.find( String::toLower( name ) );
+
+    if ( it != _names.end() )
+    {
+        return &( it->second );
     }
+
+    return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -92,7 +142,14 @@ void Entity::removeId( UInt32 id )
 Entity::Entity( Group *parent, State state, float life_span ) :
     Group( parent ),
 
-    _id ( createId() ),
+    _id ( createId( this ) ),
+
+    _timeStep ( 0.0 ),
+
+    _prev_valid ( false ),
+
+    _elevation_sample ( 0.0f ),
+    _elevation_sampled ( false ),
 
     _state ( state ),
     _active ( true ),
@@ -110,12 +167,15 @@ Entity::Entity( Group *parent, State state, float life_span ) :
 
     _att.zeroRotation();
 
-    if ( _parent == 0 )
+    if ( parent == 0 )
     {
-        _parent = Entities::instance();
+        parent = Entities::instance();
     }
 
-    setParent( _parent );
+    // entity is not attached to any group yet, so there is nothing to detach
+    _parent = 0;
+
+    setParent( parent );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -124,9 +184,11 @@ Entity::~Entity()
 {
     if ( _parentGroup.valid() )
     {
-        _parentGroup->removeChild( _root.get() );
+        SceneQueue::removeChild( _parentGroup.get(), _root.get() );
     }
 
+    removeName();
+
     ////////////////
     removeId( _id );
     ////////////////
@@ -188,10 +250,33 @@ void Entity::update( double timeStep )
         _life_time += _timeStep;
 
         updateElevation();
+
+        _elevation_sampled = false;
+
         updateVelocity();
         timeIntegration();
         updateVariables();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entity::interpolate( double alpha )
+{
+    ////////////////////////////
+    Group::interpolate( alpha );
+    ////////////////////////////
+
+    if ( _prev_valid )
+    {
+        Quat att;
+        att.slerp( alpha, _att_prev, _att );
 
+        _pat->setPosition( _pos_prev + ( _pos - _pos_prev ) * alpha );
+        _pat->setAttitude( att );
+    }
+    else
+    {
         _pat->setPosition( _pos );
         _pat->setAttitude( _att );
     }
@@ -199,6 +284,16 @@ void Entity::update( double timeStep )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Entity::storePrevious()
+{
+    _pos_prev = _pos;
+    _att_prev = _att;
+
+    _prev_valid = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Vec3 Entity::getAbsPos() const
 {
     if ( !isTopLevel() )
@@ -242,11 +337,34 @@ bool Entity::isTopLevel() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool Entity::isElevationRequired() const
+{
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entity::setElevationSample( float elevation )
+{
+    _elevation_sample = elevation;
+    _elevation_sampled = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Entity::recycle()
+{
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Entity::setPos( const Vec3 &pos )
 {
     _pos = pos;
+    _prev_valid = false;
+    _elevation_sampled = false;
     updateVariables();
-    _pat->setPosition( _pos );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -255,9 +373,9 @@ void Entity::setAtt( const Quat &att )
 {
     _att = att;
     _att *= 1.0/_att.length();
+    _prev_valid = false;
 
     updateVariables();
-    _pat->setAttitude( _att );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -289,8 +407,15 @@ void Entity::setHeading( float heading )
 
 void Entity::setName( const std::string &name )
 {
+    removeName();
+
     _name = name;
     _switch->setName( _name.c_str() );
+
+    if ( _name.length() > 0 )
+    {
+        _names[ String::toLower( _name ) ].push_back( _id );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -299,7 +424,7 @@ void Entity::setParent( Group *parent )
 {
     if ( _parentGroup.valid() )
     {
-        _parentGroup->removeChild( _root.get() );
+        SceneQueue::removeChild( _parentGroup.get(), _root.get() );
         _parentGroup = 0;
     }
 
@@ -327,7 +452,7 @@ void Entity::setParent( Group *parent )
             _parentGroup = _parent->getNode();
         }
 
-        if ( _parentGroup.valid() ) _parentGroup->addChild( _root.get() );
+        if ( _parentGroup.valid() ) SceneQueue::addChild( _parentGroup.get(), _root.get() );
     }
 }
 
@@ -337,23 +462,22 @@ void Entity::setState( State state )
 {
     _state = state;
 
-    if ( _state == Active )
+    bool active = ( _state == Active );
+
+    if ( active != _active )
     {
-        _active = true;
-        _switch->setAllChildrenOn();
+        _active = active;
+        SceneQueue::setAllChildren( _switch.get(), _active );
     }
-    else
+
+    for ( List::iterator it = _children.begin(); it != _children.end(); ++it )
     {
-        _active = false;
-        _switch->setAllChildrenOff();
+        if ( (*it) ) (*it)->setState( _state );
     }
 
-    List::iterator it = _children.begin();
-
-    while ( it != _children.end() )
+    for ( List::iterator it = _attached.begin(); it != _attached.end(); ++it )
     {
         (*it)->setState( _state );
-        ++it;
     }
 }
 
@@ -366,6 +490,31 @@ void Entity::setVelocity( float velocity )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Entity::removeName()
+{
+    if ( _name.length() > 0 )
+    {
+        Names::iterator it = _names.find( String::toLower( _name ) );
+
+        if ( it != _names.end() )
+        {
+            Ids::iterator id = std::find( it->second.begin(), it->second.end(), _id );
+
+            if ( id != it->second.end() )
+            {
+                it->second.erase( id );
+            }
+
+            if ( it->second.size() == 0 )
+            {
+                _names.erase( it );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Vec3 Entity::derivPos( const Quat &att, const Vec3 &vel )
 {
     return att * vel;
@@ -402,6 +551,18 @@ void Entity::updateElevation() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
+float Entity::getElevationSample()
+{
+    if ( _elevation_sampled )
+    {
+        return _elevation_sample;
+    }
+
+    return Elevation::instance()->getElevation( _pos.x(), _pos.y() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Entity::updateVariables()
 {
     _angles.set( _att );
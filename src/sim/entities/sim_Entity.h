@@ -20,6 +20,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <limits>
+#include <unordered_map>
 
 #include <osg/PositionAttitudeTransform>
 #include <osg/Switch>
@@ -57,12 +58,37 @@ class Entity : public Group
 {
 public:
 
-    /** Returns lowest available ID on success and NaN on failure. */
-    static UInt32 createId();
+    typedef std::vector< UInt32 > Ids;
+
+    /**
+     * @brief Creates entity ID.
+     *
+     * ID consists of entity index in entities table (lower bits) and
+     * generation of this index (upper bits). Indices of removed IDs are
+     * reused, but with incremented generation, so IDs of deleted entities
+     * do not refer to new ones. ID 0 is never created.
+     *
+     * @param entity entity
+     * @return entity ID
+     */
+    static UInt32 createId( Entity *entity );
 
     /** Removes entity ID from used IDs set. */
     static void removeId( UInt32 id );
 
+    /**
+     * @brief Returns entity of a given ID if exists, otherwise returns 0.
+     * @param id entity ID
+     */
+    static Entity* findEntity( UInt32 id );
+
+    /**
+     * @brief Returns IDs of entities of a given name (case insensitive).
+     * @param name entity name
+     * @return IDs in order of naming entities or 0 if there is none
+     */
+    static const Ids* findIds( const std::string &name );
+
     /** Constructor. */
     Entity( Group *parent = 0, State state = Active,
             float life_span = std::numeric_limits< float >::max() );
@@ -90,6 +116,19 @@ public:
      */
     virtual void update( double timeStep );
 
+    /**
+     * @brief Interpolates entity scene node between previous and current state.
+     *
+     * Entity scene nodes are modified on the view side only. Structural
+     * changes made during simulation step are queued using SceneQueue.
+     *
+     * @param alpha interpolation coefficient (0 - previous state, 1 - current state)
+     */
+    virtual void interpolate( double alpha );
+
+    /** Stores current position and attitude as previous state. */
+    void storePrevious();
+
     /** Returns entity absolute position. */
     Vec3 getAbsPos() const;
 
@@ -114,6 +153,12 @@ public:
 
     inline Angles getAngles() const { return _angles; }
 
+    /** Returns entity scene node position (interpolated). */
+    inline Vec3 getPosInterpolated() const { return _pat->getPosition(); }
+
+    /** Returns entity scene node attitude (interpolated). */
+    inline Quat getAttInterpolated() const { return _pat->getAttitude(); }
+
     inline std::string getName() const { return _name; }
 
     inline State getState() const { return _state; }
@@ -123,6 +168,22 @@ public:
     /** Returns true if entity is top level. */
     bool isTopLevel() const;
 
+    /**
+     * Returns true if terrain elevation at entity position is required every
+     * step, in which case it is sampled in batch before top level entities
+     * update.
+     */
+    virtual bool isElevationRequired() const;
+
+    /** Sets terrain elevation sampled in batch at entity position. */
+    void setElevationSample( float elevation );
+
+    /**
+     * @brief Recycles inactive entity instead of deleting it.
+     * @return true if entity has been recycled and must not be deleted
+     */
+    virtual bool recycle();
+
     virtual void setPos( const Vec3 &pos );
     virtual void setAtt( const Quat &att );
     virtual void setVel( const Vec3 &vel );
@@ -140,13 +201,25 @@ public:
 
 protected:
 
-    static std::vector< UInt32 > _ids;  ///< list of entities ID's being in use
+    /** Entities table slot. */
+    struct Slot
+    {
+        Entity *entity;         ///< entity, 0 if slot is free
+        UInt32 generation;      ///< slot generation
+    };
+
+    typedef std::vector< Slot > Slots;
+    typedef std::unordered_map< std::string, Ids > Names;
+
+    static Slots _slots;                ///< entities table indexed by ID index
+    static std::vector< UInt32 > _free; ///< indices of free slots
+    static Names _names;                ///< IDs indexed by lower case entity name
 
     osg::ref_ptr<osg::PositionAttitudeTransform> _pat;  ///<
     osg::ref_ptr<osg::Switch> _switch;                  ///< root for children
     osg::ref_ptr<osg::Group> _parentGroup;              ///< parent group
 
-    const UInt32 _id;           ///< entity ID
+    UInt32 _id;                 ///< entity ID
 
     double _timeStep;           ///< [s] time step
 
@@ -155,6 +228,14 @@ protected:
     Vec3 _vel;                  ///< [m/s] velocity expressed in BAS
     Vec3 _omg;                  ///< [rad/s] angular velocity expressed in BAS
 
+    Vec3 _pos_prev;             ///< [m] previous step position expressed in ENU
+    Quat _att_prev;             ///< previous step attitude
+
+    bool _prev_valid;           ///< specifies if previous state is valid
+
+    float _elevation_sample;    ///< [m] terrain elevation sampled in batch
+    bool _elevation_sampled;    ///< specifies if terrain elevation has been sampled in batch
+
     Angles _angles;             ///< [rad] attitude expressed as rotation angles from ENU to BAS in z-y-x convention
 
     State _state;               ///< entity state
@@ -166,6 +247,9 @@ protected:
 
     std::string _name;          ///< entity name
 
+    /** Removes entity name from names index. */
+    void removeName();
+
     /** Computes position derivative. */
     Vec3 derivPos( const Quat &att, const Vec3 &vel );
 
@@ -179,6 +263,12 @@ protected:
      */
     virtual void timeIntegration();
 
+    /**
+     * Returns terrain elevation at entity position, sampled in batch
+     * if available.
+     */
+    float getElevationSample();
+
     /** Updates elevation data. */
     virtual void updateElevation();
 
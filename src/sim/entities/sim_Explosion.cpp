@@ -17,10 +17,7 @@
 
 #include <sim/entities/sim_Explosion.h>
 
-#include <osgParticle/ModularEmitter>
-#include <osgParticle/ParticleSystemUpdater>
-#include <osgParticle/RandomRateCounter>
-#include <osgParticle/RadialShooter>
+#include <sim/cgi/sim_Effects.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -29,113 +26,27 @@ using namespace sim;
 ////////////////////////////////////////////////////////////////////////////////
 
 Explosion::Explosion( float scale, Group *parent ) :
-    Entity( parent, Active, 10.5f )
-{
-    createExplosionFire( scale );
-    createExplosionSmoke( scale );
-}
+    Entity( parent, Active, 10.5f ),
 
-////////////////////////////////////////////////////////////////////////////////
-
-Explosion::~Explosion() {}
+    _scale ( scale ),
+    _emitted ( false )
+{}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Explosion::createExplosionFire( float scale )
-{
-    osg::ref_ptr<osg::Group> group = new osg::Group();
-    _switch->addChild( group.get() );
-
-    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-    group->addChild( pat.get() );
-
-    pat->setAttitude( osg::Quat( 0.0, osg::Z_AXIS,
-                          -osg::PI_2, osg::Y_AXIS,
-                          -osg::PI_2, osg::X_AXIS ) );
-
-    osg::ref_ptr<osgParticle::ParticleSystem> ps = new osgParticle::ParticleSystem();
-    ps->getDefaultParticleTemplate().setLifeTime( 0.5f );
-    ps->getDefaultParticleTemplate().setShape( osgParticle::Particle::QUAD );
-    ps->getDefaultParticleTemplate().setSizeRange( osgParticle::rangef(1.0f*scale, 2.0f*scale) );
-    ps->getDefaultParticleTemplate().setAlphaRange( osgParticle::rangef(1.0f, 0.0f) );
-    ps->getDefaultParticleTemplate().setColorRange(
-        osgParticle::rangev4(osg::Vec4(1.0f,1.0f,0.5f,1.0f), osg::Vec4(1.0f,0.5f,0.0f,1.0f)) );
-    ps->setDefaultAttributes( getPath( "textures/explosion_fire.rgb" ), true, false );
-
-    osg::ref_ptr<osgParticle::RandomRateCounter> rrc = new osgParticle::RandomRateCounter();
-    rrc->setRateRange( 10, 20 );
-
-    osg::ref_ptr<osgParticle::RadialShooter> shooter = new osgParticle::RadialShooter();
-    shooter->setThetaRange( -osg::PI, osg::PI );
-    shooter->setPhiRange( -osg::PI, osg::PI );
-    shooter->setInitialSpeedRange( -10.0f, 10.0f );
-
-    osg::ref_ptr<osgParticle::ModularEmitter> emitter = new osgParticle::ModularEmitter();
-    emitter->setParticleSystem( ps.get() );
-    emitter->setCounter( rrc.get() );
-    emitter->setShooter( shooter.get() );
-    emitter->setEndless( false );
-    emitter->setLifeTime( 0.25f );
-
-    pat->addChild( emitter.get() );
-
-    osg::ref_ptr<osgParticle::ParticleSystemUpdater> updater = new osgParticle::ParticleSystemUpdater();
-    updater->addParticleSystem( ps.get() );
-
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    geode->addDrawable( ps.get() );
-
-    group->addChild( updater.get() );
-    group->addChild( geode.get() );
-}
+Explosion::~Explosion() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Explosion::createExplosionSmoke( float scale )
+void Explosion::update( double timeStep )
 {
-    osg::ref_ptr<osg::Group> group = new osg::Group();
-    _switch->addChild( group.get() );
-
-    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-    group->addChild( pat.get() );
-
-    pat->setAttitude( osg::Quat( 0.0, osg::Z_AXIS,
-                          -osg::PI_2, osg::Y_AXIS,
-                          -osg::PI_2, osg::X_AXIS ) );
-
-    osg::ref_ptr<osgParticle::ParticleSystem> ps = new osgParticle::ParticleSystem();
-    ps->getDefaultParticleTemplate().setLifeTime( 10.0f );
-    ps->getDefaultParticleTemplate().setShape( osgParticle::Particle::QUAD );
-    ps->getDefaultParticleTemplate().setSizeRange( osgParticle::rangef(1.0f*scale, 8.0f*scale) );
-    ps->getDefaultParticleTemplate().setAlphaRange( osgParticle::rangef(1.0f, 0.0f) );
-    ps->getDefaultParticleTemplate().setColorRange(
-        osgParticle::rangev4(osg::Vec4(0.0f,0.0f,0.0f,1.0f), osg::Vec4(0.5f,0.5f,0.5f,1.0f)) );
-    ps->setDefaultAttributes( getPath( "textures/explosion_smoke.rgb" ), false, false );
-
-    osg::ref_ptr<osgParticle::RandomRateCounter> rrc = new osgParticle::RandomRateCounter();
-    rrc->setRateRange( 10, 10 );
-
-    osg::ref_ptr<osgParticle::RadialShooter> shooter = new osgParticle::RadialShooter();
-    shooter->setThetaRange( -osg::PI, osg::PI );
-    shooter->setPhiRange( -osg::PI, osg::PI );
-    shooter->setInitialSpeedRange( -2.0f, 2.0f );
-
-    osg::ref_ptr<osgParticle::ModularEmitter> emitter = new osgParticle::ModularEmitter();
-    emitter->setStartTime( 0.1f );
-    emitter->setParticleSystem( ps.get() );
-    emitter->setCounter( rrc.get() );
-    emitter->setShooter( shooter.get() );
-    emitter->setEndless( false );
-    emitter->setLifeTime( 0.5f );
-
-    pat->addChild( emitter.get() );
-
-    osg::ref_ptr<osgParticle::ParticleSystemUpdater> updater = new osgParticle::ParticleSystemUpdater();
-    updater->addParticleSystem( ps.get() );
-
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    geode->addDrawable( ps.get() );
-
-    group->addChild( updater.get() );
-    group->addChild( geode.get() );
+    ///////////////////////////
+    Entity::update( timeStep );
+    ///////////////////////////
+
+    if ( !_emitted )
+    {
+        Effects::emitExplosion( _pos, _scale );
+        _emitted = true;
+    }
 }
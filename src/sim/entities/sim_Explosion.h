@@ -37,10 +37,14 @@ public:
     /** Destructor. */
     virtual ~Explosion();
 
+    /** Emits explosion particles on the first update, after position is set. */
+    virtual void update( double timeStep );
+
 private:
 
-    void createExplosionFire( float scale );
-    void createExplosionSmoke( float scale );
+    const float _scale;     ///< explosion scale
+
+    bool _emitted;          ///< specifies if explosion particles have been emitted
 };
 
 } // end of sim namespace
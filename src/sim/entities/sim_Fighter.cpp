@@ -47,7 +47,8 @@ Fighter::Fighter( Affiliation affiliation ) :
     _target_psi  ( 0.0f ),
     _target_rad  ( 0.0f ),
 
-    _engaged ( false )
+    _engaged   ( false ),
+    _targetNew ( false )
 {
     _target = new Target< UnitAerial >( this, ( _affiliation == Hostile ) ? Friend : Hostile,
                                         3000.0f, Convert::nmi2m( 3.0f ) );
@@ -62,15 +63,15 @@ Fighter::~Fighter()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Fighter::hit( UInt16 dp, const Munition *munition )
+void Fighter::hit( UInt16 dp, UInt32 shooterId, const Vec3 &vel )
 {
-    //////////////////////////////
-    Aircraft::hit( dp, munition );
-    //////////////////////////////
+    ////////////////////////////////////
+    Aircraft::hit( dp, shooterId, vel );
+    ////////////////////////////////////
 
     if ( !_ownship && ( _target_dist > 5000.0f || fabs( _target_bear ) > M_PI_2 ) )
     {
-        Aircraft *shooter = dynamic_cast< Aircraft* >( Entities::instance()->getEntityById( munition->getShooterId() ) );
+        Aircraft *shooter = dynamic_cast< Aircraft* >( Entities::instance()->getEntityById( shooterId ) );
 
         if ( shooter )
         {
@@ -119,14 +120,66 @@ void Fighter::setTarget( UnitAerial *target )
 
 void Fighter::update( double timeStep )
 {
-    if ( isActive() )
+    if ( isActive() && _targetNew )
     {
-        _target->update();
+        UnitAerial *target = _target->getTarget();
+
+        if ( target && !_ownship )
+        {
+            const Entities::Units *aerial = Entities::instance()->getUnitsAerial();
+            Entities::Units::const_iterator it = aerial->begin();
+
+            while ( it != aerial->end() )
+            {
+                Fighter *fighter = dynamic_cast< Fighter* >(*it);
+
+                if ( fighter )
+                {
+                    if ( fighter->getId() != _id )
+                    {
+                        Unit *fighterTarget = fighter->getTarget();
+
+                        if ( fighterTarget )
+                        {
+                            if ( fighterTarget->getId() == target->getId() )
+                            {
+                                _target->findNearest( target );
+
+                                if ( !_target->isValid() )
+                                {
+                                    _target->setTarget( target );
+                                }
+
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                ++it;
+            }
+        }
     }
 
+    _targetNew = false;
+
     /////////////////////////////
     Aircraft::update( timeStep );
     /////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Fighter::updateParallel( double timeStep )
+{
+    if ( isActive() )
+    {
+        _target->update();
+    }
+
+    /////////////////////////////////////
+    Aircraft::updateParallel( timeStep );
+    /////////////////////////////////////
 
     if ( isActive() )
     {
@@ -139,42 +192,9 @@ void Fighter::update( double timeStep )
                 _target->findNearest();
             }
 
-            UnitAerial *target = _target->getTarget();
-
-            if ( target && !_ownship )
-            {
-                List::iterator it = Entities::instance()->getEntities()->begin();
-
-                while ( it != Entities::instance()->getEntities()->end() )
-                {
-                    Fighter *fighter = dynamic_cast< Fighter* >(*it);
-
-                    if ( fighter )
-                    {
-                        if ( fighter->getId() != _id )
-                        {
-                            Unit *fighterTarget = fighter->getTarget();
-
-                            if ( fighterTarget )
-                            {
-                                if ( fighterTarget->getId() == target->getId() )
-                                {
-                                    _target->findNearest( target );
-
-                                    if ( !_target->isValid() )
-                                    {
-                                        _target->setTarget( target );
-                                    }
-
-                                    break;
-                                }
-                            }
-                        }
-                    }
-
-                    ++it;
-                }
-            }
+            // checking if other fighters are engaging the same target has to
+            // be done serially as it reads their targets
+            _targetNew = true;
         }
     }
 }
@@ -319,31 +339,26 @@ void Fighter::updateTrigger()
                 _trigger = true;
 
                 // avoid shooting to allies
-                List::iterator it = Entities::instance()->getEntities()->begin();
+                const Entities::Units *allies = Entities::instance()->getUnits( _affiliation );
+                Entities::Units::const_iterator it = allies->begin();
 
-                while ( it != Entities::instance()->getEntities()->end() )
+                while ( it != allies->end() )
                 {
-                    Unit *unit = dynamic_cast< Unit* >(*it);
+                    Unit *unit = (*it);
 
-                    if ( unit )
-                    {
-                        if ( unit->getAffiliation() == _affiliation )
-                        {
-                            Vec3 dir_enu = unit->getPos() - _pos;
-                            float dist = dir_enu.length();
+                    Vec3 dir_enu = unit->getPos() - _pos;
+                    float dist = dir_enu.length();
 
-                            if ( dist < _target_dist )
-                            {
-                                Vec3 dir_bas = _att.inverse() * dir_enu;
+                    if ( dist < _target_dist )
+                    {
+                        Vec3 dir_bas = _att.inverse() * dir_enu;
 
-                                float yz = sqrt( dir_bas.y()*dir_bas.y() + dir_bas.z()*dir_bas.z() );
+                        float yz = sqrt( dir_bas.y()*dir_bas.y() + dir_bas.z()*dir_bas.z() );
 
-                                if ( dir_bas.x() < -10.0 && yz < 4.0f * unit->getRadius() )
-                                {
-                                    _trigger = false;
-                                    break;
-                                }
-                            }
+                        if ( dir_bas.x() < -10.0 && yz < 4.0f * unit->getRadius() )
+                        {
+                            _trigger = false;
+                            break;
                         }
                     }
 
@@ -45,9 +45,10 @@ public:
      * Demages fighter.
      * Sets shooter as new target when current target is far.
      * @param dp demage points
-     * @param munition munition which hit unit
+     * @param shooterId ID of the unit which fired munition
+     * @param vel [m/s] munition velocity expressed in ENU
      */
-    virtual void hit( UInt16 dp, const Munition *munition );
+    virtual void hit( UInt16 dp, UInt32 shooterId, const Vec3 &vel );
 
     /**
      * Reports hit by fighter's munition.
@@ -59,6 +60,9 @@ public:
     /** Updates entity. */
     virtual void update( double timeStep );
 
+    /** Updates target. */
+    virtual void updateParallel( double timeStep );
+
     /** Returns aircraft target unit pointer. */
     virtual UnitAerial* getTarget() const;
 
@@ -79,6 +83,7 @@ protected:
     float _target_rad;      ///< [m] target radius
 
     bool _engaged;          ///< specifies if aircraft is engaged into combat
+    bool _targetNew;        ///< specifies if target has been found in the current step
 
     virtual void updateControls();
     virtual void updateDestination();
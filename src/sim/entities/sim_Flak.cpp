@@ -17,15 +17,13 @@
 
 #include <sim/entities/sim_Flak.h>
 
-#include <osgParticle/ModularEmitter>
-#include <osgParticle/ParticleSystemUpdater>
-
 #include <sim/cgi/sim_Effects.h>
 #include <sim/cgi/sim_Geometry.h>
 #include <sim/cgi/sim_Models.h>
 #include <sim/cgi/sim_Textures.h>
 
 #include <sim/entities/sim_Entities.h>
+#include <sim/entities/sim_Pool.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -38,6 +36,25 @@ const float Flak::_r_limit_2 = Flak::_r_limit * Flak::_r_limit;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+Flak* Flak::create( UInt32 shooterId, float fuse_time )
+{
+    Flak *flak = Pool< Flak >::get();
+
+    if ( flak )
+    {
+        flak->reset( shooterId );
+        flak->_fuse_time = fuse_time;
+    }
+    else
+    {
+        flak = new Flak( shooterId, fuse_time );
+    }
+
+    return flak;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Flak::Flak( UInt32 shooterId, float fuse_time ) :
     Bullet( 10, shooterId, 15.0f, 0 ),
 
@@ -51,6 +68,19 @@ Flak::~Flak() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool Flak::recycle()
+{
+    if ( Pool< Flak >::put( this ) )
+    {
+        removeId( _id );
+        return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Flak::update( double timeStep )
 {
     ///////////////////////////
@@ -90,26 +120,25 @@ void Flak::rangeDamage()
 
         _vel.x() = 0.0;
 
-        List entities = *Entities::instance()->getEntities();
-        List::iterator it = entities.begin();
+        UnitsGrid::Units units;
+        Entities::instance()->getUnitsGrid()->getUnits( _pos, _r_limit, &units );
 
-        while ( it != entities.end() )
+        UnitsGrid::Units::iterator it = units.begin();
+
+        while ( it != units.end() )
         {
-            Unit *target = dynamic_cast< Unit* >(*it);
+            Unit *target = (*it);
 
-            if ( target )
+            if ( target->isActive() )
             {
-                if ( target->isActive() )
-                {
-                    float r2 = ( target->getPos() - _pos ).length2() - target->getRadius2();
+                float r2 = ( target->getPos() - _pos ).length2() - target->getRadius2();
 
-                    if ( r2 < _r_limit_2 )
-                    {
-                        UInt16 dp = (float)_dp * ( 1.0f - r2 / _r_limit_2 );
+                if ( r2 < _r_limit_2 )
+                {
+                    UInt16 dp = (float)_dp * ( 1.0f - r2 / _r_limit_2 );
 
-                        target->hit( dp, this );
-                        reportTargetHit( target );
-                    }
+                    target->hit( dp, this );
+                    reportTargetHit( target );
                 }
             }
 
@@ -124,41 +153,16 @@ void Flak::rangeDamage()
 
 void Flak::createBurst()
 {
-    osg::ref_ptr<osg::Group> group = new osg::Group();
-    _switch->addChild( group.get() );
-
-    osg::ref_ptr<osgParticle::ParticleSystem> ps = new osgParticle::ParticleSystem();
-    ps->getDefaultParticleTemplate().setLifeTime( _life_span - 3.0f );
-    ps->getDefaultParticleTemplate().setShape( osgParticle::Particle::QUAD );
-    ps->getDefaultParticleTemplate().setSizeRange( osgParticle::rangef(7.0f, 10.0f) );
-    ps->getDefaultParticleTemplate().setAlphaRange( osgParticle::rangef(0.9f, 0.0f) );
-    ps->getDefaultParticleTemplate().setColorRange(
-        osgParticle::rangev4(osg::Vec4(1.0f,1.0f,1.0f,1.0f), osg::Vec4(1.0f,1.0f,0.0f,1.0f)) );
-    ps->setDefaultAttributes( getPath( "textures/flak.rgb" ), false, false );
-
-    osg::ref_ptr<osgParticle::RandomRateCounter> rrc = new osgParticle::RandomRateCounter();
-    rrc->setRateRange( 10.0f, 10.0f );
-
-    osg::ref_ptr<osgParticle::RadialShooter> shooter = new osgParticle::RadialShooter();
-    shooter->setThetaRange( -M_PI, M_PI );
-    shooter->setPhiRange( -M_PI, M_PI );
-    shooter->setInitialSpeedRange( 0.0f, 0.0f );
-
-    osg::ref_ptr<osgParticle::ModularEmitter> emitter = new osgParticle::ModularEmitter();
-    emitter->setParticleSystem( ps.get() );
-    emitter->setCounter( rrc.get() );
-    emitter->setShooter( shooter.get() );
-    emitter->setEndless( false );
-    emitter->setLifeTime( 0.1f );
-
-    group->addChild( emitter.get() );
-
-    osg::ref_ptr<osgParticle::ParticleSystemUpdater> updater = new osgParticle::ParticleSystemUpdater();
-    updater->addParticleSystem( ps.get() );
-
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    geode->addDrawable( ps.get() );
-
-    group->addChild( updater.get() );
-    group->addChild( geode.get() );
+    Effects::emitFlakBurst( _pos, _life_span - 3.0f );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Flak::reset( UInt32 shooterId )
+{
+    ///////////////////////////
+    Bullet::reset( shooterId );
+    ///////////////////////////
+
+    _exploded = false;
 }
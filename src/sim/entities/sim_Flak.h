@@ -34,12 +34,22 @@ public:
     static const float _r_limit;    ///< [m] range damage limit
     static const float _r_limit_2;  ///< [m^2] range damage limit squared
 
+    /**
+     * @brief Returns recycled flak if available, otherwise creates new one.
+     * @param shooterId shooter ID
+     * @param fuse_time [s] fuse time delay
+     */
+    static Flak* create( UInt32 shooterId, float fuse_time );
+
     /** Constructor. */
     Flak( UInt32 shooterId, float fuse_time );
 
     /** Destructor. */
     virtual ~Flak();
 
+    /** Puts inactive flak into pool. */
+    virtual bool recycle();
+
     /** Updates tracer. */
     void update( double timeStep );
 
@@ -54,6 +64,9 @@ private:
     void rangeDamage();
 
     void createBurst();
+
+    /** Resets recycled flak. */
+    void reset( UInt32 shooterId );
 };
 
 } // end of sim namespace
@@ -17,6 +17,8 @@
 
 #include <sim/entities/sim_Group.h>
 
+#include <algorithm>
+
 #include <sim/entities/sim_Entity.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -26,11 +28,16 @@ using namespace sim;
 ////////////////////////////////////////////////////////////////////////////////
 
 Group::Group( Group *parent ) :
-    _parent ( parent )
+    _parent ( parent ),
+
+    _updating ( false ),
+    _compact ( false )
 {
     _root = new osg::Group();
 
     _children.clear();
+    _attached.clear();
+    _deleted.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -46,7 +53,14 @@ void Group::attachEntity( Entity *entity )
 {
     if ( entity )
     {
-        _children.push_back( entity );
+        if ( _updating )
+        {
+            _attached.push_back( entity );
+        }
+        else
+        {
+            _children.push_back( entity );
+        }
     }
 }
 
@@ -54,14 +68,19 @@ void Group::attachEntity( Entity *entity )
 
 void Group::deleteAllEntities()
 {
-    List::iterator it = _children.begin();
-
-    while ( it != _children.end() )
+    for ( List::iterator it = _children.begin(); it != _children.end(); ++it )
     {
         DELPTR( *it );
+    }
 
-        it = _children.erase( it );
+    for ( List::iterator it = _attached.begin(); it != _attached.end(); ++it )
+    {
+        DELPTR( *it );
     }
+
+    _children.clear();
+    _attached.clear();
+    _deleted.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -70,19 +89,35 @@ void Group::deleteEntity( Entity *entity )
 {
     if ( entity )
     {
-        List::iterator it = _children.begin();
+        if ( _updating )
+        {
+            if ( entity->getParent() != this ) return;
+
+            // entity is not updated anymore, but it is deleted after update loop
+            entity->setState( Inactive );
+
+            _deleted.push_back( entity );
+            _compact = true;
+
+            return;
+        }
 
-        while ( it != _children.end() )
+        List::iterator it = std::find( _attached.begin(), _attached.end(), entity );
+
+        if ( it != _attached.end() )
         {
-            if ( (*it) == entity )
-            {
-                DELPTR( *it );
-                _children.erase( it );
+            _attached.erase( it );
+            DELPTR( entity );
 
-                return;
-            }
+            return;
+        }
+
+        it = std::find( _children.begin(), _children.end(), entity );
 
-            ++it;
+        if ( it != _children.end() )
+        {
+            _children.erase( it );
+            DELPTR( entity );
         }
     }
 }
@@ -93,18 +128,28 @@ void Group::dettachEntity( Entity *entity )
 {
     if ( entity )
     {
-        List::iterator it = _children.begin();
+        List::iterator it = std::find( _attached.begin(), _attached.end(), entity );
+
+        if ( it != _attached.end() )
+        {
+            _attached.erase( it );
+
+            return;
+        }
+
+        it = std::find( _children.begin(), _children.end(), entity );
 
-        while ( it != _children.end() )
+        if ( it != _children.end() )
         {
-            if ( (*it) == entity )
+            if ( _updating )
+            {
+                (*it) = 0;
+                _compact = true;
+            }
+            else
             {
                 _children.erase( it );
-
-                return;
             }
-
-            ++it;
         }
     }
 }
@@ -120,16 +165,14 @@ Group::List* Group::getEntities()
 
 Entity* Group::getEntityById( UInt32 id )
 {
-    List::iterator it = _children.begin();
+    Entity *entity = Entity::findEntity( id );
 
-    while ( it != _children.end() )
+    if ( entity )
     {
-        if ( (*it)->getId() == id )
+        if ( entity->getParent() == this )
         {
-            return (*it);
+            return entity;
         }
-
-        ++it;
     }
 
     return 0;
@@ -156,31 +199,119 @@ void Group::load()
 
 void Group::update( double timeStep )
 {
-    List::iterator it = _children.begin();
-
     // delete innactive entities (before updating)
-    while ( it != _children.end() )
+    compact( true );
+
+    _updating = true;
+
+    // entities attached during update are not updated until next step,
+    // entities detached during update are replaced with null,
+    // entities deleted during update are deactivated and queued
+    for ( UInt32 i = 0; i < _children.size(); i++ )
     {
-        if ( (*it) )
+        Entity *entity = _children[ i ];
+
+        if ( entity )
         {
-            if ( (*it)->getState() == Inactive )
+            if ( entity->isActive() )
             {
-                DELPTR( *it );
-                it = _children.erase( it );
+                entity->storePrevious();
+                entity->update( timeStep );
+            }
+        }
+    }
+
+    _updating = false;
+
+    if ( _compact )
+    {
+        compact( false );
+    }
+
+    if ( _attached.size() > 0 )
+    {
+        _children.insert( _children.end(), _attached.begin(), _attached.end() );
+        _attached.clear();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Group::interpolate( double alpha )
+{
+    for ( UInt32 i = 0; i < _children.size(); i++ )
+    {
+        Entity *entity = _children[ i ];
+
+        if ( entity )
+        {
+            if ( entity->isActive() ) entity->interpolate( alpha );
+        }
+    }
+
+    // entities attached after update are already placed in the scene graph
+    for ( UInt32 i = 0; i < _attached.size(); i++ )
+    {
+        if ( _attached[ i ]->isActive() ) _attached[ i ]->interpolate( alpha );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Group::compact( bool deleteInactive )
+{
+    // entities deleted during update are looked up by binary search
+    std::sort( _deleted.begin(), _deleted.end() );
+
+    UInt32 size = 0;
+
+    for ( UInt32 i = 0; i < _attached.size(); i++ )
+    {
+        Entity *entity = _attached[ i ];
+
+        if ( std::binary_search( _deleted.begin(), _deleted.end(), entity ) )
+        {
+            DELPTR( entity );
+        }
+        else
+        {
+            _attached[ size ] = entity;
+            size++;
+        }
+    }
+
+    _attached.resize( size );
+
+    size = 0;
+
+    for ( UInt32 i = 0; i < _children.size(); i++ )
+    {
+        Entity *entity = _children[ i ];
+
+        if ( entity )
+        {
+            if ( std::binary_search( _deleted.begin(), _deleted.end(), entity ) )
+            {
+                DELPTR( entity );
+            }
+            else if ( deleteInactive && entity->getState() == Inactive )
+            {
+                if ( !entity->recycle() )
+                {
+                    DELPTR( entity );
+                }
             }
             else
             {
-                ++it;
+                _children[ size ] = entity;
+                size++;
             }
         }
     }
 
-    // due to the fact that vector can be modified in update loop.
-    List children = _children;
+    _children.resize( size );
 
-    // updating after deleting due to keep innactive entities for one more step
-    for ( List::iterator it = children.begin(); it != children.end(); ++it )
-    {
-        if ( (*it)->isActive() ) (*it)->update( timeStep );
-    }
+    _deleted.clear();
+
+    _compact = false;
 }
@@ -29,7 +29,18 @@ namespace sim
 {
 class Entity;
 
-/** @brief Entities group class. */
+/**
+ * @brief Entities group class.
+ *
+ * Structural changes issued while group is being updated are deferred.
+ * Entities attached during update are queued and appended to children list
+ * after update loop. Entities detached during update leave empty (null) slots
+ * in children list. Entities deleted during update are deactivated and queued,
+ * they are deleted together with compacting empty slots after update loop, so
+ * entity might safely delete itself while being updated.
+ * Inactive entities are deleted at the beginning of the next update, unless
+ * they are recycled (see Entity::recycle()).
+ */
 class Group : public Base
 {
 public:
@@ -54,7 +65,10 @@ public:
     /** Detaches entity. */
     virtual void dettachEntity( Entity *entity );
 
-    /** Returns all children entities list. */
+    /**
+     * Returns all children entities list. While group is being updated
+     * the list may contain null entries.
+     */
     virtual List* getEntities();
 
     /**
@@ -75,12 +89,32 @@ public:
     /** Updates all children entities. */
     virtual void update( double timeStep );
 
+    /**
+     * Interpolates all children entities scene nodes between previous
+     * and current state, including entities attached but not updated yet.
+     * @param alpha interpolation coefficient (0 - previous state, 1 - current state)
+     */
+    virtual void interpolate( double alpha );
+
 protected:
 
     Group *_parent;     ///< parent node
     List _children;     ///< children nodes
+    List _attached;     ///< children nodes attached during update
+    List _deleted;      ///< children nodes deleted during update
 
     osg::ref_ptr<osg::Group> _root;     ///< root group node
+
+    bool _updating;     ///< specifies if group is being updated
+    bool _compact;      ///< specifies if children list contains empty slots
+
+private:
+
+    /**
+     * Deletes entities queued for deletion and inactive entities (optionally)
+     * and removes empty slots from children list.
+     */
+    void compact( bool deleteInactive );
 };
 
 }
@@ -18,7 +18,6 @@
 #include <sim/entities/sim_Gunner.h>
 
 #include <sim/entities/sim_Flak.h>
-#include <sim/entities/sim_Tracer.h>
 
 #include <sim/utils/sim_Inertia.h>
 #include <sim/utils/sim_Convert.h>
@@ -172,10 +171,9 @@ void Gunner::updateWeapons()
             {
                 _shoot_time = 0.0f;
 
-                Tracer *bullet = new Tracer( _parent_valid ? _parent_id : _id );
-
-                bullet->setPos( _pos_abs + _target_dir * Vec3( -1.0, 0.0, 0.0 ) * 20.0f );
-                bullet->setAtt( _target_dir );
+                Entities::instance()->getProjectiles()->fire( _parent_valid ? _parent_id : _id,
+                                                              _pos_abs + _target_dir * Vec3( -1.0, 0.0, 0.0 ) * 20.0f,
+                                                              _target_dir );
             }
         }
     }
@@ -242,7 +240,7 @@ void GunnerFlak::updateWeapons()
                             break;
                         }
 
-                        Flak *bullet = new Flak( _parent_valid ? _parent_id : _id, fuse_time );
+                        Flak *bullet = Flak::create( _parent_valid ? _parent_id : _id, fuse_time );
 
                         bullet->setPos( _pos_abs + dir * Vec3( -1.0, 0.0, 0.0 ) * offset );
                         bullet->setAtt( dir );
@@ -52,13 +52,13 @@ void Kamikaze::collide( Unit *unit )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Kamikaze::update( double timeStep )
+void Kamikaze::updateParallel( double timeStep )
 {
     if ( isActive() ) _target->update();
 
-    /////////////////////////////
-    Aircraft::update( timeStep );
-    /////////////////////////////
+    /////////////////////////////////////
+    Aircraft::updateParallel( timeStep );
+    /////////////////////////////////////
 
     if ( isActive() )
     {
@@ -45,8 +45,8 @@ public:
     /** Overloaded due to extra demage from kamikaze when collide. */
     virtual void collide( Unit *unit );
 
-    /** Updates entity. */
-    virtual void update( double timeStep );
+    /** Updates target. */
+    virtual void updateParallel( double timeStep );
 
     /** Returns aircraft target unit pointer. */
     virtual UnitMarine* getTarget() const;
@@ -26,6 +26,10 @@ using namespace sim;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+UnitsGrid::Units Munition::_candidates;
+
+////////////////////////////////////////////////////////////////////////////////
+
 Munition::Munition( UInt16 dp, UInt32 shooterId, float life_span, Group *parent ) :
     Entity( parent, Active, life_span ),
 
@@ -66,35 +70,35 @@ void Munition::update( double timeStep )
     {
         if ( isTopLevel() )
         {
-            List::iterator it = Entities::instance()->getEntities()->begin();
+            Vec3 v1 = _att * ( _vel * timeStep );
 
-            while ( it != Entities::instance()->getEntities()->end() )
+            Entities::instance()->getUnitsGrid()->getUnits( _pos, _pos + v1, &_candidates );
+
+            UnitsGrid::Units::iterator it = _candidates.begin();
+
+            while ( it != _candidates.end() )
             {
-                Unit *target = dynamic_cast< Unit* >(*it);
+                Unit *target = (*it);
 
-                if ( target )
+                if ( target->isActive() )
                 {
-                    if ( target->isActive() )
-                    {
-                        Vec3 v1 = _att * ( _vel * timeStep );
-                        Vec3 v2 = target->getPos() - _pos;
+                    Vec3 v2 = target->getPos() - _pos;
 
-                        float len1 = v1.length();
+                    float len1 = v1.length();
 
-                        Vec3 v1_norm = v1 * (1.0/len1);
+                    Vec3 v1_norm = v1 * (1.0/len1);
 
-                        float proj2 = v2 * v1_norm;
+                    float proj2 = v2 * v1_norm;
 
-                        if ( proj2 >= 0.0 && proj2 <= len1 )
+                    if ( proj2 >= 0.0 && proj2 <= len1 )
+                    {
+                        float dist2 = ( v2 - v1_norm * proj2 ).length2();
+
+                        if ( dist2 < target->getRadius2() && _shooterId != target->getId() )
                         {
-                            float dist2 = ( v2 - v1_norm * proj2 ).length2();
-
-                            if ( dist2 < target->getRadius2() && _shooterId != target->getId() )
-                            {
-                                hit( target );
-                                setState( Inactive );
-                                break;
-                            }
+                            hit( target );
+                            setState( Inactive );
+                            break;
                         }
                     }
                 }
@@ -132,3 +136,31 @@ void Munition::reportTargetHit( Unit *target )
         shooter->reportTargetHit( target );
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Munition::reset( UInt32 shooterId )
+{
+    // recycled munition gets new ID, so it is not mistaken for the old one
+    removeId( _id );
+    _id = createId( this );
+
+    _shooterId = shooterId;
+
+    _pos.set( 0.0, 0.0, 0.0 );
+    _att.zeroRotation();
+    _vel.set( 0.0, 0.0, 0.0 );
+    _omg.set( 0.0, 0.0, 0.0 );
+
+    _angles = Angles();
+
+    _life_time = 0.0f;
+
+    setState( Active );
+
+    // scene graph node is still attached to the parent node
+    if ( _parent )
+    {
+        _parent->attachEntity( this );
+    }
+}
@@ -20,6 +20,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <sim/entities/sim_Unit.h>
+#include <sim/entities/sim_UnitsGrid.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -45,6 +46,7 @@ public:
      *
      * Itarates throught top level unit type entities checking intersections
      * of projectile pathway with unit bounding sphere defined as unit radius.
+     * Only units reported by the entities grid for the pathway are tested.
      * If intersection is detected hits unit with specified damage points.
      *
      * @param timeStep
@@ -58,6 +60,8 @@ public:
 
 protected:
 
+    static UnitsGrid::Units _candidates;    ///< hit test candidates buffer
+
     const UInt16 _dp;   ///< damage points
 
     UInt32 _shooterId;  ///< shooter ID
@@ -68,6 +72,12 @@ protected:
     virtual void hit( Unit *target );
 
     virtual void reportTargetHit( Unit *target );
+
+    /**
+     * @brief Resets recycled munition so it can be fired again.
+     * @param shooterId shooter ID
+     */
+    virtual void reset( UInt32 shooterId );
 };
 
 } // end of sim namespace
@@ -0,0 +1,129 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_POOL_H
+#define SIM_POOL_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <sim/sim_Defines.h>
+#include <sim/sim_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Recycled entities pool class template.
+ *
+ * Inactive entities of short life span (e.g. bullets) are stored here instead
+ * of being deleted, so they can be reused without allocating memory, creating
+ * scene graph nodes and attaching them to the scene graph again. Pooled
+ * entities keep their nodes attached to the top level entities node, but are
+ * switched off as inactive.
+ *
+ * @see Entity::recycle()
+ */
+template < class TYPE >
+class Pool
+{
+public:
+
+    typedef std::vector< TYPE* > Items;
+
+    /** Deletes all pooled entities. */
+    static void clear()
+    {
+        for ( typename Items::iterator it = _items.begin(); it != _items.end(); ++it )
+        {
+            DELPTR( *it );
+        }
+
+        _items.clear();
+    }
+
+    /**
+     * @brief Takes entity out of pool.
+     * @return pooled entity on success or 0 if pool is empty
+     */
+    static TYPE* get()
+    {
+        if ( _items.size() > 0 )
+        {
+            TYPE *item = _items.back();
+            _items.pop_back();
+
+            _reused++;
+
+            return item;
+        }
+
+        _allocated++;
+
+        return 0;
+    }
+
+    /**
+     * @brief Puts entity into pool.
+     * @param item inactive entity
+     * @return true if entity has been taken over by pool, false if pool is full
+     */
+    static bool put( TYPE *item )
+    {
+        if ( _items.size() < SIM_POOL_MAX )
+        {
+            _items.push_back( item );
+            return true;
+        }
+
+        return false;
+    }
+
+    /** Returns number of entities currently stored in pool. */
+    inline static UInt32 getSize() { return _items.size(); }
+
+    /** Returns pool capacity. */
+    inline static UInt32 getCapacity() { return SIM_POOL_MAX; }
+
+    /** Returns number of requests served from pool. */
+    inline static UInt32 getReused() { return _reused; }
+
+    /** Returns number of requests that needed new entity. */
+    inline static UInt32 getAllocated() { return _allocated; }
+
+private:
+
+    static Items _items;        ///< pooled entities
+
+    static UInt32 _reused;      ///< number of requests served from pool
+    static UInt32 _allocated;   ///< number of requests that needed new entity
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template < class TYPE > typename Pool< TYPE >::Items Pool< TYPE >::_items;
+
+template < class TYPE > UInt32 Pool< TYPE >::_reused = 0;
+template < class TYPE > UInt32 Pool< TYPE >::_allocated = 0;
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_POOL_H
@@ -0,0 +1,392 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/entities/sim_Projectiles.h>
+
+#include <algorithm>
+
+#include <sim/sim_Elevation.h>
+
+#include <sim/cgi/sim_Models.h>
+
+#include <sim/entities/sim_Entities.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const UInt16 Projectiles::_dp        = 25;
+const float  Projectiles::_life_span = 5.0f;
+const float  Projectiles::_vel_m     = 600.0f;
+const float  Projectiles::_range     = 500.0f;
+const float  Projectiles::_length    = 6.0f;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Projectiles::Projectiles() :
+    _fired ( 0 )
+{
+    _geode = new osg::Geode();
+    _geometry = new osg::Geometry();
+
+    _vertices = new osg::Vec3Array();
+    _colors   = new osg::Vec4Array();
+
+    _drawArrays = new osg::DrawArrays( osg::PrimitiveSet::LINES, 0, 0 );
+
+    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();
+    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
+
+    _geometry->setVertexArray( _vertices.get() );
+    _geometry->addPrimitiveSet( _drawArrays.get() );
+
+    _geometry->setNormalArray( n.get() );
+    _geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
+
+    _geometry->setColorArray( _colors.get() );
+    _geometry->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+
+    _geometry->setDataVariance( osg::Object::DYNAMIC );
+    _geometry->setUseDisplayList( false );
+    _geometry->setUseVertexBufferObjects( true );
+
+    _geode->addDrawable( _geometry.get() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Projectiles::~Projectiles() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Projectiles::clear()
+{
+    _pos_x.clear();
+    _pos_y.clear();
+    _pos_z.clear();
+    _vel_x.clear();
+    _vel_y.clear();
+    _vel_z.clear();
+
+    _life_time.clear();
+    _elevation.clear();
+    _shooterId.clear();
+    _expired.clear();
+
+    _fired = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Projectiles::fire( UInt32 shooterId, const Vec3 &pos, const Quat &att )
+{
+    Vec3 vel = att * Vec3( -_vel_m, 0.0, 0.0 );
+
+    _pos_x.push_back( pos.x() );
+    _pos_y.push_back( pos.y() );
+    _pos_z.push_back( pos.z() );
+    _vel_x.push_back( vel.x() );
+    _vel_y.push_back( vel.y() );
+    _vel_z.push_back( vel.z() );
+
+    _life_time.push_back( 0.0f );
+    _elevation.push_back( 0.0f );
+    _shooterId.push_back( shooterId );
+    _expired.push_back( 0 );
+
+    _fired++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Projectiles::load()
+{
+    _geode->setStateSet( Models::getTracerStateSet() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Projectiles::update( double timeStep )
+{
+    // rounds fired within this step are not moved until the next one
+    const UInt32 count = _shooterId.size() - _fired;
+
+    _fired = 0;
+
+    if ( count > 0 )
+    {
+        Elevation::instance()->getElevation( &_pos_x[ 0 ], &_pos_y[ 0 ], &_elevation[ 0 ], count );
+    }
+
+    // time integration
+    const float dt = timeStep;
+
+    for ( UInt32 i = 0; i < count; i++ )
+    {
+        _life_time[ i ] += dt;
+
+        _pos_x[ i ] += _vel_x[ i ] * timeStep;
+        _pos_y[ i ] += _vel_y[ i ] * timeStep;
+        _pos_z[ i ] += _vel_z[ i ] * timeStep;
+    }
+
+    // rounds binning, rounds pathways within the step are not longer than
+    // the distance travelled at muzzle velocity, which is used as cell margin
+    _binned.resize( count );
+
+    for ( UInt32 i = 0; i < count; i++ )
+    {
+        _binned[ i ] = Binned( UnitsGrid::getKey( UnitsGrid::getCell( _pos_x[ i ] ),
+                                                  UnitsGrid::getCell( _pos_y[ i ] ) ), i );
+    }
+
+    std::sort( _binned.begin(), _binned.end() );
+
+    // hit tests
+    const UnitsGrid *grid = Entities::instance()->getUnitsGrid();
+
+    const double margin = _vel_m * timeStep;
+
+    // rounds fired in a burst share the same shooter
+    UInt32 shooterId = 0;
+    Unit *shooter = 0;
+
+    UInt32 first = 0;
+
+    while ( first < count )
+    {
+        UInt32 last = first + 1;
+
+        while ( last < count && _binned[ last ].first == _binned[ first ].first )
+        {
+            last++;
+        }
+
+        UInt32 index = _binned[ first ].second;
+
+        grid->getUnits( UnitsGrid::getCell( _pos_x[ index ] ),
+                        UnitsGrid::getCell( _pos_y[ index ] ),
+                        margin, &_candidates );
+
+        gatherCandidates();
+
+        for ( UInt32 j = first; j < last && _cand_id.size() > 0; j++ )
+        {
+            UInt32 i = _binned[ j ].second;
+
+            int hit = testHit( i, timeStep );
+
+            if ( hit >= 0 )
+            {
+                Unit *target = _candidates[ hit ];
+
+                target->hit( _dp, _shooterId[ i ], Vec3( _vel_x[ i ], _vel_y[ i ], _vel_z[ i ] ) );
+
+                if ( _shooterId[ i ] != shooterId )
+                {
+                    shooterId = _shooterId[ i ];
+                    shooter = dynamic_cast< Unit* >( Entities::instance()->getEntityById( shooterId ) );
+                }
+
+                if ( shooter )
+                {
+                    shooter->reportTargetHit( target );
+                }
+
+                // target destroyed by this round cannot be hit by the next ones
+                if ( !target->isActive() )
+                {
+                    _cand_r2[ hit ] = -1.0f;
+                }
+
+                _expired[ i ] = 1;
+            }
+        }
+
+        first = last;
+    }
+
+    for ( UInt32 i = 0; i < count; i++ )
+    {
+        if ( _pos_z[ i ] < _elevation[ i ] || _life_time[ i ] > _life_span )
+        {
+            _expired[ i ] = 1;
+        }
+    }
+
+    removeExpired();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Projectiles::gatherCandidates()
+{
+    _cand_x.clear();
+    _cand_y.clear();
+    _cand_z.clear();
+    _cand_r2.clear();
+    _cand_id.clear();
+
+    UInt32 size = 0;
+
+    for ( UInt32 i = 0; i < _candidates.size(); i++ )
+    {
+        Unit *unit = _candidates[ i ];
+
+        if ( unit->isActive() )
+        {
+            Vec3 pos = unit->getPos();
+
+            _cand_x.push_back( pos.x() );
+            _cand_y.push_back( pos.y() );
+            _cand_z.push_back( pos.z() );
+            _cand_r2.push_back( unit->getRadius2() );
+            _cand_id.push_back( unit->getId() );
+
+            _candidates[ size ] = unit;
+            size++;
+        }
+    }
+
+    // candidates list is kept parallel to arrays
+    _candidates.resize( size );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Projectiles::removeExpired()
+{
+    UInt32 size = 0;
+
+    for ( UInt32 i = 0; i < _expired.size(); i++ )
+    {
+        if ( !_expired[ i ] )
+        {
+            _pos_x[ size ] = _pos_x[ i ];
+            _pos_y[ size ] = _pos_y[ i ];
+            _pos_z[ size ] = _pos_z[ i ];
+            _vel_x[ size ] = _vel_x[ i ];
+            _vel_y[ size ] = _vel_y[ i ];
+            _vel_z[ size ] = _vel_z[ i ];
+
+            _life_time[ size ] = _life_time[ i ];
+            _elevation[ size ] = _elevation[ i ];
+            _shooterId[ size ] = _shooterId[ i ];
+            _expired[ size ] = 0;
+
+            size++;
+        }
+    }
+
+    _pos_x.resize( size );
+    _pos_y.resize( size );
+    _pos_z.resize( size );
+    _vel_x.resize( size );
+    _vel_y.resize( size );
+    _vel_z.resize( size );
+
+    _life_time.resize( size );
+    _elevation.resize( size );
+    _shooterId.resize( size );
+    _expired.resize( size );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Projectiles::testHit( UInt32 index, double timeStep ) const
+{
+    const double p_x = _pos_x[ index ];
+    const double p_y = _pos_y[ index ];
+    const double p_z = _pos_z[ index ];
+
+    const double v_x = _vel_x[ index ] * timeStep;
+    const double v_y = _vel_y[ index ] * timeStep;
+    const double v_z = _vel_z[ index ] * timeStep;
+
+    const double len = sqrt( v_x*v_x + v_y*v_y + v_z*v_z );
+    const double inv = 1.0 / len;
+
+    const double n_x = v_x * inv;
+    const double n_y = v_y * inv;
+    const double n_z = v_z * inv;
+
+    const UInt32 shooterId = _shooterId[ index ];
+    const UInt32 size = _cand_id.size();
+
+    // candidates are ordered the same way as top level units list,
+    // so the first one intersected is the same as in exhaustive scan
+    for ( UInt32 i = 0; i < size; i++ )
+    {
+        const double d_x = _cand_x[ i ] - p_x;
+        const double d_y = _cand_y[ i ] - p_y;
+        const double d_z = _cand_z[ i ] - p_z;
+
+        const double proj = d_x*n_x + d_y*n_y + d_z*n_z;
+        const double dist2 = d_x*d_x + d_y*d_y + d_z*d_z - proj*proj;
+
+        if ( proj >= 0.0 && proj <= len && dist2 < _cand_r2[ i ] && shooterId != _cand_id[ i ] )
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Projectiles::updateGeometry()
+{
+    const double range2 = _range * _range;
+    const double half = 0.5 * _length / _vel_m;
+
+    const Vec3 pos_cam( Data::view()->camera.pos_x,
+                        Data::view()->camera.pos_y,
+                        Data::view()->camera.pos_z );
+
+    _vertices->clear();
+
+    for ( UInt32 i = 0; i < _shooterId.size(); i++ )
+    {
+        Vec3 pos( _pos_x[ i ], _pos_y[ i ], _pos_z[ i ] );
+
+        if ( ( pos - pos_cam ).length2() < range2 )
+        {
+            // velocity is scaled to the half of tracer length
+            Vec3 vel( _vel_x[ i ] * half, _vel_y[ i ] * half, _vel_z[ i ] * half );
+
+            _vertices->push_back( pos + vel );
+            _vertices->push_back( pos - vel );
+        }
+    }
+
+    // colors are the same for every round
+    while ( _colors->size() < _vertices->size() )
+    {
+        _colors->push_back( osg::Vec4( 1.0f, 0.9f, 0.5f, 1.0f ) );
+        _colors->push_back( osg::Vec4( 1.0f, 0.9f, 0.5f, 0.1f ) );
+    }
+
+    _drawArrays->setCount( _vertices->size() );
+
+    _vertices->dirty();
+    _colors->dirty();
+
+    _geometry->dirtyBound();
+}
@@ -0,0 +1,153 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_PROJECTILES_H
+#define SIM_PROJECTILES_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+
+#include <sim/sim_Types.h>
+
+#include <sim/entities/sim_UnitsGrid.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Tracer rounds class.
+ *
+ * Tracer rounds are not entities. Their state is stored in structure of
+ * arrays, each round being an index to all arrays. Rounds are integrated,
+ * tested for hits and drawn in batches. All visible rounds are drawn as a
+ * single dynamic lines geometry.
+ *
+ * Hit test is the same as for munitions. Round pathway within next step is
+ * tested for intersection with units bounding spheres. Rounds are binned by
+ * units grid cell once per step, so hit test candidates are gathered once per
+ * occupied cell and copied into arrays, then all rounds of the cell are tested
+ * against them in a single loop.
+ *
+ * @see Entities
+ * @see Munition
+ */
+class Projectiles
+{
+public:
+
+    static const UInt16 _dp;        ///< damage points
+    static const float _life_span;  ///< [s] life span
+    static const float _vel_m;      ///< [m/s] muzzle velocity
+    static const float _range;      ///< [m] visibility range
+    static const float _length;     ///< [m] tracer length
+
+    /** Constructor. */
+    Projectiles();
+
+    /** Destructor. */
+    virtual ~Projectiles();
+
+    /** Removes all rounds. */
+    void clear();
+
+    /**
+     * @brief Fires tracer round.
+     * @param shooterId shooter ID
+     * @param pos [m] round initial position expressed in ENU
+     * @param att round attitude
+     */
+    void fire( UInt32 shooterId, const Vec3 &pos, const Quat &att );
+
+    /** Loads rounds geometry state. */
+    void load();
+
+    /**
+     * @brief Updates rounds.
+     * @param timeStep [s] simulation time step
+     */
+    void update( double timeStep );
+
+    /**
+     * @brief Updates rounds geometry, must be called on the view side.
+     * Only rounds within visibility range from the view camera are drawn.
+     */
+    void updateGeometry();
+
+    /** Returns number of rounds in flight. */
+    inline UInt32 getCount() const { return _shooterId.size(); }
+
+    /** Returns rounds node. */
+    inline osg::Node* getNode() { return _geode.get(); }
+
+private:
+
+    osg::ref_ptr<osg::Geode> _geode;            ///< rounds geode
+    osg::ref_ptr<osg::Geometry> _geometry;      ///< rounds geometry
+    osg::ref_ptr<osg::Vec3Array> _vertices;     ///< rounds vertices
+    osg::ref_ptr<osg::Vec4Array> _colors;       ///< rounds colors
+    osg::ref_ptr<osg::DrawArrays> _drawArrays;  ///< rounds primitive set
+
+    std::vector< double > _pos_x;       ///< [m] x-coordinate expressed in ENU
+    std::vector< double > _pos_y;       ///< [m] y-coordinate expressed in ENU
+    std::vector< double > _pos_z;       ///< [m] z-coordinate expressed in ENU
+    std::vector< double > _vel_x;       ///< [m/s] x-velocity expressed in ENU
+    std::vector< double > _vel_y;       ///< [m/s] y-velocity expressed in ENU
+    std::vector< double > _vel_z;       ///< [m/s] z-velocity expressed in ENU
+    std::vector< float >  _life_time;   ///< [s] life time
+    std::vector< float >  _elevation;   ///< [m] terrain elevation
+    std::vector< UInt32 > _shooterId;   ///< shooter ID
+    std::vector< UInt8 >  _expired;     ///< specifies if round has expired
+
+    /** Round index paired with its units grid cell key. */
+    typedef std::pair< UnitsGrid::Key, UInt32 > Binned;
+
+    std::vector< Binned > _binned;      ///< rounds indices sorted by cell key
+
+    UnitsGrid::Units _candidates;       ///< hit test candidates buffer
+    std::vector< double > _cand_x;      ///< [m] candidates x-coordinates expressed in ENU
+    std::vector< double > _cand_y;      ///< [m] candidates y-coordinates expressed in ENU
+    std::vector< double > _cand_z;      ///< [m] candidates z-coordinates expressed in ENU
+    std::vector< float >  _cand_r2;     ///< [m^2] candidates squared radii
+    std::vector< UInt32 > _cand_id;     ///< candidates IDs
+
+    UInt32 _fired;                      ///< number of rounds fired since last update
+
+    /** Copies active candidates state into arrays. */
+    void gatherCandidates();
+
+    /** Removes expired rounds. */
+    void removeExpired();
+
+    /**
+     * @brief Tests round for hit.
+     * @param index round index
+     * @param timeStep [s] simulation time step
+     * @return hit candidate index or -1 if none
+     */
+    int testHit( UInt32 index, double timeStep ) const;
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_PROJECTILES_H
@@ -0,0 +1,237 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/entities/sim_Targets.h>
+
+#include <algorithm>
+#include <math.h>
+
+#include <sim/entities/sim_Unit.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Targets::Targets()
+{
+    clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Targets::~Targets() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Targets::clear()
+{
+    for ( UInt8 c = 0; c < 4; c++ )
+    {
+        for ( UInt8 a = 0; a < 4; a++ )
+        {
+            _lists[ c ][ a ].items.clear();
+            _lists[ c ][ a ].margin = 0.0;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Targets::rebuild( Category category, Affiliation affiliation,
+                       const Units *units, double timeStep )
+{
+    List *list = &_lists[ category ][ affiliation ];
+
+    list->items.clear();
+    list->margin = 0.0;
+
+    for ( UInt32 i = 0; i < units->size(); i++ )
+    {
+        Unit *unit = units->at( i );
+
+        if ( unit->getState() != Inactive )
+        {
+            // velocity is doubled to account for acceleration
+            double margin = 2.0 * unit->getVel().length() * timeStep;
+
+            if ( margin > list->margin ) list->margin = margin;
+
+            Item item;
+
+            item.x     = unit->getPos().x();
+            item.index = i;
+            item.unit  = unit;
+
+            list->items.push_back( item );
+        }
+    }
+
+    std::sort( list->items.begin(), list->items.end() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Targets::remove( Entity *entity )
+{
+    for ( UInt8 c = 0; c < 4; c++ )
+    {
+        for ( UInt8 a = 0; a < 4; a++ )
+        {
+            Items *items = &_lists[ c ][ a ].items;
+
+            for ( Items::iterator it = items->begin(); it != items->end(); ++it )
+            {
+                if ( it->unit == entity )
+                {
+                    items->erase( it );
+                    break;
+                }
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Unit* Targets::findForward( Category category, Affiliation affiliation,
+                            const Vec3 &pos, const Quat &att,
+                            float range, float max_a, UInt32 excludedId ) const
+{
+    const List *list = getList( category, affiliation );
+
+    if ( !list ) return 0;
+
+    Unit  *result = 0;
+    UInt32 result_index = 0;
+
+    // angle from front is less than max_a if its cosine is greater
+    const double cos_max = cos( max_a );
+    const double limit2 = range * range;
+
+    double cos_old = -2.0;
+
+    const Vec3 front = att * Vec3( -1.0, 0.0, 0.0 );
+    const double x_max = pos.x() + range + list->margin;
+
+    Items::const_iterator it = getFirst( list, pos.x() - range - list->margin );
+
+    while ( it != list->items.end() && it->x <= x_max )
+    {
+        Unit *unit = it->unit;
+
+        if ( unit->isActive() && unit->getId() != excludedId )
+        {
+            Vec3 v = unit->getPos() - pos;
+
+            double d2 = v.length2();
+
+            if ( d2 < limit2 && d2 > 0.0 )
+            {
+                double cos_new = ( v * front ) / sqrt( d2 );
+
+                if ( cos_new > cos_max )
+                {
+                    if ( cos_new > cos_old || ( cos_new == cos_old && it->index < result_index ) )
+                    {
+                        result = unit;
+                        result_index = it->index;
+                        cos_old = cos_new;
+                    }
+                }
+            }
+        }
+
+        ++it;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Unit* Targets::findNearest( Category category, Affiliation affiliation,
+                            const Vec3 &pos, const Quat &att,
+                            float range, float max_a, UInt32 excludedId ) const
+{
+    const List *list = getList( category, affiliation );
+
+    if ( !list ) return 0;
+
+    Unit  *result = 0;
+    UInt32 result_index = 0;
+
+    // angle from front is less than max_a if its cosine is greater
+    const double cos_max = cos( max_a );
+    const double limit2 = range * range;
+
+    double d2_old = limit2;
+
+    const Vec3 front = att * Vec3( -1.0, 0.0, 0.0 );
+    const double x_max = pos.x() + range + list->margin;
+
+    Items::const_iterator it = getFirst( list, pos.x() - range - list->margin );
+
+    while ( it != list->items.end() && it->x <= x_max )
+    {
+        Unit *unit = it->unit;
+
+        if ( unit->isActive() && unit->getId() != excludedId )
+        {
+            Vec3 v = unit->getPos() - pos;
+
+            double d2 = v.length2();
+
+            if ( d2 < limit2 && d2 > 0.0 )
+            {
+                if ( d2 < d2_old || ( d2 == d2_old && it->index < result_index ) )
+                {
+                    if ( ( v * front ) > cos_max * sqrt( d2 ) )
+                    {
+                        result = unit;
+                        result_index = it->index;
+                        d2_old = d2;
+                    }
+                }
+            }
+        }
+
+        ++it;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Targets::List* Targets::getList( Category category, Affiliation affiliation ) const
+{
+    if ( category < 4 && affiliation < 4 )
+    {
+        return &_lists[ category ][ affiliation ];
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Targets::Items::const_iterator Targets::getFirst( const List *list, double x_min )
+{
+    return std::lower_bound( list->items.begin(), list->items.end(), x_min, Item::lessX );
+}
@@ -0,0 +1,156 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_TARGETS_H
+#define SIM_TARGETS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <sim/sim_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+class Entity;
+class Unit;
+
+/**
+ * @brief Targets acquisition service class.
+ *
+ * Candidate lists of top level units are built once per simulation step
+ * for every units category and affiliation. Lists are sorted by x-coordinate,
+ * so queries visit only candidates which may be within the query range.
+ * Search margin is enlarged by the distance units may travel within the step,
+ * as queries are also made after units are updated. Angles from the query
+ * attitude front are compared using cosines.
+ *
+ * Query results are the same as exhaustive scan of registries would give.
+ *
+ * @see Entities
+ * @see Target
+ */
+class Targets
+{
+public:
+
+    typedef std::vector< Unit* > Units;
+
+    /** Units categories. */
+    enum Category
+    {
+        All     = 0,    ///< all units
+        Aerial  = 1,    ///< aerial units
+        Surface = 2,    ///< surface units
+        Marine  = 3     ///< marine units
+    };
+
+    /** Constructor. */
+    Targets();
+
+    /** Destructor. */
+    virtual ~Targets();
+
+    /** Removes all candidates. */
+    void clear();
+
+    /**
+     * @brief Rebuilds candidates list.
+     * @param category units category
+     * @param affiliation units affiliation
+     * @param units top level units registry of a given category and affiliation
+     * @param timeStep [s] simulation time step
+     */
+    void rebuild( Category category, Affiliation affiliation,
+                  const Units *units, double timeStep );
+
+    /** Removes entity from candidates lists. */
+    void remove( Entity *entity );
+
+    /**
+     * @brief Returns unit most in front of the given attitude if exists, otherwise returns 0.
+     * @param category units category
+     * @param affiliation units affiliation
+     * @param pos [m] query position
+     * @param att query attitude
+     * @param range [m] maximum distance
+     * @param max_a [rad] maximum angle from the attitude front
+     * @param excludedId ID of unit excluded from search (0 if none)
+     */
+    Unit* findForward( Category category, Affiliation affiliation,
+                       const Vec3 &pos, const Quat &att,
+                       float range, float max_a, UInt32 excludedId ) const;
+
+    /**
+     * @brief Returns unit nearest to the given position if exists, otherwise returns 0.
+     * @param category units category
+     * @param affiliation units affiliation
+     * @param pos [m] query position
+     * @param att query attitude
+     * @param range [m] maximum distance
+     * @param max_a [rad] maximum angle from the attitude front
+     * @param excludedId ID of unit excluded from search (0 if none)
+     */
+    Unit* findNearest( Category category, Affiliation affiliation,
+                       const Vec3 &pos, const Quat &att,
+                       float range, float max_a, UInt32 excludedId ) const;
+
+private:
+
+    /** Candidate struct. */
+    struct Item
+    {
+        double x;       ///< [m] x-coordinate when list was built
+        UInt32 index;   ///< unit index in registry
+        Unit *unit;     ///< unit
+
+        inline bool operator< ( const Item &item ) const
+        {
+            return ( x < item.x ) || ( x == item.x && index < item.index );
+        }
+
+        static inline bool lessX( const Item &item, double x )
+        {
+            return item.x < x;
+        }
+    };
+
+    typedef std::vector< Item > Items;
+
+    /** Candidates list struct. */
+    struct List
+    {
+        Items items;    ///< candidates sorted by x-coordinate
+        double margin;  ///< [m] maximum distance unit may travel within step
+    };
+
+    List _lists[ 4 ][ 4 ];  ///< candidates lists indexed by category and affiliation
+
+    /** Returns candidates list. */
+    const List* getList( Category category, Affiliation affiliation ) const;
+
+    /** Returns iterator to the first candidate which may be within range. */
+    static Items::const_iterator getFirst( const List *list, double x_min );
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_TARGETS_H
@@ -20,8 +20,6 @@
 #include <sim/entities/sim_Explosion.h>
 #include <sim/entities/sim_Entities.h>
 
-#include <sim/sim_Elevation.h>
-
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace sim;
@@ -40,6 +38,13 @@ Torpedo::~Torpedo() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool Torpedo::isElevationRequired() const
+{
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Torpedo::update( double timeStep )
 {
     /////////////////////////////
@@ -87,7 +92,7 @@ void Torpedo::updateElevation()
         Munition::updateElevation();
         ////////////////////////////
 
-        _elevation = Elevation::instance()->getElevation( _pos.x(), _pos.y() );
+        _elevation = getElevationSample();
     }
 }
 
@@ -37,6 +37,9 @@ public:
     /** Destructor. */
     virtual ~Torpedo();
 
+    /** Returns true as torpedo requires terrain elevation. */
+    virtual bool isElevationRequired() const;
+
     /** Updates torpedo. */
     virtual void update( double timeStep );
 
@@ -46,7 +46,8 @@ Unit::Unit( Affiliation affiliation ) :
     _radius  ( 0.0 ),
     _radius2 ( 0.0 ),
 
-    _ownship ( false )
+    _ownship ( false ),
+    _impostor ( false )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -127,12 +128,19 @@ void Unit::destroy()
 ////////////////////////////////////////////////////////////////////////////////
 
 void Unit::hit( UInt16 dp, const Munition *munition )
+{
+    hit( dp, munition->getShooterId(), munition->getAtt() * munition->getVel() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Unit::hit( UInt16 dp, UInt32, const Vec3 &vel )
 {
     damage( dp );
 
     if ( _ownship )
     {
-        Ownship::instance()->reportHit( munition );
+        Ownship::instance()->reportHit( vel );
     }
 }
 
@@ -187,6 +195,29 @@ void Unit::makeOwnship()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Unit::interpolate( double alpha )
+{
+    /////////////////////////////
+    Entity::interpolate( alpha );
+    /////////////////////////////
+
+    if ( _ownship && Data::view()->camera.type == ViewPilot )
+    {
+        _switch->setAllChildrenOff();
+    }
+    else
+    {
+        _switch->setAllChildrenOn();
+
+        if ( _impostor && _model.valid() )
+        {
+            _switch->setChildValue( _model.get(), false );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 int Unit::read( const XmlNode &node )
 {
     if ( node.isValid() )
@@ -250,22 +281,27 @@ void Unit::update( double timeStep )
 
     if ( isActive() )
     {
-        if ( _ownship && Data::get()->camera.type == ViewPilot )
-        {
-            _switch->setAllChildrenOff();
-        }
-        else
-        {
-            _switch->setAllChildrenOn();
-        }
-
-        updateCollisions();
         updateWeapons();
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Unit::updateParallel( double timeStep )
+{
+    // parallel phase precedes Entity::update( double ), which sets it as well
+    _timeStep = timeStep;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Unit::isDetectingCollisions() const
+{
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Unit::setAP( UInt16 ap )
 {
     _ap = ap;
@@ -282,6 +318,21 @@ void Unit::setHP( UInt16 hp )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Unit::setImpostor( bool impostor )
+{
+    if ( _impostor != impostor )
+    {
+        _impostor = impostor;
+
+        if ( isActive() && _model.valid() )
+        {
+            _switch->setChildValue( _model.get(), !_impostor );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Unit::setRadius( float radius )
 {
     _radius = radius;
@@ -350,36 +401,4 @@ void Unit::readGunners( const XmlNode &node )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Unit::updateCollisions()
-{
-    List *entities = Entities::instance()->getEntities();
-    List::iterator it = entities->begin();
-
-    Vec3 r;
-
-    while ( it != entities->end() )
-    {
-        Unit *unit = dynamic_cast< Unit* >(*it);
-
-        if ( unit )
-        {
-            if ( _id != unit->getId() && unit->isActive() )
-            {
-                r = unit->getPos() - _pos;
-
-                if ( r.length2() < _radius2 + unit->getRadius2() )
-                {
-                    unit->collide( this );
-                    collide( unit );
-                    break;
-                }
-            }
-        }
-
-        ++it;
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 void Unit::updateWeapons() {}
@@ -65,7 +65,15 @@ public:
      * @param dp demage points
      * @param munition munition which hit unit
      */
-    virtual void hit( UInt16 dp, const Munition *munition );
+    void hit( UInt16 dp, const Munition *munition );
+
+    /**
+     * Demages unit.
+     * @param dp demage points
+     * @param shooterId ID of the unit which fired munition
+     * @param vel [m/s] munition velocity expressed in ENU
+     */
+    virtual void hit( UInt16 dp, UInt32 shooterId, const Vec3 &vel );
 
     /** Loads unit (models, textures, etc.). */
     virtual void load();
@@ -76,6 +84,13 @@ public:
     /** Makes entity an ownship (controlled by player) and activates it. */
     virtual void makeOwnship();
 
+    /**
+     * Interpolates unit scene node. Unit model is hidden if unit is drawn
+     * as impostor and unit is hidden if it is viewed from the pilot seat.
+     * @param alpha interpolation coefficient (0 - previous state, 1 - current state)
+     */
+    virtual void interpolate( double alpha );
+
     /**
      * Reads unit data.
      * @return SIM_SUCCESS on success or SIM_FAILURE on failure.
@@ -91,6 +106,15 @@ public:
     /** Updates unit. */
     virtual void update( double timeStep );
 
+    /**
+     * Updates unit before entities update. This function is called for all
+     * top level units in parallel, so it should only read other units state
+     * and modify only unit's own data. Side effects should be applied in
+     * update( double ).
+     * @param timeStep [s] simulation time step
+     */
+    virtual void updateParallel( double timeStep );
+
     /** Returns unit affiliation. */
     inline Affiliation getAffiliation() const { return _affiliation; }
 
@@ -100,6 +124,12 @@ public:
     /** Returns unit armor points. */
     inline UInt16 getAP() const { return _ap; }
 
+    /** Returns unit model node. */
+    inline osg::Node* getModel() const { return _model.get(); }
+
+    /** */
+    inline std::string getModelFile() const { return _modelFile; }
+
     /**
      * @brief Returns unit bounding sphere radius.
      * @return [m] bounding sphere radius
@@ -118,12 +148,24 @@ public:
     /** Returns true if unit has not been destroyed. */
     inline bool isAlive() const { return _hp > 0; }
 
+    /**
+     * Returns true if unit detects collisions with other units. Collision
+     * between two units is handled if at least one of them detects it.
+     */
+    virtual bool isDetectingCollisions() const;
+
     /** Sets unit armor points. */
     virtual void setAP( UInt16 ap );
 
     /** Sets unit hit points. */
     virtual void setHP( UInt16 hp );
 
+    /**
+     * Sets if unit is drawn as impostor, in which case its model is hidden.
+     * @param impostor specifies if unit is drawn as impostor
+     */
+    void setImpostor( bool impostor );
+
     /**
      * Sets unit radius.
      * @param radius [m] radius (for the purpose of collision detections)
@@ -144,13 +186,11 @@ protected:
     float _radius2;                     ///< [m^2] entity radius squared
 
     bool _ownship;                      ///< specifies if unit is ownship
+    bool _impostor;                     ///< specifies if unit is drawn as impostor
 
     /** Reads gunners. */
     virtual void readGunners( const XmlNode &node );
 
-    /** Determines if unit collided with another one. */
-    virtual void updateCollisions();
-
     /** Updates weapons. */
     virtual void updateWeapons();
 };
@@ -16,6 +16,9 @@
  ******************************************************************************/
 
 #include <sim/entities/sim_UnitGround.h>
+
+#include <sim/cgi/sim_SceneQueue.h>
+
 #include <sim/entities/sim_WreckageSurface.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,7 +31,10 @@ UnitGround::UnitGround( Affiliation affiliation ) : UnitSurface( affiliation ) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-UnitGround::~UnitGround() {}
+UnitGround::~UnitGround()
+{
+    SceneQueue::removeInstance( _instance.get() );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -50,3 +56,40 @@ void UnitGround::destroy()
     UnitSurface::destroy();
     ///////////////////////
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UnitGround::interpolate( double alpha )
+{
+    //////////////////////////////////
+    UnitSurface::interpolate( alpha );
+    //////////////////////////////////
+
+    if ( _instance.valid() )
+    {
+        Instances::update( _instance.get(), _pat->getPosition(), _pat->getAttitude(), isActive() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UnitGround::load()
+{
+    Instances::remove( _instance.get() );
+    _instance = 0;
+
+    ////////////////////
+    UnitSurface::load();
+    ////////////////////
+
+    // instances are placed in world frame
+    if ( _model.valid() && isTopLevel() )
+    {
+        _instance = Instances::create( _model.get() );
+
+        if ( _instance.valid() )
+        {
+            _switch->removeChild( _model.get() );
+        }
+    }
+}
@@ -19,6 +19,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <sim/cgi/sim_Instances.h>
+
 #include <sim/entities/sim_UnitSurface.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -26,7 +28,12 @@
 namespace sim
 {
 
-/** @brief Ground unit base class. */
+/**
+ * @brief Ground unit base class.
+ *
+ * Models of top level ground units (including buildings) are drawn as
+ * hardware instances shared by all units of the same model.
+ */
 class UnitGround : public UnitSurface
 {
 public:
@@ -39,6 +46,16 @@ public:
 
     /** Destroys unit. */
     virtual void destroy();
+
+    /** Interpolates entity scene node between previous and current state. */
+    virtual void interpolate( double alpha );
+
+    /** Loads unit (models, textures, etc.). */
+    virtual void load();
+
+protected:
+
+    osg::ref_ptr<Instances::Instance> _instance;    ///< instanced model, model is not attached to the switch if valid
 };
 
 } // end of sim namespace
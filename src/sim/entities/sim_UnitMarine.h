@@ -31,13 +31,6 @@ class UnitMarine : public UnitSurface
 {
 public:
 
-#   ifdef SIM_DESKTOP
-    static const char _frag[];      ///<
-    static const char _vert[];      ///<
-
-    static void createReflection( osg::Node *model, osg::Group *parent );
-#   endif
-
     /** Constructor. */
     UnitMarine( Affiliation affiliation = Unknown );
 
@@ -47,6 +40,9 @@ public:
     /** Destroys unit. */
     virtual void destroy();
 
+    /** Interpolates entity scene node between previous and current state. */
+    virtual void interpolate( double alpha );
+
     /** Loads unit (models, textures, etc.). */
     virtual void load();
 
@@ -56,6 +52,8 @@ public:
 protected:
 
     osg::ref_ptr<osg::Group> _smoke;    ///< damaged unit smoke group
+
+    osg::ref_ptr<osg::PositionAttitudeTransform> _reflection;   ///< reflected model
 };
 
 } // end of sim namespace
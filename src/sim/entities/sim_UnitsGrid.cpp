@@ -0,0 +1,170 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/entities/sim_UnitsGrid.h>
+
+#include <algorithm>
+
+#include <sim/entities/sim_Unit.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const float UnitsGrid::_cell_size = 250.0f;
+
+// units velocities follow setpoints with first order inertia, so acceleration
+// is not greater than |setpoint - v| / time_constant, setpoints are limited
+// to max speed (less than 250 m/s) and time constants are not less than 1 s
+const float UnitsGrid::_acc_max = 500.0f;
+
+////////////////////////////////////////////////////////////////////////////////
+
+UnitsGrid::UnitsGrid() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UnitsGrid::~UnitsGrid() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UnitsGrid::clear()
+{
+    _items.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UnitsGrid::rebuild( const Units *units, double timeStep )
+{
+    _items.clear();
+
+    for ( UInt32 i = 0; i < units->size(); i++ )
+    {
+        Unit *unit = units->at( i );
+
+        if ( unit->getState() != Inactive )
+        {
+            // unit may move before munitions are updated within this step,
+            // its speed at the end of the step is not greater than
+            // |v| + a_max * dt, so it travels not further than
+            // ( |v| + a_max * dt ) * dt
+            double vel_max = unit->getVel().length() + _acc_max * timeStep;
+            double margin = unit->getRadius() + vel_max * timeStep;
+
+            Vec3 pos = unit->getPos();
+
+            int ix_0 = getCell( pos.x() - margin );
+            int ix_1 = getCell( pos.x() + margin );
+            int iy_0 = getCell( pos.y() - margin );
+            int iy_1 = getCell( pos.y() + margin );
+
+            Item item;
+
+            item.index = i;
+            item.unit  = unit;
+
+            for ( int ix = ix_0; ix <= ix_1; ix++ )
+            {
+                for ( int iy = iy_0; iy <= iy_1; iy++ )
+                {
+                    item.key = getKey( ix, iy );
+                    _items.push_back( item );
+                }
+            }
+        }
+    }
+
+    std::sort( _items.begin(), _items.end() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UnitsGrid::getUnits( const Vec3 &p0, const Vec3 &p1, Units *units ) const
+{
+    getUnits( std::min( p0.x(), p1.x() ), std::max( p0.x(), p1.x() ),
+              std::min( p0.y(), p1.y() ), std::max( p0.y(), p1.y() ),
+              units );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UnitsGrid::getUnits( const Vec3 &pos, float range, Units *units ) const
+{
+    getUnits( pos.x() - range, pos.x() + range,
+              pos.y() - range, pos.y() + range,
+              units );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UnitsGrid::getUnits( int ix, int iy, double margin, Units *units ) const
+{
+    getUnits( (double)ix * _cell_size - margin, (double)( ix + 1 ) * _cell_size + margin,
+              (double)iy * _cell_size - margin, (double)( iy + 1 ) * _cell_size + margin,
+              units );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UnitsGrid::getUnits( double x_min, double x_max, double y_min, double y_max,
+                          Units *units ) const
+{
+    units->clear();
+    _found.clear();
+
+    int ix_0 = getCell( x_min );
+    int ix_1 = getCell( x_max );
+    int iy_0 = getCell( y_min );
+    int iy_1 = getCell( y_max );
+
+    Item item;
+
+    item.index = 0;
+    item.unit  = 0;
+
+    for ( int ix = ix_0; ix <= ix_1; ix++ )
+    {
+        for ( int iy = iy_0; iy <= iy_1; iy++ )
+        {
+            item.key = getKey( ix, iy );
+
+            Items::const_iterator it = std::lower_bound( _items.begin(), _items.end(), item );
+
+            while ( it != _items.end() && it->key == item.key )
+            {
+                _found.push_back( Indexed( it->index, it->unit ) );
+                ++it;
+            }
+        }
+    }
+
+    // units registered in more than one cell are reported once,
+    // in top level entities list order
+    if ( ix_0 != ix_1 || iy_0 != iy_1 )
+    {
+        std::sort( _found.begin(), _found.end() );
+        _found.erase( std::unique( _found.begin(), _found.end() ), _found.end() );
+    }
+
+    for ( std::vector< Indexed >::const_iterator it = _found.begin(); it != _found.end(); ++it )
+    {
+        units->push_back( it->second );
+    }
+}
@@ -0,0 +1,154 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_UNITSGRID_H
+#define SIM_UNITSGRID_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <vector>
+
+#include <sim/sim_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+class Unit;
+
+/**
+ * @brief Units uniform grid class.
+ *
+ * Broadphase structure used to narrow the set of units which have to be
+ * tested against munitions pathways and blast ranges. Grid covers horizontal
+ * plane and is rebuilt once per simulation step from top level units.
+ *
+ * Every unit is registered in all cells overlapped by its bounding sphere
+ * enlarged by the distance unit may travel within the step, so queries
+ * return superset of units that exhaustive scan would find, regardless
+ * of entities update order.
+ *
+ * Query results are ordered the same way as top level units list.
+ *
+ * @see Entities
+ */
+class UnitsGrid
+{
+public:
+
+    typedef std::vector< Unit* > Units;
+
+    typedef unsigned long long Key;
+
+    static const float _cell_size;  ///< [m] grid cell size
+    static const float _acc_max;    ///< [m/s^2] max unit acceleration magnitude
+
+    /** Returns cell index of the given coordinate. */
+    static inline int getCell( double coord )
+    {
+        return (int)floor( coord / _cell_size );
+    }
+
+    /** Returns key of the given cell. */
+    static inline Key getKey( int ix, int iy )
+    {
+        return ( (Key)( (UInt32)ix ) << 32 ) | (Key)( (UInt32)iy );
+    }
+
+    /** Constructor. */
+    UnitsGrid();
+
+    /** Destructor. */
+    virtual ~UnitsGrid();
+
+    /** Removes all units from grid. */
+    void clear();
+
+    /**
+     * @brief Rebuilds grid.
+     * @param units top level units list
+     * @param timeStep [s] simulation time step
+     */
+    void rebuild( const Units *units, double timeStep );
+
+    /**
+     * @brief Returns units which bounding spheres may intersect given segment.
+     * @param p0 [m] segment start point
+     * @param p1 [m] segment end point
+     * @param units output units list
+     */
+    void getUnits( const Vec3 &p0, const Vec3 &p1, Units *units ) const;
+
+    /**
+     * @brief Returns units which bounding spheres may be within given range.
+     * @param pos [m] position
+     * @param range [m] range
+     * @param units output units list
+     */
+    void getUnits( const Vec3 &pos, float range, Units *units ) const;
+
+    /**
+     * @brief Returns units which bounding spheres may intersect given cell.
+     * @param ix cell x-index
+     * @param iy cell y-index
+     * @param margin [m] cell margin
+     * @param units output units list
+     */
+    void getUnits( int ix, int iy, double margin, Units *units ) const;
+
+private:
+
+    /** Grid item struct. */
+    struct Item
+    {
+        Key key;        ///< cell key
+        UInt32 index;   ///< unit index in top level units list
+        Unit *unit;     ///< unit
+
+        inline bool operator< ( const Item &item ) const
+        {
+            return ( key < item.key ) || ( key == item.key && index < item.index );
+        }
+    };
+
+    /** Unit indexed by its position in top level units list. */
+    typedef std::pair< UInt32, Unit* > Indexed;
+
+    typedef std::vector< Item > Items;
+
+    Items _items;                   ///< grid items sorted by cell key
+
+    mutable std::vector< Indexed > _found;  ///< query buffer
+
+    /**
+     * @brief Returns units registered in cells overlapped by given rectangle.
+     * @param x_min [m] rectangle minimum x-coordinate
+     * @param x_max [m] rectangle maximum x-coordinate
+     * @param y_min [m] rectangle minimum y-coordinate
+     * @param y_max [m] rectangle maximum y-coordinate
+     * @param units output units list
+     */
+    void getUnits( double x_min, double x_max, double y_min, double y_max,
+                   Units *units ) const;
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_UNITSGRID_H
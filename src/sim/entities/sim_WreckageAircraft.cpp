@@ -17,9 +17,9 @@
 
 #include <sim/entities/sim_WreckageAircraft.h>
 
-#include <sim/sim_Elevation.h>
 #include <sim/sim_Log.h>
 #include <sim/cgi/sim_Models.h>
+#include <sim/cgi/sim_SceneQueue.h>
 #include <sim/cgi/sim_Textures.h>
 #include <sim/entities/sim_Explosion.h>
 #include <sim/utils/sim_Inertia.h>
@@ -30,14 +30,60 @@ using namespace sim;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+WreckageAircraft::Pool WreckageAircraft::_pool;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WreckageAircraft::prepare( const std::string &modelFile, const std::string &livery )
+{
+    // already prepared for another unit of the same model and livery
+    if ( _pool.find( Key( modelFile, livery ) ) != _pool.end() )
+    {
+        return;
+    }
+
+    // shared aircraft model is used, livery is set by the parent group
+    osg::ref_ptr<osg::Group> group = new osg::Group();
+
+    std::string aircraftFile = getPath( modelFile );
+
+    osg::ref_ptr<osg::Node> model = Models::get( aircraftFile );
+
+    if ( model.valid() )
+    {
+        group->addChild( model.get() );
+
+        osg::ref_ptr<osg::Texture2D> texture = Textures::get( getPath( livery ), 8.0f );
+
+        if ( texture.valid() )
+        {
+            osg::ref_ptr<osg::StateSet> stateSet = group->getOrCreateStateSet();
+            stateSet->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
+        }
+    }
+    else
+    {
+        Log::e() << "Cannot open aircraft file: " << aircraftFile << std::endl;
+    }
+
+    _pool[ Key( modelFile, livery ) ] = group.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WreckageAircraft::reset()
+{
+    _pool.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 WreckageAircraft::WreckageAircraft( const std::string &modelFile, const std::string &livery,
-                                    osgParticle::SmokeEffect *smokeTrail, bool ownship ) :
+                                    bool ownship ) :
     Wreckage( 0, 10.0f ),
 
     _ownship ( ownship ),
 
-    _smokeTrail ( smokeTrail ),
-
     _livery ( livery ),
     _modelFile ( modelFile ),
 
@@ -47,14 +93,10 @@ WreckageAircraft::WreckageAircraft( const std::string &modelFile, const std::str
     _elevation    ( 0.0f )
 {
     loadModel();
-    loadLivery();
 
-    if ( !_smokeTrail.valid() )
-    {
-        _smokeTrail = Effects::createSmokeTrail();
-    }
-
-    _root->addChild( _smokeTrail.get() );
+    // trail emitter is moved by wreckage transform
+    _smokeTrail = Effects::createSmokeTrail();
+    _pat->addChild( _smokeTrail.get() );
 
     _switchFire = new osg::Switch();
     _pat->addChild( _switchFire.get() );
@@ -82,6 +124,13 @@ WreckageAircraft::~WreckageAircraft() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool WreckageAircraft::isElevationRequired() const
+{
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void WreckageAircraft::init( const Vec3 &pos,
                              const Quat &att,
                              const Vec3 &vel,
@@ -109,7 +158,6 @@ void WreckageAircraft::load()
     }
 
     loadModel();
-    loadLivery();
     createFire();
 }
 
@@ -127,16 +175,18 @@ void WreckageAircraft::update( double timeStep )
 
         if ( altitude_agl <= 0.0f && _altitude_agl > 0.0f )
         {
-            _switch->setValue( 0, false );
-            _switchFire->setAllChildrenOff();
+            SceneQueue::setChildValue( _switch.get(), _model.get(), false );
+            SceneQueue::setAllChildren( _switchFire.get(), false );
 
             Explosion *explosion = new Explosion( 20.0f );
             explosion->setPos( _pos );
             explosion->setAtt( _att );
 
+            // detached emitter stops emitting, particles already emitted remain
             if ( _smokeTrail.valid() )
             {
-                _smokeTrail->setEmitterDuration( 0.0 );
+                SceneQueue::removeChild( _pat.get(), _smokeTrail.get() );
+                _smokeTrail = 0;
             }
         }
 
@@ -146,11 +196,6 @@ void WreckageAircraft::update( double timeStep )
         {
             resetLifeTime();
         }
-
-        if ( _smokeTrail.valid() )
-        {
-            _smokeTrail->setPosition( _pos );
-        }
     }
 }
 
@@ -162,23 +207,14 @@ void WreckageAircraft::setState( State state )
     Entity::setState( state );
     //////////////////////////
 
-    _state = state;
-
-    if ( _state == Active )
-    {
-        _switchFire->setAllChildrenOn();
-    }
-    else
-    {
-        _switchFire->setAllChildrenOff();
-    }
+    SceneQueue::setAllChildren( _switchFire.get(), _state == Active );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void WreckageAircraft::updateElevation()
 {
-    _elevation = Elevation::instance()->getElevation( _pos.x(), _pos.y() );
+    _elevation = getElevationSample();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -241,45 +277,27 @@ void WreckageAircraft::createFire()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-osg::Node* WreckageAircraft::getModel( const std::string &modelFile )
-{
-    return Models::readNodeFile( getPath( modelFile ) );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void WreckageAircraft::loadLivery()
+osg::Node* WreckageAircraft::getModel( const std::string &modelFile, const std::string &livery )
 {
-    if ( _model.valid() )
-    {
-        osg::ref_ptr<osg::Texture2D> texture = Textures::get( getPath( _livery ), 8.0f );
+    Pool::iterator it = _pool.find( Key( modelFile, livery ) );
 
-        if ( texture.valid() )
-        {
-            osg::ref_ptr<osg::StateSet> stateSet = _model->getOrCreateStateSet();
-            stateSet->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
-        }
-    }
-    else
+    if ( it == _pool.end() )
     {
-        Log::e() << "Model node does not exist." << std::endl;
+        prepare( modelFile, livery );
+        it = _pool.find( Key( modelFile, livery ) );
     }
+
+    return it->second.get();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void WreckageAircraft::loadModel()
 {
-    std::string aircraftFile = getPath( _modelFile );
-
-    _model = Models::readNodeFile( aircraftFile );
+    _model = getModel( _modelFile, _livery );
 
     if ( _model.valid() )
     {
         _switch->addChild( _model.get() );
     }
-    else
-    {
-        Log::e() << "Cannot open aircraft file: " << aircraftFile << std::endl;
-    }
 }
@@ -19,6 +19,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
+
 #include <sim/cgi/sim_Effects.h>
 #include <sim/entities/sim_Wreckage.h>
 
@@ -32,13 +34,28 @@ class WreckageAircraft : public Wreckage
 {
 public:
 
+    /**
+     * Pre-builds wreckage model for given aircraft model and livery, so no
+     * reading is done when aircraft is destroyed. Does nothing if it is
+     * already prepared.
+     * @param modelFile aircraft model file path
+     * @param livery livery path
+     */
+    static void prepare( const std::string &modelFile, const std::string &livery );
+
+    /** Resets pre-built wreckage models. */
+    static void reset();
+
     /** Constructor. */
     WreckageAircraft( const std::string &modelFile, const std::string &livery,
-                      osgParticle::SmokeEffect *smokeTrail, bool ownship = false );
+                      bool ownship = false );
 
     /** Destructor. */
     virtual ~WreckageAircraft();
 
+    /** Returns true as wreckage requires terrain elevation. */
+    virtual bool isElevationRequired() const;
+
     /** */
     virtual void init( const Vec3 &pos,
                        const Quat &att,
@@ -56,11 +73,16 @@ public:
 
 private:
 
+    typedef std::pair< std::string, std::string > Key;
+    typedef std::map< Key, osg::ref_ptr<osg::Node> > Pool;
+
+    static Pool _pool;          ///< wreckage models shared by wreckages of the same aircraft model and livery
+
     const bool _ownship;
 
     osg::ref_ptr<osg::Node> _model;
 
-    osg::ref_ptr<Effects::Smoke> _smokeTrail;   ///< smoke trail
+    osg::ref_ptr<osg::Group> _smokeTrail;       ///< smoke trail
 
     osg::ref_ptr<osg::Switch> _switchFire;      ///<
 
@@ -81,11 +103,8 @@ private:
     /** */
     void createFire();
 
-    /** */
-    osg::Node* getModel( const std::string &modelFile );
-
-    /** */
-    void loadLivery();
+    /** Returns pre-built wreckage model, builds it if it does not exist. */
+    static osg::Node* getModel( const std::string &modelFile, const std::string &livery );
 
     /** */
     void loadModel();
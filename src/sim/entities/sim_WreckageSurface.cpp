@@ -17,11 +17,9 @@
 
 #include <sim/entities/sim_WreckageSurface.h>
 
-#ifdef SIM_TEST
-#   include <sim/entities/sim_UnitMarine.h>
-#endif
-
 #include <sim/cgi/sim_Effects.h>
+#include <sim/cgi/sim_Reflection.h>
+#include <sim/cgi/sim_SceneQueue.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -42,10 +40,33 @@ WreckageSurface::WreckageSurface( osg::Node *model , osg::Group *smoke ) :
     _switch->addChild( smokeTmp.get() );
 
 #   ifdef SIM_TEST
-    UnitMarine::createReflection( model, _switch.get() );
+    _reflection = new osg::PositionAttitudeTransform();
+    _reflection->addChild( model );
+
+    SceneQueue::addReflection( _reflection.get() );
+
+    _switch->addChild( Reflection::createWater( model ) );
 #   endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-WreckageSurface::~WreckageSurface() {}
+WreckageSurface::~WreckageSurface()
+{
+    SceneQueue::removeReflection( _reflection.get() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WreckageSurface::interpolate( double alpha )
+{
+    ///////////////////////////////
+    Wreckage::interpolate( alpha );
+    ///////////////////////////////
+
+    if ( _reflection.valid() )
+    {
+        _reflection->setPosition( _pat->getPosition() );
+        _reflection->setAttitude( _pat->getAttitude() );
+    }
+}
@@ -36,6 +36,13 @@ public:
 
     /** Destructor. */
     virtual ~WreckageSurface();
+
+    /** Interpolates entity scene node between previous and current state. */
+    virtual void interpolate( double alpha );
+
+private:
+
+    osg::ref_ptr<osg::PositionAttitudeTransform> _reflection;   ///< reflected model
 };
 
 } // end of sim namespace
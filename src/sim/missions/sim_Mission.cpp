@@ -24,8 +24,11 @@
 #include <sim/sim_Creator.h>
 
 #include <sim/cgi/sim_FogScene.h>
+#include <sim/cgi/sim_Models.h>
+#include <sim/cgi/sim_PagedTerrain.h>
 #include <sim/cgi/sim_Scenery.h>
 #include <sim/cgi/sim_SkyDome.h>
+#include <sim/cgi/sim_Textures.h>
 
 #include <sim/missions/sim_ObjectiveWaypoint.h>
 
@@ -120,6 +123,9 @@ void Mission::init( const std::string &missionFile )
     {
         if ( SIM_SUCCESS == readMission( doc.getRootNode() ) )
         {
+            // tutorial stage init reads units registries
+            Entities::instance()->categorize();
+
             if ( _stages.size() > 0 )
             {
                 initStageTutorial();
@@ -242,21 +248,19 @@ void Mission::initStageTutorial()
                 }
 
                 // entities
-                Entities::List::iterator it = Entities::instance()->getEntities()->begin();
+                const Entities::Units *units = Entities::instance()->getUnits();
+                Entities::Units::const_iterator it = units->begin();
 
-                while ( it != Entities::instance()->getEntities()->end() )
+                while ( it != units->end() )
                 {
-                    Unit *unit = dynamic_cast< Unit* >(*it);
+                    Unit *unit = (*it);
 
-                    if ( unit )
+                    if ( Standby == unit->getState() && unit->isTopLevel() )
                     {
-                        if ( Standby == unit->getState() && unit->isTopLevel() )
-                        {
-                            float hdg = -M_PI_2 - unit->getAngles().psi() - psi;
+                        float hdg = -M_PI_2 - unit->getAngles().psi() - psi;
 
-                            unit->setHeading( hdg );
-                            unit->setPos( pos + dir * unit->getAbsPos() );
-                        }
+                        unit->setHeading( hdg );
+                        unit->setPos( pos + dir * unit->getAbsPos() );
                     }
 
                     ++it;
@@ -400,6 +404,28 @@ int Mission::readScenery( const XmlNode &node )
                 Scenery::_genericFile = genericFile;
                 SkyDome::_skyDomeFile = skyDomeFile;
 
+                // paged terrain
+                std::string levels = terrainNode.getAttribute( "levels" );
+                std::string tiles  = terrainNode.getAttribute( "tiles" );
+
+                Scenery::_terrainLevels = ( levels.length() > 0 ) ? String::toInt( levels ) : 0;
+                Scenery::_terrainTiles  = ( tiles.length()  > 0 ) ? String::toInt( tiles  ) : 1;
+
+                if ( Scenery::_terrainLevels < 0 || Scenery::_terrainTiles < 1 || Scenery::_terrainTiles % 2 == 0 )
+                {
+                    Log::e() << "Invalid paged terrain levels or tiles number: " << terrainNode.getFileAndLine() << std::endl;
+                    return SIM_FAILURE;
+                }
+
+                if ( Scenery::_terrainLevels > 0 )
+                {
+                    Models::request( PagedTerrain::getTileFile( getPath( terrainFile ), 0, 0, 0 ), true );
+                }
+                else
+                {
+                    Models::request( getPath( terrainFile ), true );
+                }
+
                 // default values
                 FogScene::_visibility = 0.9f * SIM_SKYDOME_RAD;
                 SkyDome::_sunCoef = 1.0f;
@@ -457,6 +483,7 @@ int Mission::readScenery( const XmlNode &node )
                         if ( SIM_SUCCESS == XmlUtils::read( objectNode, objectFile ) )
                         {
                             Scenery::_objectFiles.push_back( objectFile );
+                            Models::request( getPath( objectFile ) );
                         }
                         else
                         {
@@ -619,6 +646,8 @@ int Mission::readUnit( const XmlNode &node, Affiliation affiliation, bool ownshi
         {
             unit->setState( Standby );
 
+            Models::request( getPath( unit->getModelFile() ) );
+
             std::string unitName = node.getAttribute( "name" );
             std::string unitHP   = node.getAttribute( "hp" );
 
@@ -696,6 +725,7 @@ int Mission::readUnit( const XmlNode &node, Affiliation affiliation, bool ownshi
                     if ( SIM_SUCCESS == XmlUtils::read( liveryNode, livery ) )
                     {
                         aircraft->setLivery( livery );
+                        Textures::request( getPath( livery ), 8.0f );
                     }
                 }
             }
@@ -17,9 +17,9 @@
 
 #include <sim/sfx/sim_SFX.h>
 
-#ifdef SIM_SFX_OPENSLES
+#if defined( SIM_SFX_OPENSLES )
 #   include <sim/sfx/sim_EngineOpenSLES.h>
-#else
+#elif !defined( SIM_SFX_NONE )
 #   include <sim/sfx/sim_EngineOpenAL.h>
 #endif
 
@@ -55,9 +55,9 @@ void SFX::init()
 {
     if ( !_inited )
     {
-#       ifdef SIM_SFX_OPENSLES
+#       if defined( SIM_SFX_OPENSLES )
         EngineOpenSLES::instance()->init();
-#       else
+#       elif !defined( SIM_SFX_NONE )
         EngineOpenAL::instance()->init();
 #       endif
 
@@ -72,14 +72,14 @@ void SFX::pause()
 {
     _paused = true;
 
-#   ifdef SIM_SFX_OPENSLES
+#   if defined( SIM_SFX_OPENSLES )
     EngineOpenSLES::instance()->setPlayerCrash     ( false );
     EngineOpenSLES::instance()->setPlayerEngine    ( false );
     EngineOpenSLES::instance()->setPlayerGunfire   ( false );
     EngineOpenSLES::instance()->setPlayerHeartbeat ( false );
     EngineOpenSLES::instance()->setPlayerHit       ( false );
     EngineOpenSLES::instance()->setPlayerWaypoint  ( false );
-#   else
+#   elif !defined( SIM_SFX_NONE )
     EngineOpenAL::instance()->setCrash     ( false );
     EngineOpenAL::instance()->setEngine    ( false );
     EngineOpenAL::instance()->setGunfire   ( false );
@@ -102,9 +102,9 @@ void SFX::stop()
 {
     if ( _inited )
     {
-#       ifdef SIM_SFX_OPENSLES
+#       if defined( SIM_SFX_OPENSLES )
         EngineOpenSLES::instance()->stop();
-#       else
+#       elif !defined( SIM_SFX_NONE )
         EngineOpenAL::instance()->stop();
 #       endif
 
@@ -116,31 +116,31 @@ void SFX::stop()
 
 void SFX::update()
 {
-    _rpm->update( 0.016f, 0.7f + 0.3f * Data::get()->controls.throttle );
+    _rpm->update( 0.016f, 0.7f + 0.3f * Data::view()->controls.throttle );
 
-#   ifdef SIM_SFX_OPENSLES
+#   if defined( SIM_SFX_OPENSLES )
     if ( !_paused )
     {
-        if ( !Data::get()->ownship.destroyed )
+        if ( !Data::view()->ownship.destroyed )
         {
             // engine
             EngineOpenSLES::instance()->setPlayerEngine( true );
             EngineOpenSLES::instance()->setPlayerEngineRPM( _rpm->getValue() );
 
             // gunfire
-            EngineOpenSLES::instance()->setPlayerGunfire( Data::get()->ownship.gunfire );
+            EngineOpenSLES::instance()->setPlayerGunfire( Data::view()->ownship.gunfire );
 
             // hearbeat
-            EngineOpenSLES::instance()->setPlayerHeartbeat( Data::get()->ownship.hit_points < 25 );
+            EngineOpenSLES::instance()->setPlayerHeartbeat( Data::view()->ownship.hit_points < 25 );
 
             // bombs
-            EngineOpenSLES::instance()->setPlayerBombs( Data::get()->ownship.bombs_drop < 5.0f );
+            EngineOpenSLES::instance()->setPlayerBombs( Data::view()->ownship.bombs_drop < 5.0f );
 
             // hit
-            EngineOpenSLES::instance()->setPlayerHit( Data::get()->ownship.ownship_hit < 0.5f );
+            EngineOpenSLES::instance()->setPlayerHit( Data::view()->ownship.ownship_hit < 0.5f );
 
             // waypoint
-            EngineOpenSLES::instance()->setPlayerWaypoint( Data::get()->ownship.waypoint_time < 1.0 );
+            EngineOpenSLES::instance()->setPlayerWaypoint( Data::view()->ownship.waypoint_time < 1.0 );
         }
         else
         {
@@ -157,29 +157,29 @@ void SFX::update()
             EngineOpenSLES::instance()->setPlayerWaypoint  ( false );
         }
     }
-#   else
+#   elif !defined( SIM_SFX_NONE )
     if ( !_paused )
     {
-        if ( !Data::get()->ownship.destroyed )
+        if ( !Data::view()->ownship.destroyed )
         {
             // engine
             EngineOpenAL::instance()->setEngine( true );
             EngineOpenAL::instance()->setEngineRPM( _rpm->getValue() );
 
             // gunfire
-            EngineOpenAL::instance()->setGunfire( Data::get()->ownship.gunfire );
+            EngineOpenAL::instance()->setGunfire( Data::view()->ownship.gunfire );
 
             // hearbeat
-            EngineOpenAL::instance()->setHeartbeat( Data::get()->ownship.hit_points < 25 );
+            EngineOpenAL::instance()->setHeartbeat( Data::view()->ownship.hit_points < 25 );
 
             // bombs
-            EngineOpenAL::instance()->setBombs( Data::get()->ownship.bombs_drop < 5.0f );
+            EngineOpenAL::instance()->setBombs( Data::view()->ownship.bombs_drop < 5.0f );
 
             // hit
-            EngineOpenAL::instance()->setHit( Data::get()->ownship.ownship_hit < 0.5f );
+            EngineOpenAL::instance()->setHit( Data::view()->ownship.ownship_hit < 0.5f );
 
             // waypoint
-            EngineOpenAL::instance()->setWaypoint( Data::get()->ownship.waypoint_time < 1.0 );
+            EngineOpenAL::instance()->setWaypoint( Data::view()->ownship.waypoint_time < 1.0 );
         }
         else
         {
@@ -198,5 +198,5 @@ void SFX::update()
     }
 #   endif
 
-    _destroyed = Data::get()->ownship.destroyed;
+    _destroyed = Data::view()->ownship.destroyed;
 }
@@ -19,9 +19,12 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifdef __ANDROID__
-#   define SIM_SFX_OPENSLES
+#ifdef SIM_HEADLESS
+#   define SIM_SFX_NONE
 #else
+#   ifdef __ANDROID__
+#       define SIM_SFX_OPENSLES
+#   endif
 #endif
 
 #include <sim/sim_Data.h>
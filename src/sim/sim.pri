@@ -37,6 +37,7 @@ SOURCES += \
 ################################################################################
 
 HEADERS += \
+    $$PWD/cgi/sim_Cache.h \
     $$PWD/cgi/sim_Camera.h \
     $$PWD/cgi/sim_Color.h \
     $$PWD/cgi/sim_Effects.h \
@@ -46,12 +47,19 @@ HEADERS += \
     $$PWD/cgi/sim_Gates.h \
     $$PWD/cgi/sim_Geometry.h \
     $$PWD/cgi/sim_HUD.h \
+    $$PWD/cgi/sim_HUDBatch.h \
+    $$PWD/cgi/sim_Impostors.h \
+    $$PWD/cgi/sim_Instances.h \
+    $$PWD/cgi/sim_Loader.h \
     $$PWD/cgi/sim_ManipulatorOrbit.h \
     $$PWD/cgi/sim_ManipulatorShift.h \
     $$PWD/cgi/sim_ManipulatorWorld.h \
     $$PWD/cgi/sim_Models.h \
     $$PWD/cgi/sim_Module.h \
     $$PWD/cgi/sim_OTW.h \
+    $$PWD/cgi/sim_PagedTerrain.h \
+    $$PWD/cgi/sim_Reflection.h \
+    $$PWD/cgi/sim_SceneQueue.h \
     $$PWD/cgi/sim_Scenery.h \
     $$PWD/cgi/sim_SkyDome.h \
     $$PWD/cgi/sim_SplashScreen.h \
@@ -68,12 +76,19 @@ SOURCES += \
     $$PWD/cgi/sim_Gates.cpp \
     $$PWD/cgi/sim_Geometry.cpp \
     $$PWD/cgi/sim_HUD.cpp \
+    $$PWD/cgi/sim_HUDBatch.cpp \
+    $$PWD/cgi/sim_Impostors.cpp \
+    $$PWD/cgi/sim_Instances.cpp \
+    $$PWD/cgi/sim_Loader.cpp \
     $$PWD/cgi/sim_ManipulatorOrbit.cpp \
     $$PWD/cgi/sim_ManipulatorShift.cpp \
     $$PWD/cgi/sim_ManipulatorWorld.cpp \
     $$PWD/cgi/sim_Models.cpp \
     $$PWD/cgi/sim_Module.cpp \
     $$PWD/cgi/sim_OTW.cpp \
+    $$PWD/cgi/sim_PagedTerrain.cpp \
+    $$PWD/cgi/sim_Reflection.cpp \
+    $$PWD/cgi/sim_SceneQueue.cpp \
     $$PWD/cgi/sim_Scenery.cpp \
     $$PWD/cgi/sim_SkyDome.cpp \
     $$PWD/cgi/sim_SplashScreen.cpp \
@@ -92,6 +107,7 @@ HEADERS += \
     $$PWD/entities/sim_BomberTorpedo.h \
     $$PWD/entities/sim_Building.h \
     $$PWD/entities/sim_Bullet.h \
+    $$PWD/entities/sim_Collisions.h \
     $$PWD/entities/sim_Entities.h \
     $$PWD/entities/sim_Entity.h \
     $$PWD/entities/sim_Explosion.h \
@@ -101,13 +117,16 @@ HEADERS += \
     $$PWD/entities/sim_Gunner.h \
     $$PWD/entities/sim_Kamikaze.h \
     $$PWD/entities/sim_Munition.h \
+    $$PWD/entities/sim_Pool.h \
+    $$PWD/entities/sim_Projectiles.h \
+    $$PWD/entities/sim_Targets.h \
     $$PWD/entities/sim_Torpedo.h \
-    $$PWD/entities/sim_Tracer.h \
     $$PWD/entities/sim_Unit.h \
     $$PWD/entities/sim_UnitAerial.h \
     $$PWD/entities/sim_UnitGround.h \
     $$PWD/entities/sim_UnitMarine.h \
     $$PWD/entities/sim_UnitSurface.h \
+    $$PWD/entities/sim_UnitsGrid.h \
     $$PWD/entities/sim_Warship.h \
     $$PWD/entities/sim_Wreckage.h \
     $$PWD/entities/sim_WreckageAircraft.h \
@@ -123,6 +142,7 @@ SOURCES += \
     $$PWD/entities/sim_BomberTorpedo.cpp \
     $$PWD/entities/sim_Building.cpp \
     $$PWD/entities/sim_Bullet.cpp \
+    $$PWD/entities/sim_Collisions.cpp \
     $$PWD/entities/sim_Entities.cpp \
     $$PWD/entities/sim_Entity.cpp \
     $$PWD/entities/sim_Explosion.cpp \
@@ -132,13 +152,15 @@ SOURCES += \
     $$PWD/entities/sim_Gunner.cpp \
     $$PWD/entities/sim_Kamikaze.cpp \
     $$PWD/entities/sim_Munition.cpp \
+    $$PWD/entities/sim_Projectiles.cpp \
+    $$PWD/entities/sim_Targets.cpp \
     $$PWD/entities/sim_Torpedo.cpp \
-    $$PWD/entities/sim_Tracer.cpp \
     $$PWD/entities/sim_Unit.cpp \
     $$PWD/entities/sim_UnitAerial.cpp \
     $$PWD/entities/sim_UnitGround.cpp \
     $$PWD/entities/sim_UnitMarine.cpp \
     $$PWD/entities/sim_UnitSurface.cpp \
+    $$PWD/entities/sim_UnitsGrid.cpp \
     $$PWD/entities/sim_Warship.cpp \
     $$PWD/entities/sim_Wreckage.cpp \
     $$PWD/entities/sim_WreckageAircraft.cpp \
@@ -175,34 +197,49 @@ SOURCES += \
 ################################################################################
 
 HEADERS += \
-    $$PWD/sfx/sim_EngineOpenAL.h \
-    $$PWD/sfx/sim_Sample.h \
     $$PWD/sfx/sim_SFX.h
 
 SOURCES += \
-    $$PWD/sfx/sim_EngineOpenAL.cpp \
-    $$PWD/sfx/sim_Sample.cpp \
     $$PWD/sfx/sim_SFX.cpp
 
+!contains( DEFINES, SIM_HEADLESS ) {
+
+HEADERS += \
+    $$PWD/sfx/sim_EngineOpenAL.h \
+    $$PWD/sfx/sim_Sample.h
+
+SOURCES += \
+    $$PWD/sfx/sim_EngineOpenAL.cpp \
+    $$PWD/sfx/sim_Sample.cpp
+
+}
+
 ################################################################################
 
 HEADERS += \
     $$PWD/utils/sim_Angles.h \
     $$PWD/utils/sim_Convert.h \
     $$PWD/utils/sim_Inertia.h \
+    $$PWD/utils/sim_Jobs.h \
+    $$PWD/utils/sim_MappedFile.h \
     $$PWD/utils/sim_Misc.h \
     $$PWD/utils/sim_PID.h \
+    $$PWD/utils/sim_Profiler.h \
     $$PWD/utils/sim_Random.h \
     $$PWD/utils/sim_Singleton.h \
     $$PWD/utils/sim_String.h \
     $$PWD/utils/sim_Text.h \
+    $$PWD/utils/sim_TripleBuffer.h \
     $$PWD/utils/sim_XmlDoc.h \
     $$PWD/utils/sim_XmlNode.h \
     $$PWD/utils/sim_XmlUtils.h
 
 SOURCES += \
     $$PWD/utils/sim_Angles.cpp \
+    $$PWD/utils/sim_Jobs.cpp \
+    $$PWD/utils/sim_MappedFile.cpp \
     $$PWD/utils/sim_PID.cpp \
+    $$PWD/utils/sim_Profiler.cpp \
     $$PWD/utils/sim_Random.cpp \
     $$PWD/utils/sim_String.cpp \
     $$PWD/utils/sim_Text.cpp \
@@ -24,6 +24,8 @@
 #include <sim/sim_Defines.h>
 #include <sim/sim_Types.h>
 
+#include <sim/utils/sim_TripleBuffer.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace sim
@@ -207,13 +209,47 @@ private:
 
 public:
 
-    /** @brief Returns pointer to the common data object. */
+    /**
+     * @brief Returns pointer to the common data object.
+     * This data is written by simulation and should be accessed only from
+     * simulation thread or with simulation locked.
+     */
     static inline SimulationData* get() { return &_data; }
 
-    /** @brief Zeroes common data. */
+    /**
+     * @brief Returns pointer to the latest acquired simulation data snapshot.
+     * This data should be accessed only from view (render, HUD, audio) thread.
+     */
+    static inline SimulationData* view() { return _buffer.getFront(); }
+
+    /** @brief Publishes common data as the latest snapshot (simulation side). */
+    static inline void publish()
+    {
+        memcpy( _buffer.getBack(), &_data, sizeof(SimulationData) );
+        _buffer.publish();
+    }
+
+    /**
+     * @brief Acquires the latest published snapshot (view side).
+     * @return true if new snapshot has been published since the last call
+     */
+    static inline bool acquire()
+    {
+        return _buffer.acquire();
+    }
+
+    /** @brief Zeroes common data and snapshots. */
     static inline void reset()
     {
         memset( &_data, 0, sizeof(SimulationData) );
+
+        _buffer.reset();
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            publish();
+            acquire();
+        }
     }
 
     /** @brief Destructor. */
@@ -222,6 +258,8 @@ public:
 private:
 
     static SimulationData _data;    ///< simulation data
+
+    static TripleBuffer< SimulationData > _buffer;  ///< simulation data snapshots
 };
 
 } // end of sim namespace
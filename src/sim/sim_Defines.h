@@ -32,7 +32,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#define SIM_ENTITIES_MAX 2048
+#define SIM_ENTITY_ID_INDEX_BITS 20
+#define SIM_ENTITY_ID_INDEX_MASK ( ( 1U << SIM_ENTITY_ID_INDEX_BITS ) - 1U )
+
+#define SIM_POOL_MAX 1024
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -58,6 +61,22 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#define SIM_EFFECTS_BUDGET 4000
+
+#define SIM_EFFECTS_LOD_NEAR 1000.0f
+#define SIM_EFFECTS_LOD_MIN  0.25f
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define SIM_IMPOSTORS_PIXEL_SIZE 16
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define SIM_SHADOW_BLOB_AGL_MAX    500.0f
+#define SIM_SHADOW_OVERLAY_FRAMES  4
+
+////////////////////////////////////////////////////////////////////////////////
+
 #define SIM_LIGHT_SUN_NUM 0
 
 ////////////////////////////////////////////////////////////////////////////////
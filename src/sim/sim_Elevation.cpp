@@ -17,8 +17,19 @@
 
 #include <sim/sim_Elevation.h>
 
+#include <algorithm>
+
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/stat.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#   define SIM_ELEVATION_SSE2
+#   include <emmintrin.h>
+#endif
 
 #include <sim/sim_Defines.h>
 #include <sim/sim_Log.h>
@@ -29,16 +40,56 @@ using namespace sim;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const UInt32 Elevation::_version = 1;
+const int Elevation::_tileDefault = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Elevation::convert( const std::string &csvFile, const std::string &binFile,
+                        int tile )
+{
+    Header header;
+    std::vector< Int16 > samples;
+
+    if ( SIM_SUCCESS == readCSV( csvFile, &header, &samples, tile ) )
+    {
+        return writeBin( binFile, header, samples );
+    }
+
+    return SIM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string Elevation::getBinFileName( const std::string &fileName )
+{
+    size_t dot   = fileName.find_last_of( '.' );
+    size_t slash = fileName.find_last_of( "/\\" );
+
+    if ( dot != std::string::npos && ( slash == std::string::npos || dot > slash ) )
+    {
+        return fileName.substr( 0, dot ) + ".bin";
+    }
+
+    return fileName + ".bin";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Elevation::Elevation() :
+    _data ( 0 ),
+
     _valid ( false ),
 
-    _num ( 0 ),
+    _num   ( 0 ),
+    _tiles ( 0 ),
+    _shift ( 0 ),
+    _mask  ( 0 ),
 
+    _coef ( 0.0f ),
     _half ( 0.0f ),
     _side ( 0.0f ),
-    _step ( 0.0f ),
-
-    _elev ( 0 )
+    _step ( 0.0f )
 {
     reset();
 }
@@ -67,10 +118,10 @@ float Elevation::getElevation( float x, float y )
         float dx = xn - ix_0;
         float dy = yn - iy_0;
 
-        float z_x0_y0 = _elev[ ix_0 * _num + iy_0 ];
-        float z_x0_y1 = _elev[ ix_0 * _num + iy_1 ];
-        float z_x1_y0 = _elev[ ix_1 * _num + iy_0 ];
-        float z_x1_y1 = _elev[ ix_1 * _num + iy_1 ];
+        float z_x0_y0 = _coef * getSample( ix_0, iy_0 );
+        float z_x0_y1 = _coef * getSample( ix_0, iy_1 );
+        float z_x1_y0 = _coef * getSample( ix_1, iy_0 );
+        float z_x1_y1 = _coef * getSample( ix_1, iy_1 );
 
         float z_y0 = z_x0_y0 + dx * ( z_x1_y0 - z_x0_y0 );
         float z_y1 = z_x0_y1 + dx * ( z_x1_y1 - z_x0_y1 );
@@ -83,96 +134,388 @@ float Elevation::getElevation( float x, float y )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Elevation::readFile( const std::string &fileName )
+void Elevation::getElevation( const double *x, const double *y, float *z, UInt32 count )
 {
-    bool error = false;
+    UInt32 i = 0;
+
+#   ifdef SIM_ELEVATION_SSE2
+    if ( _valid )
+    {
+        const __m128 half = _mm_set1_ps( _half );
+        const __m128 step = _mm_set1_ps( _step );
+        const __m128 coef = _mm_set1_ps( _coef );
+        const __m128 mask = _mm_castsi128_ps( _mm_set1_epi32( 0x7fffffff ) );
+
+        int ix_0[ 4 ];
+        int ix_1[ 4 ];
+        int iy_0[ 4 ];
+        int iy_1[ 4 ];
+
+        float s_x0_y0[ 4 ];
+        float s_x0_y1[ 4 ];
+        float s_x1_y0[ 4 ];
+        float s_x1_y1[ 4 ];
+
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            __m128 xv = _mm_movelh_ps( _mm_cvtpd_ps( _mm_loadu_pd( x + i     ) ),
+                                       _mm_cvtpd_ps( _mm_loadu_pd( x + i + 2 ) ) );
+            __m128 yv = _mm_movelh_ps( _mm_cvtpd_ps( _mm_loadu_pd( y + i     ) ),
+                                       _mm_cvtpd_ps( _mm_loadu_pd( y + i + 2 ) ) );
+
+            __m128 valid = _mm_and_ps( _mm_cmplt_ps( _mm_and_ps( xv, mask ), half ),
+                                       _mm_cmplt_ps( _mm_and_ps( yv, mask ), half ) );
+
+            // points out of range are moved to the first node not to read out of bounds
+            __m128 xn = _mm_and_ps( _mm_div_ps( _mm_add_ps( xv, half ), step ), valid );
+            __m128 yn = _mm_and_ps( _mm_div_ps( _mm_add_ps( yv, half ), step ), valid );
+
+            // xn and yn are not negative, so truncation equals floor
+            __m128i ix_0v = _mm_cvttps_epi32( xn );
+            __m128i iy_0v = _mm_cvttps_epi32( yn );
+
+            __m128 xn_0 = _mm_cvtepi32_ps( ix_0v );
+            __m128 yn_0 = _mm_cvtepi32_ps( iy_0v );
+
+            // ceil equals floor + 1 unless xn and yn are integers
+            __m128i ix_1v = _mm_sub_epi32( ix_0v, _mm_castps_si128( _mm_cmpgt_ps( xn, xn_0 ) ) );
+            __m128i iy_1v = _mm_sub_epi32( iy_0v, _mm_castps_si128( _mm_cmpgt_ps( yn, yn_0 ) ) );
+
+            _mm_storeu_si128( (__m128i*)ix_0, ix_0v );
+            _mm_storeu_si128( (__m128i*)ix_1, ix_1v );
+            _mm_storeu_si128( (__m128i*)iy_0, iy_0v );
+            _mm_storeu_si128( (__m128i*)iy_1, iy_1v );
+
+            for ( int j = 0; j < 4; j++ )
+            {
+                s_x0_y0[ j ] = getSample( ix_0[ j ], iy_0[ j ] );
+                s_x0_y1[ j ] = getSample( ix_0[ j ], iy_1[ j ] );
+                s_x1_y0[ j ] = getSample( ix_1[ j ], iy_0[ j ] );
+                s_x1_y1[ j ] = getSample( ix_1[ j ], iy_1[ j ] );
+            }
+
+            __m128 dx = _mm_sub_ps( xn, xn_0 );
+            __m128 dy = _mm_sub_ps( yn, yn_0 );
+
+            __m128 z_x0_y0 = _mm_mul_ps( coef, _mm_loadu_ps( s_x0_y0 ) );
+            __m128 z_x0_y1 = _mm_mul_ps( coef, _mm_loadu_ps( s_x0_y1 ) );
+            __m128 z_x1_y0 = _mm_mul_ps( coef, _mm_loadu_ps( s_x1_y0 ) );
+            __m128 z_x1_y1 = _mm_mul_ps( coef, _mm_loadu_ps( s_x1_y1 ) );
+
+            __m128 z_y0 = _mm_add_ps( z_x0_y0, _mm_mul_ps( dx, _mm_sub_ps( z_x1_y0, z_x0_y0 ) ) );
+            __m128 z_y1 = _mm_add_ps( z_x0_y1, _mm_mul_ps( dx, _mm_sub_ps( z_x1_y1, z_x0_y1 ) ) );
+
+            __m128 zv = _mm_add_ps( _mm_mul_ps( dy, _mm_sub_ps( z_y1, z_y0 ) ), z_y0 );
 
+            _mm_storeu_ps( z + i, _mm_and_ps( zv, valid ) );
+        }
+    }
+#   endif
+
+    for ( ; i < count; i++ )
+    {
+        z[ i ] = getElevation( x[ i ], y[ i ] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Elevation::readFile( const std::string &fileName )
+{
     reset();
 
-    FILE *file = fopen( fileName.c_str(), "r" );
+    std::string binFile = getBinFileName( fileName );
 
-    if ( file )
+    if ( binFile == fileName )
+    {
+        if ( SIM_SUCCESS != readBin( binFile ) )
+        {
+            Log::e() << "Cannot read elevation file: " << fileName << std::endl;
+        }
+
+        return;
+    }
+
+    struct stat csvStat;
+    struct stat binStat;
+
+    bool csvExists = ( 0 == stat( fileName.c_str(), &csvStat ) );
+    bool binExists = ( 0 == stat( binFile.c_str(), &binStat ) );
+
+    // cached binary file
+    if ( binExists && ( !csvExists || binStat.st_mtime >= csvStat.st_mtime ) )
     {
-        int num = 0;
+        if ( SIM_SUCCESS == readBin( binFile ) )
+        {
+            return;
+        }
+    }
 
-        double coef = 0.0;
-        double step = 0.0;
+    Header header;
+    std::vector< Int16 > samples;
 
-        if ( 3 == fscanf( file, "%d,%lf,%lf", &num, &coef, &step ) )
+    if ( SIM_SUCCESS == readCSV( fileName, &header, &samples, _tileDefault ) )
+    {
+        if ( SIM_SUCCESS == writeBin( binFile, header, samples ) )
         {
-            if ( num > 0 && coef > 0.0 && step > 0.0 )
+            if ( SIM_SUCCESS == readBin( binFile ) )
             {
-                _num = num;
+                return;
+            }
+        }
+
+        // binary file cannot be cached (e.g. read-only data directory)
+        _buffer.swap( samples );
+        setData( header, &_buffer[ 0 ] );
+    }
+    else
+    {
+        Log::e() << "Cannot read elevation file: " << fileName << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Elevation::reset()
+{
+    _file.close();
+
+    std::vector< Int16 >().swap( _buffer );
+
+    _data = 0;
+
+    _valid = false;
+
+    _num   = 0;
+    _tiles = 0;
+    _shift = 0;
+    _mask  = 0;
+
+    _coef = 0.0f;
+    _half = 0.0f;
+    _side = 0.0f;
+    _step = 0.0f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Elevation::readCSV( const std::string &fileName, Header *header,
+                        std::vector< Int16 > *samples, int tile )
+{
+    std::vector< char > text;
+
+    FILE *file = fopen( fileName.c_str(), "rb" );
+
+    if ( file )
+    {
+        char buffer[ 65536 ];
+        size_t count = 0;
 
-                _step = step;
-                _side = (float)( _num - 1 ) * _step;
-                _half = _side / 2.0f;
+        while ( 0 < ( count = fread( buffer, 1, sizeof(buffer), file ) ) )
+        {
+            text.insert( text.end(), buffer, buffer + count );
+        }
 
-                _elev = new float [ _num * _num ];
+        fclose( file );
+    }
+    else
+    {
+        return SIM_FAILURE;
+    }
+
+    text.push_back( '\0' );
+
+    const char *ptr = &text[ 0 ];
+    char *end = 0;
+
+    int    num  = strtol( ptr, &end, 10 ); ptr = ( *end == ',' ) ? end + 1 : 0;
+    double coef = ptr ? strtod( ptr, &end ) : 0.0; ptr = ( ptr && *end == ',' ) ? end + 1 : 0;
+    double step = ptr ? strtod( ptr, &end ) : 0.0; ptr = ptr ? end : 0;
+
+    if ( !ptr || num <= 0 || coef <= 0.0 || step <= 0.0 )
+    {
+        return SIM_FAILURE;
+    }
+
+    // original integer samples
+    std::vector< int > elev( num * num );
+
+    int elev_max = 0;
+
+    for ( int i = 0; i < num * num; i++ )
+    {
+        while ( *ptr == ',' || *ptr == '\r' || *ptr == '\n' || *ptr == ' ' ) ptr++;
+
+        elev[ i ] = strtol( ptr, &end, 10 );
+
+        if ( end == ptr )
+        {
+            return SIM_FAILURE;
+        }
+
+        ptr = end;
+
+        elev_max = std::max( elev_max, abs( elev[ i ] ) );
+    }
+
+    // quantization
+    int scale = 1;
+
+    while ( ( elev_max + scale / 2 ) / scale > 32767 ) scale++;
+
+    memcpy( header->magic, "ELEV", 4 );
+    header->version = _version;
+    header->num  = num;
+    header->tile = tile;
+    header->coef = coef * scale;
+    header->step = step;
+
+    if ( !isValid( *header ) )
+    {
+        return SIM_FAILURE;
+    }
+
+    samples->assign( getSamplesCount( *header ), 0 );
+
+    int shift = 0;
+    while ( ( 1 << shift ) < tile ) shift++;
+
+    int tiles = ( tile > 0 ) ? ( num + tile - 1 ) / tile : 0;
+    int mask  = tile - 1;
+
+    for ( int ir = 0; ir < num; ir++ )
+    {
+        for ( int ic = 0; ic < num; ic++ )
+        {
+            int e = elev[ ir * num + ic ];
+            Int16 sample = (Int16)( ( e >= 0 ) ? ( e + scale / 2 ) / scale : -( ( -e + scale / 2 ) / scale ) );
+
+            if ( tile > 0 )
+            {
+                int it = ( ir >> shift ) * tiles + ( ic >> shift );
+                (*samples)[ ( it << ( 2 * shift ) ) + ( ( ir & mask ) << shift ) + ( ic & mask ) ] = sample;
             }
             else
             {
-                error = true;
+                (*samples)[ ir * num + ic ] = sample;
             }
+        }
+    }
 
-            for ( int ir = 0; ir < _num && !error; ir++ )
-            {
-                for ( int ic = 0; ic < _num && !error; ic++ )
-                {
-                    int elev = 0;
-
-                    if ( ic == 0 )
-                    {
-                        if ( 1 != fscanf( file, "\n%d" , &elev ) )
-                        {
-                            error = true;
-                        }
-                    }
-                    else
-                    {
-                        if ( 1 != fscanf( file, ",%d"  , &elev ) )
-                        {
-                            error = true;
-                        }
-                    }
-
-                    _elev[ ir * _num + ic ] = (float)elev * coef;
-                }
-            }
+    return SIM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Elevation::writeBin( const std::string &fileName, const Header &header,
+                         const std::vector< Int16 > &samples )
+{
+    int result = SIM_FAILURE;
+
+    // written to temporary file first not to leave incomplete binary file
+    std::string tempFile = fileName + ".tmp";
+
+    FILE *file = fopen( tempFile.c_str(), "wb" );
+
+    if ( file )
+    {
+        bool error = false;
+
+        error = error || 1 != fwrite( &header, sizeof(Header), 1, file );
+        error = error || samples.size() != fwrite( &samples[ 0 ], sizeof(Int16), samples.size(), file );
+
+        error = ( 0 != fclose( file ) ) || error;
+
+        remove( fileName.c_str() );
+
+        if ( !error && 0 == rename( tempFile.c_str(), fileName.c_str() ) )
+        {
+            result = SIM_SUCCESS;
         }
         else
         {
-            error = true;
+            remove( tempFile.c_str() );
         }
-
-        fclose( file );
     }
-    else
-    {
-        Log::e() << "Cannot open elevation file: " << fileName << std::endl;
 
-        error = true;
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+size_t Elevation::getSamplesCount( const Header &header )
+{
+    size_t side = header.num;
+
+    if ( header.tile > 0 )
+    {
+        side = ( ( header.num + header.tile - 1 ) / header.tile ) * header.tile;
     }
 
-    _valid = !error;
+    return side * side;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Elevation::isValid( const Header &header )
+{
+    bool tileValid = header.tile >= 0 && ( header.tile & ( header.tile - 1 ) ) == 0;
+
+    return 0 == memcmp( header.magic, "ELEV", 4 )
+        && header.version == _version
+        && header.num > 1
+        && header.coef > 0.0
+        && header.step > 0.0
+        && tileValid;
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
-    if ( error )
+int Elevation::readBin( const std::string &fileName )
+{
+    if ( SIM_SUCCESS == _file.open( fileName ) )
     {
-        reset();
+        if ( _file.getSize() >= sizeof(Header) )
+        {
+            Header header;
+            memcpy( &header, _file.getData(), sizeof(Header) );
+
+            if ( isValid( header ) )
+            {
+                size_t size = sizeof(Header) + getSamplesCount( header ) * sizeof(Int16);
+
+                if ( _file.getSize() >= size )
+                {
+                    setData( header, (const Int16*)( _file.getData() + sizeof(Header) ) );
+                    return SIM_SUCCESS;
+                }
+            }
+        }
+
+        _file.close();
     }
+
+    return SIM_FAILURE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Elevation::reset()
+void Elevation::setData( const Header &header, const Int16 *data )
 {
-    _valid = false;
+    _data = data;
 
-    _num = 0;
+    _num = header.num;
 
-    _half = 0.0f;
-    _side = 0.0f;
-    _step = 0.0f;
+    _shift = 0;
+    while ( ( 1 << _shift ) < header.tile ) _shift++;
+
+    _tiles = ( header.tile > 0 ) ? ( _num + header.tile - 1 ) / header.tile : 0;
+    _mask  = header.tile - 1;
+
+    _coef = header.coef;
+    _step = header.step;
+    _side = (float)( _num - 1 ) * _step;
+    _half = _side / 2.0f;
 
-    DELTAB( _elev );
+    _valid = true;
 }
@@ -20,7 +20,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <string>
+#include <vector>
 
+#include <sim/sim_Types.h>
+
+#include <sim/utils/sim_MappedFile.h>
 #include <sim/utils/sim_Singleton.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,7 +32,15 @@
 namespace sim
 {
 
-/** @brief Ground elevation class. */
+/**
+ * @brief Ground elevation class.
+ *
+ * Elevation data is stored in binary file consisting of header followed by
+ * 16-bits signed integer samples, either row by row or in square tiles.
+ * Binary file is memory-mapped. When CSV file is given, binary file is
+ * cached next to it (with ".bin" extension) and used as long as it is
+ * not older than the CSV file.
+ */
 class Elevation : public Singleton< Elevation >
 {
     friend class Singleton< Elevation >;
@@ -40,13 +52,61 @@ private:
 
 public:
 
+    /** Binary file header struct. */
+    struct Header
+    {
+        char   magic[ 4 ];      ///< magic "ELEV"
+        UInt32 version;         ///< format version
+        int    num;             ///< number of nodes along side
+        int    tile;            ///< tile size in nodes (power of 2) or 0 if not tiled
+        double coef;            ///< [m] elevation sample coefficient
+        double step;            ///< [m] nodes step
+    };
+
+    static const UInt32 _version;       ///< binary file format version
+    static const int _tileDefault;      ///< default tile size
+
+    /**
+     * @brief Converts CSV elevation file into binary one.
+     * @param csvFile CSV file name
+     * @param binFile binary file name
+     * @param tile tile size in nodes (power of 2) or 0 if not tiled
+     * @return SIM_SUCCESS on success, SIM_FAILURE on failure
+     */
+    static int convert( const std::string &csvFile, const std::string &binFile,
+                        int tile = _tileDefault );
+
+    /**
+     * @brief Returns binary file name for given elevation file name.
+     * @param fileName elevation file name
+     * @return binary file name
+     */
+    static std::string getBinFileName( const std::string &fileName );
+
     /** @brief Destructor. */
     virtual ~Elevation();
 
     /** @brief Returns terrain elevation at given coordinates. */
     float getElevation( float x, float y );
 
-    /** @brief Reads ground elevation data file. */
+    /**
+     * @brief Computes terrain elevation at given coordinates arrays.
+     * Results are exactly the same as returned by single point function,
+     * but 4 points are interpolated at once if SSE2 is available.
+     * @param x [m] x-coordinates array
+     * @param y [m] y-coordinates array
+     * @param z [m] output terrain elevations array
+     * @param count number of points
+     */
+    void getElevation( const double *x, const double *y, float *z, UInt32 count );
+
+    /** @brief Returns [m] terrain side length or 0 if elevation data is not valid. */
+    inline float getSide() const { return _side; }
+
+    /**
+     * @brief Reads ground elevation data file. Both CSV and binary files
+     * are accepted, CSV file is converted into cached binary file.
+     */
     void readFile( const std::string &fileName );
 
     /** @brief Resets ground elevation data. */
@@ -54,15 +114,68 @@ public:
 
 private:
 
+    MappedFile _file;               ///< memory-mapped binary file
+
+    std::vector< Int16 > _buffer;   ///< samples buffer (used only if binary file cannot be written)
+
+    const Int16 *_data;             ///< elevation samples
+
     bool _valid;    ///< specifies if elevation data is valid
 
     int _num;       ///< number of nodes along side
+    int _tiles;     ///< number of tiles along side
+    int _shift;     ///< tile size binary logarithm or 0 if not tiled
+    int _mask;      ///< tile size mask
 
+    float _coef;    ///< [m] elevation sample coefficient
     float _half;    ///< [m] half size (maximum valid range)
     float _side;    ///< [m] side length
     float _step;    ///< [m] nodes step
 
-    float *_elev;   ///< [m] ground elevation data array
+    /**
+     * @brief Reads CSV elevation file.
+     * @param fileName CSV file name
+     * @param header binary file header to be filled
+     * @param samples samples to be filled
+     * @param tile tile size in nodes (power of 2) or 0 if not tiled
+     * @return SIM_SUCCESS on success, SIM_FAILURE on failure
+     */
+    static int readCSV( const std::string &fileName, Header *header,
+                        std::vector< Int16 > *samples, int tile );
+
+    /**
+     * @brief Writes binary elevation file.
+     * @return SIM_SUCCESS on success, SIM_FAILURE on failure
+     */
+    static int writeBin( const std::string &fileName, const Header &header,
+                         const std::vector< Int16 > &samples );
+
+    /** @brief Returns number of samples for given header. */
+    static size_t getSamplesCount( const Header &header );
+
+    /** @brief Returns true if header is valid. */
+    static bool isValid( const Header &header );
+
+    /** @brief Returns node elevation sample. */
+    inline Int16 getSample( int ir, int ic ) const
+    {
+        if ( _shift > 0 )
+        {
+            int it = ( ir >> _shift ) * _tiles + ( ic >> _shift );
+            return _data[ ( it << ( 2 * _shift ) ) + ( ( ir & _mask ) << _shift ) + ( ic & _mask ) ];
+        }
+
+        return _data[ ir * _num + ic ];
+    }
+
+    /**
+     * @brief Reads binary elevation file.
+     * @return SIM_SUCCESS on success, SIM_FAILURE on failure
+     */
+    int readBin( const std::string &fileName );
+
+    /** @brief Sets elevation data. */
+    void setData( const Header &header, const Int16 *data );
 };
 
 } // end of sim namespace
@@ -17,9 +17,15 @@
 
 #include <sim/sim_Manager.h>
 
+#include <algorithm>
+
 #include <sim/sim_Captions.h>
 #include <sim/sim_Languages.h>
 
+#include <sim/cgi/sim_Loader.h>
+#include <sim/cgi/sim_Models.h>
+#include <sim/cgi/sim_SplashScreen.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace sim;
@@ -27,6 +33,7 @@ using namespace sim;
 ////////////////////////////////////////////////////////////////////////////////
 
 Data::SimulationData Data::_data;
+TripleBuffer< Data::SimulationData > Data::_buffer;
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -39,10 +46,18 @@ Manager::Manager() :
 
     _timeStep ( 0.0 ),
     _timeInit ( 0.0 ),
+    _tickStep ( SIM_TIME_STEP ),
+    _tickAccu ( 0.0 ),
+
+    _timeCoef ( 1.0 ),
+    _quit ( false ),
+
+    _threaded ( false ),
 
     _autopilot ( false ),
     _finished  ( false ),
     _inited    ( false ),
+    _loading   ( false ),
     _paused    ( false ),
     _pending   ( false ),
     _started   ( false )
@@ -54,6 +69,8 @@ Manager::Manager() :
 
 Manager::~Manager()
 {
+    stop();
+
     DELPTR( _simulation );
 }
 
@@ -82,17 +99,28 @@ void Manager::init( int width, int height, UInt32 mission_index )
     _autopilot = false;
     _finished  = false;
     _inited    = false;
+    _loading   = false;
     _paused    = true;
     _pending   = true;
     _started   = false;
+
+    if ( _threaded )
+    {
+        start();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Manager::reload()
 {
+    std::lock_guard< std::mutex > lock( _mutex );
+
     if ( _simulation )
     {
+        // forces models to be read again
+        Models::reset();
+
         _simulation->load();
     }
 }
@@ -108,17 +136,35 @@ void Manager::update( double timeStep )
 
     if ( _simulation != 0 )
     {
+        std::lock_guard< std::mutex > lock( _mutex );
+
         if ( !_inited )
         {
-            if ( _timeInit > 1.0 )
+            if ( !_loading )
             {
-                _simulation->init( _mission_index );
-                _simulation->load();
+                // splash screen is drawn before reading mission
+                if ( _timeInit > 0.0 )
+                {
+                    // queues mission assets to be loaded in background
+                    _simulation->init( _mission_index );
+                    _loading = true;
+                }
 
-                _inited = true;
+                _timeInit += _timeStep;
             }
+            else if ( Loader::instance()->isIdle() )
+            {
+                _simulation->load();
+
+                Data::publish();
 
-            _timeInit += _timeStep;
+                _inited  = true;
+                _loading = false;
+            }
+            else
+            {
+                SplashScreen::setProgress( Loader::instance()->getProgress() );
+            }
         }
         else
         {
@@ -157,11 +203,36 @@ void Manager::update( double timeStep )
 
             Data::get()->paused = _paused;
 
-            /////////////////////////////////
-            _simulation->update( _timeStep );
-            /////////////////////////////////
+            double alpha = 0.0;
 
-            _status = Data::get()->mission.status;
+            if ( _threaded )
+            {
+                std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - _tickTime;
+
+                alpha = ( _tickAccu + _timeCoef * elapsed.count() ) / _tickStep;
+                alpha = std::min( 1.0, std::max( 0.0, alpha ) );
+            }
+            else
+            {
+                _tickAccu += _timeStep;
+
+                while ( _tickAccu >= _tickStep )
+                {
+                    tick( _tickStep );
+                    _tickAccu -= _tickStep;
+                }
+
+                alpha = _tickAccu / _tickStep;
+            }
+
+            Data::acquire();
+
+            _simulation->updateView( alpha );
+
+            // camera data is used by simulation
+            Data::get()->camera = Data::view()->camera;
+
+            _status = Data::view()->mission.status;
 
             _pending = _status == Pending;
         }
@@ -223,6 +294,8 @@ void Manager::setControls( bool trigger,
                            float ctrlYaw,
                            float throttle )
 {
+    std::lock_guard< std::mutex > lock( _mutex );
+
     Data::get()->controls.trigger = trigger;
 
     Data::get()->controls.ctrlRoll  = ctrlRoll;
@@ -275,6 +348,8 @@ void Manager::setViewFront()
 
 void Manager::setViewOrbit()
 {
+    std::lock_guard< std::mutex > lock( _mutex );
+
     if ( _simulation )
     {
         _simulation->setViewOrbit();
@@ -317,8 +392,20 @@ void Manager::setViewWorld()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Manager::setTickStep( double tickStep )
+{
+    _tickStep = tickStep;
+
+    if ( _tickStep < SIM_TIME_STEP_MIN ) _tickStep = SIM_TIME_STEP_MIN;
+    if ( _tickStep > SIM_TIME_STEP_MAX ) _tickStep = SIM_TIME_STEP_MAX;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Manager::toggleOrbitUnit()
 {
+    std::lock_guard< std::mutex > lock( _mutex );
+
     if ( _simulation )
     {
         _simulation->toggleOrbitUnit();
@@ -329,6 +416,8 @@ void Manager::toggleOrbitUnit()
 
 void Manager::reset()
 {
+    stop();
+
     Data::reset();
 
     DELPTR( _simulation );
@@ -338,11 +427,99 @@ void Manager::reset()
 
     _timeStep = 0.0;
     _timeInit = 0.0;
+    _tickAccu = 0.0;
 
     _autopilot = false;
     _finished  = false;
     _inited    = false;
+    _loading   = false;
     _paused    = false;
     _pending   = false;
     _started   = false;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::run()
+{
+    std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+
+    double accu = 0.0;
+
+    while ( !_quit )
+    {
+        std::chrono::steady_clock::time_point timeNow = std::chrono::steady_clock::now();
+        std::chrono::duration< double > elapsed = timeNow - time;
+
+        time = timeNow;
+
+        double timeCoef = _timeCoef;
+        double timeStep = std::min( timeCoef * elapsed.count(), SIM_TIME_STEP_MAX );
+
+        double tickStep = 0.0;
+
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+
+            tickStep = _tickStep;
+
+            if ( _inited )
+            {
+                accu += timeStep;
+
+                while ( accu >= tickStep && !_quit )
+                {
+                    tick( tickStep );
+                    accu -= tickStep;
+                }
+            }
+            else
+            {
+                accu = 0.0;
+            }
+
+            _tickAccu = accu;
+            _tickTime = timeNow;
+        }
+
+        double timeWait = ( timeCoef > 0.0 ) ? ( tickStep - accu ) / timeCoef : tickStep;
+
+        std::this_thread::sleep_for( std::chrono::duration< double >( timeWait ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::tick( double tickStep )
+{
+    ////////////////////////////////
+    _simulation->update( tickStep );
+    ////////////////////////////////
+
+    Data::publish();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::start()
+{
+    if ( !_thread.joinable() )
+    {
+        _quit = false;
+        _tickAccu = 0.0;
+        _tickTime = std::chrono::steady_clock::now();
+
+        _thread = std::thread( &Manager::run, this );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::stop()
+{
+    if ( _thread.joinable() )
+    {
+        _quit = true;
+        _thread.join();
+    }
+}
@@ -34,6 +34,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
 #include <sim/sim_Simulation.h>
 
 #include <sim/utils/sim_Singleton.h>
@@ -83,8 +88,15 @@ public:
     void reload();
 
     /**
-     * @brief Updates model view or simulation. This function should be called every step.
-     * @param timeStep [s] simulation time step
+     * @brief Updates model view or simulation. This function should be called every frame.
+     * Elapsed time is accumulated and simulation is updated with fixed tick
+     * step as many times as it fits, then view is updated with entities
+     * interpolated between two last simulation states.
+     * If simulation is threaded, simulation ticks are run by the simulation
+     * thread and only view is updated with the latest published snapshot.
+     * Simulation thread does not modify scene graph, so simulation is locked
+     * only while view is being synchronized, not while frame is rendered.
+     * @param timeStep [s] elapsed time since previous frame
      */
     void update( double timeStep );
 
@@ -127,6 +139,15 @@ public:
         return 0;
     }
 
+    /** @brief Returns number of missions defined in missions/campaign.xml. */
+    inline UInt32 getMissionsCount() const
+    {
+        if ( _simulation )
+            return _simulation->getMissionsCount();
+
+        return 0;
+    }
+
     /** @brief Returns true if mission is finished due to success ot failure. */
     inline bool isFinished() const { return _finished; }
 
@@ -192,6 +213,31 @@ public:
     /** @brief Sets world view. */
     void setViewWorld();
 
+    /**
+     * @brief Sets simulation fixed tick step.
+     * @param tickStep [s] tick step
+     */
+    void setTickStep( double tickStep );
+
+    /**
+     * @brief Sets simulation time coefficient (used by simulation thread).
+     * @param timeCoef time coefficient
+     */
+    inline void setTimeCoef( double timeCoef )
+    {
+        _timeCoef = timeCoef;
+    }
+
+    /**
+     * @brief Sets if simulation should be run by the dedicated thread.
+     * Takes effect with the next init.
+     * @param threaded specifies if simulation should be threaded
+     */
+    inline void setThreaded( bool threaded )
+    {
+        _threaded = threaded;
+    }
+
     /** @brief Toggles through units to be orbited. */
     void toggleOrbitUnit();
 
@@ -208,18 +254,46 @@ private:
 
     Status _status;                     ///< last mission status
 
-    double _timeStep;                   ///< [s] simulation time step
+    double _timeStep;                   ///< [s] frame time step
     double _timeInit;                   ///< [s] time since init
+    double _tickStep;                   ///< [s] simulation fixed tick step
+    double _tickAccu;                   ///< [s] time accumulated and not simulated yet
+
+    std::chrono::steady_clock::time_point _tickTime;    ///< time of the last simulation ticks batch
+
+    std::thread _thread;                ///< simulation thread
+    std::mutex  _mutex;                 ///< simulation mutex
+
+    std::atomic< double > _timeCoef;    ///< simulation time coefficient
+    std::atomic< bool >   _quit;        ///< specifies if simulation thread should quit
+
+    bool _threaded;                     ///< specifies if simulation is run by the dedicated thread
 
     bool _autopilot;                    ///< specifies if autopilot is engaged
     bool _finished;                     ///< specifies if simulation is finished
     bool _inited;                       ///<
+    bool _loading;                      ///< specifies if mission assets are being loaded
     bool _paused;                       ///< specifies if simulation is paused
     bool _pending;                      ///< specifies if mission is pending
     bool _started;                      ///< specifies if simulation have been started after initial pause
 
     /** @brief Destroys simulation object, resets data, etc. */
     void reset();
+
+    /** @brief Simulation thread loop. */
+    void run();
+
+    /**
+     * @brief Updates simulation with a single tick and publishes data snapshot.
+     * @param tickStep [s] tick step
+     */
+    void tick( double tickStep );
+
+    /** @brief Starts simulation thread. */
+    void start();
+
+    /** @brief Stops simulation thread. */
+    void stop();
 };
 
 } // end of sim namespace
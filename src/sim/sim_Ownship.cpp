@@ -136,15 +136,14 @@ void Ownship::reportDestroyed()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Ownship::reportHit( const Munition *munition )
+void Ownship::reportHit( const Vec3 &vel )
 {
     _ownship_hit = 0.0f;
     _ownship_hits++;
 
-    if ( munition && _aircraft )
+    if ( _aircraft )
     {
-        Vec3 r_bas = _aircraft->getAtt().inverse()
-                * ( munition->getAtt() * ( -munition->getVel() ) );
+        Vec3 r_bas = _aircraft->getAtt().inverse() * ( -vel );
 
         _hit_direction = atan2( -r_bas.y(), -r_bas.x() );
     }
@@ -296,6 +295,26 @@ void Ownship::update( double timeStep )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Ownship::interpolate()
+{
+    if ( _aircraft )
+    {
+        Vec3 pos = _aircraft->getPosInterpolated();
+        Quat att = _aircraft->getAttInterpolated();
+
+        Data::view()->ownship.pos_x = pos.x();
+        Data::view()->ownship.pos_y = pos.y();
+        Data::view()->ownship.pos_z = pos.z();
+
+        Data::view()->ownship.att_w = att.w();
+        Data::view()->ownship.att_x = att.x();
+        Data::view()->ownship.att_y = att.y();
+        Data::view()->ownship.att_z = att.z();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Ownship::setAircraft( Aircraft *aircraft )
 {
     if ( aircraft )
@@ -60,7 +60,7 @@ public:
     void reportDestroyed();
 
     /** @brief This function should be called when ownship has been hit. */
-    void reportHit( const Munition *munition );
+    void reportHit( const Vec3 &vel );
 
     /** @brief This function should be called when ownship has hit other unit. */
     void reportTargetHit( Unit *target );
@@ -74,6 +74,12 @@ public:
      */
     void update( double timeStep );
 
+    /**
+     * @brief Updates ownship output position and attitude with
+     * interpolated values (view side data snapshot).
+     */
+    void interpolate();
+
     /**
      * @brief Returns ownship aircraft.
      * @return ownship aircraft
@@ -26,15 +26,24 @@
 #include <sim/sim_Log.h>
 #include <sim/sim_Ownship.h>
 
+#include <sim/cgi/sim_Effects.h>
 #include <sim/cgi/sim_FogScene.h>
+#include <sim/cgi/sim_Fonts.h>
+#include <sim/cgi/sim_Impostors.h>
+#include <sim/cgi/sim_Instances.h>
 #include <sim/cgi/sim_Models.h>
+#include <sim/cgi/sim_Reflection.h>
+#include <sim/cgi/sim_SceneQueue.h>
 #include <sim/cgi/sim_Scenery.h>
 #include <sim/cgi/sim_SkyDome.h>
 
+#include <sim/entities/sim_WreckageAircraft.h>
+
 #include <sim/missions/sim_ObjectiveDestroy.h>
 #include <sim/missions/sim_ObjectiveTimeout.h>
 
 #include <sim/utils/sim_Convert.h>
+#include <sim/utils/sim_Profiler.h>
 #include <sim/utils/sim_String.h>
 #include <sim/utils/sim_XmlDoc.h>
 #include <sim/utils/sim_XmlUtils.h>
@@ -61,6 +70,8 @@ Simulation::Simulation( int width, int height ) :
 
     Models::createTracer( 1.2f * linesWidth );
 
+    Impostors::init( height );
+
     _otw = new OTW( linesWidth );
     _hud = new HUD( linesWidth, width, height );
     _sfx = new SFX();
@@ -72,6 +83,13 @@ Simulation::Simulation( int width, int height ) :
 
 Simulation::~Simulation()
 {
+    Effects::reset();
+    Impostors::reset();
+    Instances::reset();
+    Reflection::reset();
+    WreckageAircraft::reset();
+
+    Fonts::reset();
     Models::reset();
 
     DELPTR( _otw );
@@ -79,6 +97,9 @@ Simulation::~Simulation()
     DELPTR( _sfx );
     DELPTR( _camera );
     DELPTR( _mission );
+
+    // deleted entities nodes are removed from the scene graph
+    SceneQueue::apply();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -105,11 +126,12 @@ void Simulation::init( UInt32 mission_index )
 
 void Simulation::load()
 {
-    Models::instance()->reset();
-
     // entities must be loaded before OTW
     Entities::instance()->load();
 
+    // impostors are created from loaded units models
+    Impostors::load();
+
     _otw->load();
     _hud->load();
 
@@ -141,16 +163,65 @@ void Simulation::restart()
 
 void Simulation::update( double timeStep )
 {
-    _mission->update( timeStep );
+    Profiler::Scope scope( "simulation" );
+
+    {
+        Profiler::Scope scope( "mission" );
+        _mission->update( timeStep );
+    }
 
     // ownship (after mission!)
-    Ownship::instance()->update( timeStep );
+    {
+        Profiler::Scope scope( "ownship" );
+        Ownship::instance()->update( timeStep );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Simulation::updateView( double alpha )
+{
+    Profiler::Scope scope( "view" );
+
+    // scene graph changes made by simulation steps since last view update
+    SceneQueue::apply();
+
+    {
+        Profiler::Scope scope( "interpolation" );
+
+        Entities::instance()->interpolate( alpha );
+        Ownship::instance()->interpolate();
+    }
 
-    _otw->update();
-    _hud->update();
-    _sfx->update();
+    {
+        Profiler::Scope scope( "otw" );
+        _otw->update();
+    }
+
+    {
+        Profiler::Scope scope( "hud" );
+        _hud->update();
+    }
+
+    {
+        Profiler::Scope scope( "sfx" );
+        _sfx->update();
+    }
+
+    {
+        Profiler::Scope scope( "camera" );
+        _camera->update();
+    }
 
-    _camera->update();
+    {
+        Profiler::Scope scope( "effects" );
+        Effects::update();
+    }
+
+    {
+        Profiler::Scope scope( "impostors" );
+        Impostors::update();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -246,20 +317,19 @@ void Simulation::toggleOrbitUnit()
 
         unsigned int nextUnitIndex = 0;
 
-        for ( unsigned int i = 0; i < Entities::instance()->getEntities()->size(); i++ )
+        const Entities::Units *entitiesUnits = Entities::instance()->getUnits();
+
+        for ( unsigned int i = 0; i < entitiesUnits->size(); i++ )
         {
-            Unit *unit = dynamic_cast< Unit* >( Entities::instance()->getEntities()->at( i ) );
+            Unit *unit = entitiesUnits->at( i );
 
-            if ( unit )
+            if ( unit->isActive() )
             {
-                if ( unit->isActive() )
-                {
-                    units.push_back( unit );
+                units.push_back( unit );
 
-                    if ( unit->getId() == _orbitedUnitId )
-                    {
-                        nextUnitIndex = i + 1;
-                    }
+                if ( unit->getId() == _orbitedUnitId )
+                {
+                    nextUnitIndex = units.size();
                 }
             }
         }
@@ -79,6 +79,14 @@ public:
      */
     void update( double timeStep );
 
+    /**
+     * @brief Updates view (OTW, HUD, sound effects and camera).
+     * Scene graph changes queued by simulation steps are applied first, then
+     * entities are interpolated between two last simulation states.
+     * @param alpha interpolation coefficient (0 - previous state, 1 - current state)
+     */
+    void updateView( double alpha );
+
     /** */
     inline osgGA::CameraManipulator* getCameraManipulator()
     {
@@ -90,6 +98,9 @@ public:
 
     inline UInt32 getOrbitedUnitId() const { return _orbitedUnitId; }
 
+    /** @brief Returns number of missions defined in missions/campaign.xml. */
+    inline UInt32 getMissionsCount() const { return _missions.size(); }
+
     void setViewChase();
     void setViewFlyby();
     void setViewFront();
@@ -20,6 +20,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <sim/entities/sim_Entities.h>
+#include <sim/entities/sim_UnitAerial.h>
+#include <sim/entities/sim_UnitMarine.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -71,82 +73,11 @@ public:
      */
     void findForward( TYPE* excluded, float max_a = M_PI )
     {
-        _target = 0;
-        _valid = false;
-
-        Group::List *entities = Entities::instance()->getEntities();
-        Group::List::iterator it = entities->begin();
-
         UInt32 excludedId = ( excluded != 0 ) ? excluded->getId() : 0;
 
-        osg::Vec3f v_new;
-        osg::Vec3f v_old;
-
-        osg::Vec3f n_new;
-        osg::Vec3f n_old;
-
-        float a_new = 0.0f;
-        float a_old = std::numeric_limits< float >::max();
-
-        float limit2 = _rangeForward * _rangeForward;
-
-        const Vec3 pos_abs = _parent->getAbsPos();
-        const Quat att_abs = _parent->getAbsAtt();
-
-        while ( it != entities->end() )
-        {
-            TYPE *target = dynamic_cast< TYPE* >( *it );
-
-            if ( target )
-            {
-                if ( target->getAffiliation() == _affiliation && target->isActive() )
-                {
-                    if ( excluded == 0 || excludedId != target->getId() )
-                    {
-                        v_new = target->getPos() - pos_abs;
-
-                        if ( v_new.length2() < limit2 )
-                        {
-                            n_new =  att_abs.inverse() * v_new;
-                            n_new *= 1.0f / n_new.length();
-
-                            float r = sqrt( n_new.y()*n_new.y() + n_new.z()*n_new.z() );
-
-                            a_new = fabs( atan2( r, -n_new.x() ) );
-
-                            if ( a_new < max_a )
-                            {
-                                if ( _valid )
-                                {
-                                    if ( a_new < a_old )
-                                    {
-                                        _target = target;
-                                        _id = _target->getId();
-
-                                        v_old = v_new;
-                                        n_old = n_new;
-                                        a_old = a_new;
-                                    }
-                                }
-                                else
-                                {
-                                    _target = target;
-                                    _id = _target->getId();
-
-                                    v_old = v_new;
-                                    n_old = n_new;
-                                    a_old = a_new;
-
-                                    _valid = true;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-
-            ++it;
-        }
+        setFound( Entities::instance()->getTargets()->findForward( getCategory( (TYPE*)0 ), _affiliation,
+                                                                   _parent->getAbsPos(), _parent->getAbsAtt(),
+                                                                   _rangeForward, max_a, excludedId ) );
     }
 
     /**
@@ -165,79 +96,11 @@ public:
      */
     void findNearest( TYPE* excluded, float max_a = M_PI )
     {
-        _target = 0;
-        _valid = false;
-
-        Group::List *entities = Entities::instance()->getEntities();
-        Group::List::iterator it = entities->begin();
-
         UInt32 excludedId = ( excluded != 0 ) ? excluded->getId() : 0;
 
-        osg::Vec3f v_new;
-        osg::Vec3f n_new;
-
-        float r_new = 0.0f;
-
-        float d2_new = 0.0f;
-        float d2_old = std::numeric_limits< float >::max();
-
-        float limit2 = _rangeNearest * _rangeNearest;
-
-        const Vec3 pos_abs = _parent->getAbsPos();
-        const Quat att_abs = _parent->getAbsAtt();
-
-        while ( it != entities->end() )
-        {
-            TYPE *target = dynamic_cast< TYPE* >( *it );
-
-            if ( target )
-            {
-                if ( target->getAffiliation() == _affiliation && target->isActive() )
-                {
-                    if ( excluded == 0 || excludedId != target->getId() )
-                    {
-                        v_new = target->getPos() - pos_abs;
-
-                        d2_new = v_new.length2();
-
-                        if ( d2_new < limit2 )
-                        {
-                            n_new =  att_abs.inverse() * v_new;
-                            n_new *= 1.0f / n_new.length();
-
-                            r_new = sqrt( n_new.y()*n_new.y() + n_new.z()*n_new.z() );
-
-                            float a = atan2( r_new, -n_new.x() );
-
-                            if ( fabs( a ) < max_a )
-                            {
-                                if ( _valid )
-                                {
-                                    if ( d2_new < d2_old )
-                                    {
-                                        _target = target;
-                                        _id = _target->getId();
-
-                                        d2_old = d2_new;
-                                    }
-                                }
-                                else
-                                {
-                                    _target = target;
-                                    _id = _target->getId();
-
-                                    d2_old = d2_new;
-
-                                    _valid = true;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-
-            ++it;
-        }
+        setFound( Entities::instance()->getTargets()->findNearest( getCategory( (TYPE*)0 ), _affiliation,
+                                                                   _parent->getAbsPos(), _parent->getAbsAtt(),
+                                                                   _rangeNearest, max_a, excludedId ) );
     }
 
     /** @brief Updates target. */
@@ -303,6 +166,43 @@ private:
     UInt32 _id;                 ///< target ID
 
     bool _valid;                ///< specifies if target is valid
+
+    /** Sets target found by targets acquisition service. */
+    inline void setFound( Unit *unit )
+    {
+        _target = static_cast< TYPE* >( unit );
+        _valid = false;
+
+        if ( _target )
+        {
+            _id = _target->getId();
+            _valid = true;
+        }
+    }
+
+    /** Returns units category. */
+    static inline Targets::Category getCategory( Unit* )
+    {
+        return Targets::All;
+    }
+
+    /** Returns aerial units category. */
+    static inline Targets::Category getCategory( UnitAerial* )
+    {
+        return Targets::Aerial;
+    }
+
+    /** Returns surface units category. */
+    static inline Targets::Category getCategory( UnitSurface* )
+    {
+        return Targets::Surface;
+    }
+
+    /** Returns marine units category. */
+    static inline Targets::Category getCategory( UnitMarine* )
+    {
+        return Targets::Marine;
+    }
 };
 
 } // end of sim namespace
@@ -29,6 +29,7 @@ namespace sim
 
 ////////////////////////////////////////////////////////////////////////////////
 
+typedef short          Int16;   ///< 16-bits signed integer type
 typedef unsigned char  UInt8;   ///< 8-bits unsigned integer type
 typedef unsigned short UInt16;  ///< 16-bits unsigned integer type
 typedef unsigned int   UInt32;  ///< 32-bits unsigned integer type
@@ -59,6 +60,16 @@ enum Alignment
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/** Shadow type enum. */
+enum ShadowType
+{
+    ShadowOff     = 0,          ///< no shadows
+    ShadowBlob    = 1,          ///< projected blob shadows of all aircraft
+    ShadowOverlay = 2           ///< ownship overlay shadow (desktop only)
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 /** Entity state enum. */
 enum State
 {
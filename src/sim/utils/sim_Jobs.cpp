@@ -0,0 +1,216 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/utils/sim_Jobs.h>
+
+#include <algorithm>
+
+#include <sim/sim_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Jobs::Jobs() :
+    _queued ( 0 ),
+    _remaining ( 0 ),
+    _running ( false ),
+    _quit ( false )
+{
+    UInt32 threads = std::thread::hardware_concurrency();
+
+    if ( threads < 1 ) threads = 1;
+
+    for ( UInt32 i = 0; i < threads; i++ )
+    {
+        _queues.push_back( new Queue() );
+    }
+
+    for ( UInt32 i = 1; i < threads; i++ )
+    {
+        _threads.push_back( std::thread( &Jobs::worker, this, i ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Jobs::~Jobs()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _quit = true;
+    }
+
+    _wake.notify_all();
+
+    for ( UInt32 i = 0; i < _threads.size(); i++ )
+    {
+        _threads[ i ].join();
+    }
+
+    for ( UInt32 i = 0; i < _queues.size(); i++ )
+    {
+        DELPTR( _queues[ i ] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Jobs::run( Job *job, UInt32 count )
+{
+    if ( count == 0 ) return;
+
+    _running = true;
+
+    UInt32 queues = _queues.size();
+
+    if ( queues == 1 || count == 1 )
+    {
+        for ( UInt32 i = 0; i < count; i++ )
+        {
+            job->execute( i );
+        }
+
+        _running = false;
+
+        return;
+    }
+
+    // several tasks per thread, so faster threads can steal from slower ones
+    UInt32 size = count / ( 4 * queues );
+
+    if ( size < 1 ) size = 1;
+
+    UInt32 tasks = ( count + size - 1 ) / size;
+
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _queued    += tasks;
+        _remaining += tasks;
+
+        for ( UInt32 i = 0; i < tasks; i++ )
+        {
+            Task task;
+
+            task.job   = job;
+            task.first = i * size;
+            task.last  = std::min( count, task.first + size );
+
+            Queue *queue = _queues[ i % queues ];
+
+            std::lock_guard< std::mutex > lockQueue( queue->mutex );
+            queue->tasks.push_back( task );
+        }
+    }
+
+    _wake.notify_all();
+
+    Task task;
+
+    while ( pop( 0, &task ) || steal( 0, &task ) )
+    {
+        execute( task );
+    }
+
+    std::unique_lock< std::mutex > lock( _mutex );
+    _done.wait( lock, [ this ]() { return _remaining == 0; } );
+
+    _running = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Jobs::execute( const Task &task )
+{
+    for ( UInt32 i = task.first; i < task.last; i++ )
+    {
+        task.job->execute( i );
+    }
+
+    if ( --_remaining == 0 )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _done.notify_all();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Jobs::pop( UInt32 index, Task *task )
+{
+    Queue *queue = _queues[ index ];
+
+    std::lock_guard< std::mutex > lock( queue->mutex );
+
+    if ( queue->tasks.empty() ) return false;
+
+    *task = queue->tasks.back();
+    queue->tasks.pop_back();
+    _queued--;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Jobs::steal( UInt32 index, Task *task )
+{
+    UInt32 queues = _queues.size();
+
+    for ( UInt32 i = 1; i < queues; i++ )
+    {
+        Queue *queue = _queues[ ( index + i ) % queues ];
+
+        std::lock_guard< std::mutex > lock( queue->mutex );
+
+        if ( !queue->tasks.empty() )
+        {
+            *task = queue->tasks.front();
+            queue->tasks.pop_front();
+            _queued--;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Jobs::worker( UInt32 index )
+{
+    Task task;
+
+    while ( true )
+    {
+        if ( pop( index, &task ) || steal( index, &task ) )
+        {
+            execute( task );
+        }
+        else
+        {
+            std::unique_lock< std::mutex > lock( _mutex );
+            _wake.wait( lock, [ this ]() { return _quit || _queued > 0; } );
+
+            if ( _quit ) return;
+        }
+    }
+}
@@ -0,0 +1,146 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_JOBS_H
+#define SIM_JOBS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sim/sim_Types.h>
+
+#include <sim/utils/sim_Singleton.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Work-stealing jobs system class.
+ *
+ * Job items range is split into tasks which are distributed among worker
+ * threads queues. Each worker takes tasks from the back of its own queue
+ * and, when it is empty, steals tasks from the front of other queues.
+ * Calling thread takes part in executing tasks and returns after all of them
+ * are done. Jobs must not be run from within other jobs.
+ */
+class Jobs : public Singleton< Jobs >
+{
+    friend class Singleton< Jobs >;
+
+public:
+
+    /** @brief Job interface class. */
+    class Job
+    {
+    public:
+
+        /** @brief Destructor. */
+        virtual ~Job() {}
+
+        /**
+         * @brief Executes job for a single item. Implementations must only
+         * modify data owned by the given item.
+         * @param index item index
+         */
+        virtual void execute( UInt32 index ) = 0;
+    };
+
+private:
+
+    /**
+     * You should use static function instance() due to get refernce
+     * to Jobs class instance.
+     */
+    Jobs();
+
+    /** Using this constructor is forbidden. */
+    Jobs( const Jobs & ) : Singleton< Jobs >() {}
+
+public:
+
+    /** @brief Destructor. */
+    virtual ~Jobs();
+
+    /**
+     * @brief Executes job for all items in parallel and waits until done.
+     * @param job job to be executed
+     * @param count number of items
+     */
+    void run( Job *job, UInt32 count );
+
+    /** @brief Returns number of threads executing jobs (including caller). */
+    inline UInt32 getThreadsCount() const { return _queues.size(); }
+
+    /** @brief Returns true if job is being executed. */
+    inline bool isRunning() const { return _running; }
+
+private:
+
+    /** Task struct. */
+    struct Task
+    {
+        Job *job;               ///< job
+        UInt32 first;           ///< first item index
+        UInt32 last;            ///< last item index (excluded)
+    };
+
+    /** Tasks queue struct. */
+    struct Queue
+    {
+        std::mutex mutex;           ///< queue mutex
+        std::deque< Task > tasks;   ///< tasks
+    };
+
+    std::vector< std::thread > _threads;    ///< worker threads
+    std::vector< Queue* > _queues;          ///< tasks queues, caller thread uses the first one
+
+    std::mutex _mutex;                      ///< wake and done mutex
+    std::condition_variable _wake;          ///< signaled when tasks are queued
+    std::condition_variable _done;          ///< signaled when all tasks are done
+
+    std::atomic< UInt32 > _queued;          ///< number of queued tasks
+    std::atomic< UInt32 > _remaining;       ///< number of not finished tasks
+
+    std::atomic< bool > _running;           ///< specifies if job is being executed
+
+    bool _quit;                             ///< specifies if workers should quit
+
+    /** Executes task. */
+    void execute( const Task &task );
+
+    /** Takes task from the back of own queue. */
+    bool pop( UInt32 index, Task *task );
+
+    /** Takes task from the front of other queues. */
+    bool steal( UInt32 index, Task *task );
+
+    /** Worker thread loop. */
+    void worker( UInt32 index );
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_JOBS_H
@@ -0,0 +1,130 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+
+#include <sim/utils/sim_MappedFile.h>
+
+#ifdef WIN32
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#endif
+
+#include <sim/sim_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sim;
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::MappedFile() :
+#   ifdef WIN32
+    _file ( INVALID_HANDLE_VALUE ),
+    _mapping ( 0 ),
+#   else
+    _fd ( -1 ),
+#   endif
+
+    _data ( 0 ),
+    _size ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int MappedFile::open( const std::string &fileName )
+{
+    close();
+
+#   ifdef WIN32
+    _file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0 );
+
+    if ( _file != INVALID_HANDLE_VALUE )
+    {
+        LARGE_INTEGER size;
+
+        if ( GetFileSizeEx( _file, &size ) && size.QuadPart > 0 )
+        {
+            _mapping = CreateFileMappingA( _file, 0, PAGE_READONLY, 0, 0, 0 );
+
+            if ( _mapping )
+            {
+                _data = (const UInt8*)MapViewOfFile( _mapping, FILE_MAP_READ, 0, 0, 0 );
+                _size = (size_t)size.QuadPart;
+            }
+        }
+    }
+#   else
+    _fd = ::open( fileName.c_str(), O_RDONLY );
+
+    if ( _fd != -1 )
+    {
+        struct stat st;
+
+        if ( 0 == fstat( _fd, &st ) && st.st_size > 0 )
+        {
+            void *data = mmap( 0, st.st_size, PROT_READ, MAP_SHARED, _fd, 0 );
+
+            if ( data != MAP_FAILED )
+            {
+                _data = (const UInt8*)data;
+                _size = (size_t)st.st_size;
+            }
+        }
+    }
+#   endif
+
+    if ( !_data )
+    {
+        close();
+        return SIM_FAILURE;
+    }
+
+    return SIM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::close()
+{
+#   ifdef WIN32
+    if ( _data ) UnmapViewOfFile( _data );
+    if ( _mapping ) CloseHandle( _mapping );
+    if ( _file != INVALID_HANDLE_VALUE ) CloseHandle( _file );
+
+    _file = INVALID_HANDLE_VALUE;
+    _mapping = 0;
+#   else
+    if ( _data ) munmap( (void*)_data, _size );
+    if ( _fd != -1 ) ::close( _fd );
+
+    _fd = -1;
+#   endif
+
+    _data = 0;
+    _size = 0;
+}
@@ -0,0 +1,83 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_MAPPEDFILE_H
+#define SIM_MAPPEDFILE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+
+#include <string>
+
+#include <sim/sim_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/** @brief Read-only memory-mapped file class. */
+class MappedFile
+{
+public:
+
+    /** @brief Constructor. */
+    MappedFile();
+
+    /** @brief Destructor. */
+    virtual ~MappedFile();
+
+    /**
+     * @brief Maps file into memory.
+     * @param fileName file name
+     * @return SIM_SUCCESS on success, SIM_FAILURE on failure
+     */
+    int open( const std::string &fileName );
+
+    /** @brief Unmaps file. */
+    void close();
+
+    /** @brief Returns mapped data pointer. */
+    inline const UInt8* getData() const { return _data; }
+
+    /** @brief Returns mapped data size. */
+    inline size_t getSize() const { return _size; }
+
+    /** @brief Returns true if file is mapped. */
+    inline bool isOpen() const { return _data != 0; }
+
+private:
+
+#   ifdef WIN32
+    void *_file;                ///< file handle
+    void *_mapping;             ///< file mapping handle
+#   else
+    int _fd;                    ///< file descriptor
+#   endif
+
+    const UInt8 *_data;         ///< mapped data
+    size_t _size;               ///< mapped data size
+
+    /** Using this constructor is forbidden. */
+    MappedFile( const MappedFile & ) {}
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_MAPPEDFILE_H
@@ -14,54 +14,50 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>
  ******************************************************************************/
-#ifndef SIM_TRACER_H
-#define SIM_TRACER_H
 
-////////////////////////////////////////////////////////////////////////////////
-
-#include <osgParticle/SmokeTrailEffect>
+#include <sim/utils/sim_Profiler.h>
 
-#include <sim/entities/sim_Bullet.h>
+#include <string.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
-namespace sim
-{
-
-/** @brief Tracer bullet class. */
-class Tracer : public Bullet
-{
-public:
+using namespace sim;
 
-    /** Constructor. */
-    Tracer( UInt32 shooterId, bool trail = false );
+////////////////////////////////////////////////////////////////////////////////
 
-    /** Destructor. */
-    virtual ~Tracer();
+Profiler::Profiler() {}
 
-    /** Loads bullet. */
-    virtual void load();
+////////////////////////////////////////////////////////////////////////////////
 
-    /** Updates tracer. */
-    void update( double timeStep );
+Profiler::~Profiler() {}
 
-private:
+////////////////////////////////////////////////////////////////////////////////
 
-//    static UInt8 _counter_trail;
-//    static UInt8 _quantity;
+void Profiler::add( const char *name, double time )
+{
+    for ( Sections::iterator it = _sections.begin(); it != _sections.end(); ++it )
+    {
+        if ( it->name == name || 0 == strcmp( it->name, name ) )
+        {
+            it->time += time;
+            it->calls++;
 
-    float _elevation;  ///< [m] terrain elevation
+            return;
+        }
+    }
 
-//    bool _trail;        ///< specifies if tracer is a smoke trail
-//    unsigned int _counter_update;
-//    osg::ref_ptr<osgParticle::SmokeTrailEffect> _smokeTrail;
+    Section section;
 
-    /** */
-    void updateElevation();
-};
+    section.name  = name;
+    section.time  = time;
+    section.calls = 1;
 
-} // end of sim namespace
+    _sections.push_back( section );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#endif // SIM_TRACER_H
+void Profiler::reset()
+{
+    _sections.clear();
+}
@@ -0,0 +1,124 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_PROFILER_H
+#define SIM_PROFILER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <vector>
+
+#include <sim/sim_Types.h>
+
+#include <sim/utils/sim_Singleton.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Subsystems timing profiler class.
+ *
+ * Accumulates wall time spent in named code sections. Sections are
+ * identified by string literals and kept in order of first use.
+ * Profiler is not thread safe. Scopes are taken by both simulation ticks
+ * and view updates, so all of them must be taken while holding the Manager
+ * mutex (or from a single thread if simulation is not threaded) and never
+ * from within jobs.
+ */
+class Profiler : public Singleton< Profiler >
+{
+    friend class Singleton< Profiler >;
+
+public:
+
+    typedef std::chrono::steady_clock Clock;
+
+    /** @brief Section timing struct. */
+    struct Section
+    {
+        const char *name;       ///< section name
+        double time;            ///< [s] total time
+        UInt32 calls;           ///< number of calls
+    };
+
+    typedef std::vector< Section > Sections;
+
+    /** @brief Scoped timer class, adds its lifetime to the given section. */
+    class Scope
+    {
+    public:
+
+        /** @brief Constructor. */
+        Scope( const char *name ) :
+            _name ( name ),
+            _start ( Clock::now() )
+        {}
+
+        /** @brief Destructor. */
+        ~Scope()
+        {
+            std::chrono::duration< double > time = Clock::now() - _start;
+            Profiler::instance()->add( _name, time.count() );
+        }
+
+    private:
+
+        const char *_name;          ///< section name
+        Clock::time_point _start;   ///< start time
+    };
+
+private:
+
+    /**
+     * You should use static function instance() due to get refernce
+     * to Profiler class instance.
+     */
+    Profiler();
+
+    /** Using this constructor is forbidden. */
+    Profiler( const Profiler & ) : Singleton< Profiler >() {}
+
+public:
+
+    /** @brief Destructor. */
+    virtual ~Profiler();
+
+    /**
+     * @brief Adds time to the given section.
+     * @param name section name
+     * @param time [s] time
+     */
+    void add( const char *name, double time );
+
+    /** @brief Resets all sections. */
+    void reset();
+
+    /** @brief Returns sections. */
+    inline const Sections& getSections() const { return _sections; }
+
+private:
+
+    Sections _sections;     ///< sections
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_PROFILER_H
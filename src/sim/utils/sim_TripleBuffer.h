@@ -0,0 +1,101 @@
+/****************************************************************************//*
+ * Copyright (C) 2020 Marek M. Cel
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************/
+#ifndef SIM_TRIPLEBUFFER_H
+#define SIM_TRIPLEBUFFER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+
+#include <sim/sim_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sim
+{
+
+/**
+ * @brief Lock-free single producer single consumer triple buffer template class.
+ *
+ * Producer writes to the back buffer and publishes it, consumer acquires the
+ * latest published buffer as the front one. Neither side ever waits for the
+ * other one, consumer always reads a complete snapshot.
+ */
+template < class TYPE >
+class TripleBuffer
+{
+public:
+
+    /** @brief Constructor. */
+    TripleBuffer() :
+        _back  ( 0 ),
+        _middle( 1 ),
+        _front ( 2 )
+    {}
+
+    /** @brief Returns back buffer (producer side). */
+    inline TYPE* getBack() { return &_buffers[ _back ]; }
+
+    /** @brief Returns front buffer (consumer side). */
+    inline TYPE* getFront() { return &_buffers[ _front ]; }
+
+    /** @brief Publishes back buffer (producer side). */
+    inline void publish()
+    {
+        _back = _middle.exchange( _back | _fresh, std::memory_order_acq_rel ) & _index;
+    }
+
+    /**
+     * @brief Acquires the latest published buffer as front one (consumer side).
+     * @return true if new buffer has been published since the last call
+     */
+    inline bool acquire()
+    {
+        if ( _middle.load( std::memory_order_relaxed ) & _fresh )
+        {
+            _front = _middle.exchange( _front, std::memory_order_acq_rel ) & _index;
+            return true;
+        }
+
+        return false;
+    }
+
+    /** @brief Resets buffer state, must not be called concurrently. */
+    inline void reset()
+    {
+        _back   = 0;
+        _middle = 1;
+        _front  = 2;
+    }
+
+private:
+
+    static const UInt8 _index = 0x03;   ///< buffer index mask
+    static const UInt8 _fresh = 0x04;   ///< fresh (not acquired yet) flag
+
+    TYPE _buffers[ 3 ];                 ///< buffers
+
+    UInt8 _back;                        ///< back buffer index
+    std::atomic< UInt8 > _middle;       ///< middle buffer index and fresh flag
+    UInt8 _front;                       ///< front buffer index
+};
+
+} // end of sim namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SIM_TRIPLEBUFFER_H